@@ -0,0 +1,185 @@
+
+#include "alloc_counter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic< size_t > n_allocations{0};
+std::atomic< size_t > n_allocated_bytes{0};
+std::atomic< size_t > n_deallocated_bytes{0};
+
+// every block is prefixed by a header storing its size, so that unsized deletes can still account
+// for the bytes they release.
+constexpr size_t header_size = alignof(std::max_align_t);
+
+void* counted_alloc(size_t size)
+{
+   auto* raw = static_cast< std::byte* >(std::malloc(size + header_size));
+   if(raw == nullptr) {
+      throw std::bad_alloc();
+   }
+   *reinterpret_cast< size_t* >(raw) = size;
+   n_allocations.fetch_add(1, std::memory_order_relaxed);
+   n_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+   return raw + header_size;
+}
+
+void counted_free(void* ptr) noexcept
+{
+   if(ptr == nullptr) {
+      return;
+   }
+   auto* raw = static_cast< std::byte* >(ptr) - header_size;
+   n_deallocated_bytes.fetch_add(*reinterpret_cast< size_t* >(raw), std::memory_order_relaxed);
+   std::free(raw);
+}
+
+// over-aligned blocks place the size right before the returned pointer, which is preceded by as
+// many bytes as the alignment (at least the size of the header) to stay aligned.
+size_t aligned_offset(std::align_val_t alignment)
+{
+   return std::max(static_cast< size_t >(alignment), header_size);
+}
+
+void* counted_aligned_alloc(size_t size, std::align_val_t alignment)
+{
+   auto align = static_cast< size_t >(alignment);
+   auto offset = aligned_offset(alignment);
+   // aligned_alloc requires the total size to be a multiple of the alignment
+   auto total = (size + offset + align - 1) / align * align;
+   auto* raw = static_cast< std::byte* >(std::aligned_alloc(align, total));
+   if(raw == nullptr) {
+      throw std::bad_alloc();
+   }
+   auto* ptr = raw + offset;
+   *(reinterpret_cast< size_t* >(ptr) - 1) = size;
+   n_allocations.fetch_add(1, std::memory_order_relaxed);
+   n_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+   return ptr;
+}
+
+void counted_aligned_free(void* ptr, std::align_val_t alignment) noexcept
+{
+   if(ptr == nullptr) {
+      return;
+   }
+   n_deallocated_bytes.fetch_add(
+      *(static_cast< size_t* >(ptr) - 1), std::memory_order_relaxed
+   );
+   std::free(static_cast< std::byte* >(ptr) - aligned_offset(alignment));
+}
+
+}  // namespace
+
+namespace benchmarks::alloc {
+
+Snapshot snapshot()
+{
+   return {
+      n_allocations.load(std::memory_order_relaxed),
+      n_allocated_bytes.load(std::memory_order_relaxed),
+      n_deallocated_bytes.load(std::memory_order_relaxed)};
+}
+
+}  // namespace benchmarks::alloc
+
+void* operator new(size_t size)
+{
+   return counted_alloc(size);
+}
+void* operator new[](size_t size)
+{
+   return counted_alloc(size);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+   try {
+      return counted_alloc(size);
+   } catch(const std::bad_alloc&) {
+      return nullptr;
+   }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+   try {
+      return counted_alloc(size);
+   } catch(const std::bad_alloc&) {
+      return nullptr;
+   }
+}
+void operator delete(void* ptr) noexcept
+{
+   counted_free(ptr);
+}
+void operator delete[](void* ptr) noexcept
+{
+   counted_free(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept
+{
+   counted_free(ptr);
+}
+void operator delete[](void* ptr, size_t) noexcept
+{
+   counted_free(ptr);
+}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+   counted_free(ptr);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+   counted_free(ptr);
+}
+void* operator new(size_t size, std::align_val_t alignment)
+{
+   return counted_aligned_alloc(size, alignment);
+}
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+   return counted_aligned_alloc(size, alignment);
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+   try {
+      return counted_aligned_alloc(size, alignment);
+   } catch(const std::bad_alloc&) {
+      return nullptr;
+   }
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+   try {
+      return counted_aligned_alloc(size, alignment);
+   } catch(const std::bad_alloc&) {
+      return nullptr;
+   }
+}
+void operator delete(void* ptr, std::align_val_t alignment) noexcept
+{
+   counted_aligned_free(ptr, alignment);
+}
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept
+{
+   counted_aligned_free(ptr, alignment);
+}
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept
+{
+   counted_aligned_free(ptr, alignment);
+}
+void operator delete[](void* ptr, size_t, std::align_val_t alignment) noexcept
+{
+   counted_aligned_free(ptr, alignment);
+}
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+   counted_aligned_free(ptr, alignment);
+}
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+   counted_aligned_free(ptr, alignment);
+}
@@ -0,0 +1,76 @@
+
+#ifndef NOR_BENCH_ALLOC_COUNTER_HPP
+#define NOR_BENCH_ALLOC_COUNTER_HPP
+
+#include <cstddef>
+#include <optional>
+
+namespace benchmarks::alloc {
+
+/// whether the global operator new/delete replacements in alloc_counter.cpp are compiled in.
+/// Controlled by the opt-in cmake option ENABLE_BENCHMARK_ALLOC_TRACKING. Without it, the
+/// allocation counters of the benchmarks are reported as not available and budgets are not checked.
+#ifdef NOR_BENCHMARK_TRACK_ALLOCATIONS
+inline constexpr bool tracking_enabled = true;
+#else
+inline constexpr bool tracking_enabled = false;
+#endif
+
+/// A snapshot of the process-wide allocation counters maintained by the global operator
+/// new/delete replacements in alloc_counter.cpp.
+struct Snapshot {
+   size_t allocations = 0;
+   size_t allocated_bytes = 0;
+   size_t deallocated_bytes = 0;
+
+   [[nodiscard]] size_t live_bytes() const { return allocated_bytes - deallocated_bytes; }
+
+   Snapshot operator-(const Snapshot& other) const
+   {
+      return {
+         allocations - other.allocations,
+         allocated_bytes - other.allocated_bytes,
+         deallocated_bytes - other.deallocated_bytes};
+   }
+};
+
+/// Upper limits which a benchmark may not exceed. Unset limits are not checked.
+struct Budget {
+   std::optional< double > allocs_per_iter = std::nullopt;
+   std::optional< double > bytes_per_iter = std::nullopt;
+   std::optional< double > peak_rss_mb = std::nullopt;
+};
+
+#ifdef NOR_BENCHMARK_TRACK_ALLOCATIONS
+Snapshot snapshot();
+#else
+inline Snapshot snapshot()
+{
+   return {};
+}
+#endif
+
+/// the budget which every benchmark is checked against
+Budget& budget();
+
+/// whether any benchmark has exceeded the budget so far
+bool& budget_exceeded();
+
+/**
+ * @brief Parses and removes the budget flags from the command line.
+ *
+ * Recognized flags are `--alloc_budget_per_iter=<n>`, `--bytes_budget_per_iter=<n>` and
+ * `--peak_rss_budget_mb=<n>`. They have to be stripped before the remaining arguments are handed
+ * to google benchmark, which rejects unknown flags.
+ */
+void parse_budget_flags(int& argc, char** argv);
+
+/// resets the peak resident set size of the process to its current resident set size (Linux only)
+void reset_peak_rss();
+
+/// the peak resident set size of the process in bytes since start or the last reset
+size_t peak_rss_bytes();
+
+}  // namespace benchmarks::alloc
+
+#endif  // NOR_BENCH_ALLOC_COUNTER_HPP
@@ -1,10 +1,12 @@
 
-
 #ifndef NOR_BENCH_CFR_HPP
 #define NOR_BENCH_CFR_HPP
 
 #include <benchmark/benchmark.h>
 
+#include "bench_counters.hpp"
+#include "bench_games.hpp"
+#include "perf_counters.hpp"
 #include "nor/env.hpp"
 #include "nor/nor.hpp"
 
@@ -12,12 +14,12 @@ namespace benchmarks {
 
 using namespace nor;
 
-template < auto config, typename Env, size_t nr_warmup_iters = 10 >
+template < auto config, typename Game, size_t nr_warmup_iters = 10 >
 void cfr_bench(benchmark::State& state)
 {
-   using env = std::remove_cvref_t< Env >;
+   using env = typename Game::env_type;
 
-   auto root_state = std::make_unique< auto_world_state_type< env > >();
+   size_t retained_bytes_start = alloc::snapshot().live_bytes();
 
    auto avg_tabular_policy = factory::make_tabular_policy(
       std::unordered_map<
@@ -32,49 +34,79 @@ void cfr_bench(benchmark::State& state)
    );
 
    auto solver = factory::make_cfr< config, true >(
-      env{}, std::move(root_state), tabular_policy, avg_tabular_policy
+      env{}, Game::root_state(), tabular_policy, avg_tabular_policy
    );
    if constexpr(nr_warmup_iters > 0) {
       // iterate a few rounds to assure all necessary allocations have been made
       solver.iterate(nr_warmup_iters);
    }
 
+   CounterScope< Game > counters;
+   perf::Counters perf_counters;
    for(auto _ : state) {
+      perf_counters.start();
       solver.iterate(1);
+      perf_counters.stop();
    }
+   counters.report(state, retained_bytes_start, n_stored_infostates(solver));
+   auto counts = Game::env_type::counts();
+   perf_counters.report(state, counts.nodes, counts.threads);
 }
 
-inline void (&CFR_VANILLA_alternating)(benchmark::State& state) = cfr_bench<
-   rm::CFRConfig{.update_mode = rm::UpdateMode::alternating},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&CFR_VANILLA_simultaneous)(benchmark::State& state) = cfr_bench<
-   rm::CFRConfig{.update_mode = rm::UpdateMode::simultaneous},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&CFR_LINEAR_alternating)(benchmark::State& state) = cfr_bench<
-   rm::CFRLinearConfig{.update_mode = rm::UpdateMode::alternating},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&CFR_LINEAR_simultaneous)(benchmark::State& state) = cfr_bench<
-   rm::CFRLinearConfig{.update_mode = rm::UpdateMode::simultaneous},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&CFR_DISCOUNTED_alternating)(benchmark::State& state) = cfr_bench<
-   rm::CFRDiscountedConfig{.update_mode = rm::UpdateMode::alternating},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&CFR_DISCOUNTED_simultaneous)(benchmark::State& state) = cfr_bench<
-   rm::CFRDiscountedConfig{.update_mode = rm::UpdateMode::simultaneous},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&CFR_EXPONENTIAL_alternating)(benchmark::State& state) = cfr_bench<
-   rm::CFRExponentialConfig{.update_mode = rm::UpdateMode::alternating},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&CFR_EXPONENTIAL_simultaneous)(benchmark::State& state) = cfr_bench<
-   rm::CFRExponentialConfig{.update_mode = rm::UpdateMode::simultaneous},
-   games::kuhn::Environment >;  // function reference
+inline constexpr auto cfr_vanilla_alternating = rm::CFRConfig{
+   .update_mode = rm::UpdateMode::alternating};
+inline constexpr auto cfr_vanilla_simultaneous = rm::CFRConfig{
+   .update_mode = rm::UpdateMode::simultaneous};
+inline constexpr auto cfr_linear_alternating = rm::CFRLinearConfig{
+   .update_mode = rm::UpdateMode::alternating};
+inline constexpr auto cfr_linear_simultaneous = rm::CFRLinearConfig{
+   .update_mode = rm::UpdateMode::simultaneous};
+inline constexpr auto cfr_discounted_alternating = rm::CFRDiscountedConfig{
+   .update_mode = rm::UpdateMode::alternating};
+inline constexpr auto cfr_discounted_simultaneous = rm::CFRDiscountedConfig{
+   .update_mode = rm::UpdateMode::simultaneous};
+inline constexpr auto cfr_exponential_alternating = rm::CFRExponentialConfig{
+   .update_mode = rm::UpdateMode::alternating};
+inline constexpr auto cfr_exponential_simultaneous = rm::CFRExponentialConfig{
+   .update_mode = rm::UpdateMode::simultaneous};
+inline constexpr auto cfr_plus = rm::CFRPlusConfig{};
+
+/// registers every full-traversal CFR variant for the given game
+template < typename Game >
+void register_cfr_benchmarks()
+{
+   if constexpr(Game::full_traversal_feasible) {
+      auto name = [](std::string algo) { return algo + "/" + Game::name(); };
+      benchmark::RegisterBenchmark(
+         name("CFR_VANILLA_alternating").c_str(), cfr_bench< cfr_vanilla_alternating, Game >
+      );
+      benchmark::RegisterBenchmark(
+         name("CFR_VANILLA_simultaneous").c_str(), cfr_bench< cfr_vanilla_simultaneous, Game >
+      );
+      benchmark::RegisterBenchmark(
+         name("CFR_LINEAR_alternating").c_str(), cfr_bench< cfr_linear_alternating, Game >
+      );
+      benchmark::RegisterBenchmark(
+         name("CFR_LINEAR_simultaneous").c_str(), cfr_bench< cfr_linear_simultaneous, Game >
+      );
+      benchmark::RegisterBenchmark(
+         name("CFR_DISCOUNTED_alternating").c_str(), cfr_bench< cfr_discounted_alternating, Game >
+      );
+      benchmark::RegisterBenchmark(
+         name("CFR_DISCOUNTED_simultaneous").c_str(),
+         cfr_bench< cfr_discounted_simultaneous, Game >
+      );
+      benchmark::RegisterBenchmark(
+         name("CFR_EXPONENTIAL_alternating").c_str(),
+         cfr_bench< cfr_exponential_alternating, Game >
+      );
+      benchmark::RegisterBenchmark(
+         name("CFR_EXPONENTIAL_simultaneous").c_str(),
+         cfr_bench< cfr_exponential_simultaneous, Game >
+      );
+      benchmark::RegisterBenchmark(name("CFR_PLUS").c_str(), cfr_bench< cfr_plus, Game >);
+   }
+}
 
 }  // namespace benchmarks
 
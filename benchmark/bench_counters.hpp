@@ -0,0 +1,105 @@
+
+#ifndef NOR_BENCH_COUNTERS_HPP
+#define NOR_BENCH_COUNTERS_HPP
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <optional>
+#include <range/v3/all.hpp>
+#include <string>
+
+#include "alloc_counter.hpp"
+#include "bench_games.hpp"
+
+namespace benchmarks {
+
+/**
+ * @brief Measures the custom counters over the timed loop of a benchmark.
+ *
+ * Construct it right before the timed loop and call `report` after it.
+ */
+template < typename Game >
+class CounterScope {
+  public:
+   CounterScope() : m_alloc_start(alloc::snapshot())
+   {
+      Game::env_type::reset_counts();
+      if constexpr(alloc::tracking_enabled) {
+         alloc::reset_peak_rss();
+      }
+   }
+
+   /**
+    * @brief Writes the counters into the benchmark state.
+    *
+    * If allocation tracking is enabled, the allocation counters are checked against the budget
+    * and the benchmark is marked as failed if any of them is exceeded. Otherwise, the benchmark is
+    * labelled as having no allocation counters available.
+    *
+    * @param retained_bytes_start the live heap bytes before the solver was built, the difference
+    * to the current live bytes is attributed to the stored infostates.
+    * @param n_infostates the number of infostates held by the solver (0 if not applicable).
+    */
+   void report(benchmark::State& state, size_t retained_bytes_start, size_t n_infostates) const
+   {
+      using benchmark::Counter;
+      auto counts = Game::env_type::counts();
+      state.counters["nodes"] = Counter(double(counts.nodes), Counter::kIsRate);
+      state.counters["infostates"] = Counter(double(counts.infostates), Counter::kIsRate);
+      if constexpr(alloc::tracking_enabled) {
+         auto alloc_diff = alloc::snapshot() - m_alloc_start;
+         auto n_iters = double(std::max(state.iterations(), benchmark::IterationCount(1)));
+         double allocs_per_iter = double(alloc_diff.allocations) / n_iters;
+         double bytes_per_iter = double(alloc_diff.allocated_bytes) / n_iters;
+         double peak_rss_mb = double(alloc::peak_rss_bytes()) / (1024. * 1024.);
+         state.counters["allocs_per_iter"] = allocs_per_iter;
+         state.counters["bytes_per_iter"] = bytes_per_iter;
+         state.counters["peak_rss_mb"] = peak_rss_mb;
+         if(n_infostates > 0) {
+            state.counters["bytes_per_infostate"] = (double(alloc::snapshot().live_bytes())
+                                                     - double(retained_bytes_start))
+                                                    / double(n_infostates);
+         }
+         _check_budget(state, "allocs_per_iter", allocs_per_iter, alloc::budget().allocs_per_iter);
+         _check_budget(state, "bytes_per_iter", bytes_per_iter, alloc::budget().bytes_per_iter);
+         _check_budget(state, "peak_rss_mb", peak_rss_mb, alloc::budget().peak_rss_mb);
+      } else {
+         state.SetLabel("alloc counters n/a");
+      }
+   }
+
+  private:
+   alloc::Snapshot m_alloc_start;
+
+   static void _check_budget(
+      benchmark::State& state,
+      const std::string& counter_name,
+      double value,
+      std::optional< double > limit
+   )
+   {
+      if(limit.has_value() and value > *limit) {
+         alloc::budget_exceeded() = true;
+         state.SkipWithError(
+            (counter_name + " = " + std::to_string(value) + " exceeds the budget of "
+             + std::to_string(*limit))
+               .c_str()
+         );
+      }
+   }
+};
+
+/// the number of infostates stored in the average policy tables of a solver
+auto n_stored_infostates(const auto& solver)
+{
+   return ranges::accumulate(
+      solver.average_policy() | ranges::views::values
+         | ranges::views::transform([](const auto& policy) { return policy.size(); }),
+      size_t(0)
+   );
+}
+
+}  // namespace benchmarks
+
+#endif  // NOR_BENCH_COUNTERS_HPP
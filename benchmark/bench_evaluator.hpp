@@ -0,0 +1,67 @@
+
+#ifndef NOR_BENCH_EVALUATOR_HPP
+#define NOR_BENCH_EVALUATOR_HPP
+
+#include <benchmark/benchmark.h>
+
+#include <bit>
+#include <random>
+#include <vector>
+
+#include "texas_holdem_poker/evaluator.hpp"
+
+namespace benchmarks {
+
+/// random 7-card hands, as ranked at a showdown of hold'em
+inline const std::vector< texholdem::CardMask >& showdown_hands()
+{
+   static const std::vector< texholdem::CardMask > hands = [] {
+      std::mt19937_64 rng{0};
+      std::vector< texholdem::CardMask > result(size_t(1) << 16);
+      for(auto& hand : result) {
+         while(std::popcount(hand) < 7) {
+            hand |= texholdem::CardMask(1) << (rng() % 52);
+         }
+      }
+      return result;
+   }();
+   return hands;
+}
+
+inline void holdem_evaluate_scalar_bench(benchmark::State& state)
+{
+   const auto& evaluator = texholdem::HandEvaluator::instance();
+   const auto& hands = showdown_hands();
+   std::vector< texholdem::HandRank > ranks(hands.size());
+   for(auto _ : state) {
+      for(size_t i = 0; i < hands.size(); i++) {
+         ranks[i] = evaluator.evaluate(hands[i]);
+      }
+      benchmark::DoNotOptimize(ranks.data());
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed(state.iterations() * long(hands.size()));
+}
+
+inline void holdem_evaluate_batch_bench(benchmark::State& state)
+{
+   const auto& evaluator = texholdem::HandEvaluator::instance();
+   const auto& hands = showdown_hands();
+   std::vector< texholdem::HandRank > ranks(hands.size());
+   for(auto _ : state) {
+      evaluator.evaluate(hands, ranks);
+      benchmark::DoNotOptimize(ranks.data());
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed(state.iterations() * long(hands.size()));
+}
+
+inline void register_evaluator_benchmarks()
+{
+   benchmark::RegisterBenchmark("HOLDEM_EVALUATE/scalar", holdem_evaluate_scalar_bench);
+   benchmark::RegisterBenchmark("HOLDEM_EVALUATE/batch", holdem_evaluate_batch_bench);
+}
+
+}  // namespace benchmarks
+
+#endif  // NOR_BENCH_EVALUATOR_HPP
@@ -0,0 +1,89 @@
+
+#ifndef NOR_BENCH_EXPLOITABILITY_HPP
+#define NOR_BENCH_EXPLOITABILITY_HPP
+
+#include <benchmark/benchmark.h>
+
+#include "bench_counters.hpp"
+#include "bench_games.hpp"
+#include "nor/nor.hpp"
+
+namespace benchmarks {
+
+using namespace nor;
+
+/// trains a vanilla CFR solver for a few iterations and returns its normalized average policies
+/// for each player. These serve as the (non-trivial) policy profile to be evaluated.
+template < typename Game, size_t nr_training_iters = 10 >
+auto trained_policy_profile()
+{
+   using env = typename Game::env_type;
+   auto tabular_policy = factory::make_tabular_policy(
+      std::unordered_map<
+         auto_info_state_type< env >,
+         HashmapActionPolicy< auto_action_type< env > > >{}
+   );
+   auto solver = factory::make_cfr< rm::CFRConfig{}, true >(
+      env{}, Game::root_state(), tabular_policy, tabular_policy
+   );
+   solver.iterate(nr_training_iters);
+
+   using policy_type = std::remove_cvref_t< decltype(solver.average_policy().begin()->second) >;
+   player_hashmap< policy_type > profile;
+   for(const auto& [player, policy] : solver.average_policy()) {
+      profile.emplace(player, normalize_state_policy(policy));
+   }
+   return profile;
+}
+
+template < typename Game, bool parallelize_chance = false >
+void exploitability_bench(benchmark::State& state)
+{
+   using env = typename Game::env_type;
+   auto profile = trained_policy_profile< Game >();
+   auto root_state = Game::root_state();
+
+   CounterScope< Game > counters;
+   for(auto _ : state) {
+      benchmark::DoNotOptimize(
+         exploitability(env{}, *root_state, profile, /*constant_sum=*/false, parallelize_chance)
+      );
+   }
+   counters.report(state, 0, 0);
+}
+
+template < typename Game, bool parallelize_chance = false >
+void policy_value_bench(benchmark::State& state)
+{
+   using env = typename Game::env_type;
+   auto profile = trained_policy_profile< Game >();
+   auto root_state = Game::root_state();
+
+   CounterScope< Game > counters;
+   for(auto _ : state) {
+      benchmark::DoNotOptimize(rm::policy_value(env{}, *root_state, profile, parallelize_chance));
+   }
+   counters.report(state, 0, 0);
+}
+
+/// registers the policy evaluation benchmarks for the given game. Both need to walk the entire
+/// game tree and are therefore only registered for games small enough to do so.
+template < typename Game >
+void register_evaluation_benchmarks()
+{
+   if constexpr(Game::full_traversal_feasible) {
+      auto name = [](std::string algo) { return algo + "/" + Game::name(); };
+      benchmark::RegisterBenchmark(name("EXPLOITABILITY").c_str(), exploitability_bench< Game >);
+      benchmark::RegisterBenchmark(
+         name("EXPLOITABILITY_parallel_chance").c_str(), exploitability_bench< Game, true >
+      );
+      benchmark::RegisterBenchmark(name("POLICY_VALUE").c_str(), policy_value_bench< Game >);
+      benchmark::RegisterBenchmark(
+         name("POLICY_VALUE_parallel_chance").c_str(), policy_value_bench< Game, true >
+      );
+   }
+}
+
+}  // namespace benchmarks
+
+#endif  // NOR_BENCH_EXPLOITABILITY_HPP
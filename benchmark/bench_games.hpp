@@ -0,0 +1,223 @@
+
+#ifndef NOR_BENCH_GAMES_HPP
+#define NOR_BENCH_GAMES_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "nor/env.hpp"
+#include "nor/nor.hpp"
+
+namespace benchmarks {
+
+/**
+ * @brief Env decorator which counts the world states touched and the infostates reached.
+ *
+ * Every transition produces one new node of the game tree. An infostate is reached whenever an
+ * observation is handed to the player who is active in the next state, since this is exactly the
+ * moment the solvers extend that player's infostate.
+ */
+template < typename Env >
+class CountingEnv: public Env {
+  public:
+   using world_state_type = nor::auto_world_state_type< Env >;
+
+   using Env::Env;
+
+   struct Counts {
+      size_t nodes = 0;
+      size_t infostates = 0;
+      /// the number of threads which touched at least one node
+      size_t threads = 0;
+   };
+
+   /// the counts of all threads summed up
+   static Counts counts()
+   {
+      std::scoped_lock lock{registry().mutex};
+      Counts sum{};
+      for(const auto& thread_counts : registry().counts) {
+         auto nodes = thread_counts->nodes.load(std::memory_order_relaxed);
+         sum.nodes += nodes;
+         sum.infostates += thread_counts->infostates.load(std::memory_order_relaxed);
+         sum.threads += nodes > 0 ? 1 : 0;
+      }
+      return sum;
+   }
+
+   static void reset_counts()
+   {
+      std::scoped_lock lock{registry().mutex};
+      for(auto& thread_counts : registry().counts) {
+         thread_counts->nodes.store(0, std::memory_order_relaxed);
+         thread_counts->infostates.store(0, std::memory_order_relaxed);
+      }
+   }
+
+  private:
+   /// the counts of a single thread, on a cache line of their own so that threads never contend
+   struct alignas(64) ThreadCounts {
+      std::atomic< size_t > nodes{0};
+      std::atomic< size_t > infostates{0};
+   };
+
+   struct Registry {
+      std::mutex mutex;
+      std::vector< std::unique_ptr< ThreadCounts > > counts;
+   };
+
+   static Registry& registry()
+   {
+      static Registry registry_;
+      return registry_;
+   }
+
+   /// the counts of the calling thread, registered on its first count
+   static ThreadCounts& local_counts()
+   {
+      thread_local ThreadCounts* local = [] {
+         std::scoped_lock lock{registry().mutex};
+         return registry().counts.emplace_back(std::make_unique< ThreadCounts >()).get();
+      }();
+      return *local;
+   }
+
+   /// only the owning thread writes its counts, so a relaxed load and store suffice
+   static void increment(std::atomic< size_t >& count)
+   {
+      count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+   }
+
+  public:
+   template < typename ActionOrOutcome >
+   void transition(world_state_type& wstate, const ActionOrOutcome& action_or_outcome) const
+   {
+      increment(local_counts().nodes);
+      Env::transition(wstate, action_or_outcome);
+   }
+
+   template < typename ActionOrOutcome >
+   auto private_observation(
+      nor::Player observer,
+      const world_state_type& wstate,
+      const ActionOrOutcome& action_or_outcome,
+      const world_state_type& next_wstate
+   ) const
+   {
+      if(this->active_player(next_wstate) == observer) {
+         increment(local_counts().infostates);
+      }
+      return Env::private_observation(observer, wstate, action_or_outcome, next_wstate);
+   }
+};
+
+namespace games {
+
+struct kuhn {
+   using env_type = CountingEnv< nor::games::kuhn::Environment >;
+   static constexpr bool full_traversal_feasible = true;
+   static std::string name() { return "kuhn"; }
+   static auto root_state() { return std::make_unique< nor::games::kuhn::State >(); }
+};
+
+/// Kuhn poker generalised to more players and cards. Its n_players * n_cards * 2^(n_players - 1)
+/// infostates fill the gap between Kuhn and Leduc and beyond. The full tree holds every ordered
+/// deal of the cards though, so only the games with at most `max_full_traversal_nodes` world states
+/// are also solved by full traversals.
+template < size_t n_players, size_t n_cards >
+struct kuhn_general {
+   using env_type = CountingEnv< nor::games::kuhn::GeneralEnvironment >;
+   static constexpr size_t max_full_traversal_nodes = 10'000'000;
+   /// the deals times the decision nodes per deal, saturated past the traversal limit
+   static constexpr size_t n_world_states()
+   {
+      size_t n_states = nor::games::kuhn::general::Config{n_players, n_cards}.n_infostates()
+                        / n_cards;
+      for(size_t card = n_cards; card > n_cards - n_players; card--) {
+         if(n_states > max_full_traversal_nodes / card) {
+            return max_full_traversal_nodes + 1;
+         }
+         n_states *= card;
+      }
+      return n_states;
+   }
+   static constexpr bool full_traversal_feasible = n_world_states() <= max_full_traversal_nodes;
+   static std::string name()
+   {
+      return "kuhn_" + std::to_string(n_players) + "p" + std::to_string(n_cards) + "c";
+   }
+   static auto root_state()
+   {
+      return std::make_unique< nor::games::kuhn::general::State >(
+         nor::games::kuhn::general::Config{n_players, n_cards}
+      );
+   }
+};
+
+template < size_t n_players >
+struct leduc {
+   using env_type = CountingEnv< nor::games::leduc::Environment >;
+   static constexpr bool full_traversal_feasible = true;
+   static std::string name() { return "leduc_" + std::to_string(n_players) + "p"; }
+   static auto root_state()
+   {
+      return std::make_unique< nor::games::leduc::State >(nor::games::leduc::LeducConfig{n_players}
+      );
+   }
+};
+
+template < size_t n_players >
+struct leduc5 {
+   using env_type = CountingEnv< nor::games::leduc::Environment >;
+   static constexpr bool full_traversal_feasible = true;
+   static std::string name() { return "leduc5_" + std::to_string(n_players) + "p"; }
+   static auto root_state()
+   {
+      return std::make_unique< nor::games::leduc::State >(
+         nor::games::leduc::LeducConfig::leduc5(n_players)
+      );
+   }
+};
+
+struct rps {
+   using env_type = CountingEnv< nor::games::rps::Environment >;
+   static constexpr bool full_traversal_feasible = true;
+   static std::string name() { return "rps"; }
+   static auto root_state() { return std::make_unique< nor::games::rps::State >(); }
+};
+
+/// Stratego on the smallest predefined board. The game tree is far too large for any algorithm
+/// which traverses it fully, so only the sampling based solvers are run on it.
+struct stratego_small {
+   using env_type = CountingEnv< nor::games::stratego::Environment >;
+   static constexpr bool full_traversal_feasible = false;
+   static std::string name() { return "stratego_small"; }
+   static auto root_state()
+   {
+      return std::make_unique< nor::games::stratego::State >(nor::games::stratego::Config(
+         nor::games::stratego::Team::BLUE, nor::games::stratego::DefinedBoardSizes::small
+      ));
+   }
+};
+
+/// Heads-up limit hold'em. Like Stratego its game tree only admits sampling based solvers.
+struct limit_holdem {
+   using env_type = CountingEnv< nor::games::texholdem::Environment >;
+   static constexpr bool full_traversal_feasible = false;
+   static std::string name() { return "limit_holdem"; }
+   static auto root_state()
+   {
+      return std::make_unique< nor::games::texholdem::State >(
+         nor::games::texholdem::PokerConfig::limit()
+      );
+   }
+};
+
+}  // namespace games
+
+}  // namespace benchmarks
+
+#endif  // NOR_BENCH_GAMES_HPP
@@ -1,20 +1,23 @@
-
-
 #ifndef NOR_BENCH_MCCFR_HPP
 #define NOR_BENCH_MCCFR_HPP
 
+#include <benchmark/benchmark.h>
+
+#include "bench_counters.hpp"
+#include "bench_games.hpp"
+#include "perf_counters.hpp"
 #include "nor/nor.hpp"
 
 namespace benchmarks {
 
 using namespace nor;
 
-template < auto config, typename Env, size_t nr_warmup_iters = 1000 >
+template < auto config, typename Game, size_t nr_warmup_iters = 1000 >
 void mccfr_bench(benchmark::State& state)
 {
-   using env = std::remove_cvref_t< Env >;
+   using env = typename Game::env_type;
 
-   auto root_state = std::make_unique< auto_world_state_type< env > >();
+   size_t retained_bytes_start = alloc::snapshot().live_bytes();
 
    auto avg_tabular_policy = factory::make_tabular_policy(
       std::unordered_map<
@@ -29,94 +32,117 @@ void mccfr_bench(benchmark::State& state)
    );
 
    auto solver = factory::make_mccfr< config, true >(
-      env{}, std::move(root_state), tabular_policy, avg_tabular_policy, 0.5
+      env{}, Game::root_state(), tabular_policy, avg_tabular_policy, 0.5
    );
    if constexpr(nr_warmup_iters > 0) {
       // iterate a few rounds to assure all necessary allocations have been made
       solver.iterate(nr_warmup_iters);
    }
 
+   CounterScope< Game > counters;
+   perf::Counters perf_counters;
    for(auto _ : state) {
+      perf_counters.start();
       solver.iterate(1);
+      perf_counters.stop();
    }
+   counters.report(state, retained_bytes_start, n_stored_infostates(solver));
+   auto counts = Game::env_type::counts();
+   perf_counters.report(state, counts.nodes, counts.threads);
 }
 
-inline void (&MCCFR_OS_optimistic_alternating)(benchmark::State& state) = mccfr_bench<
-   rm::MCCFRConfig{
-      .update_mode = rm::UpdateMode::alternating,
-      .algorithm = rm::MCCFRAlgorithmMode::outcome_sampling,
-      .weighting = rm::MCCFRWeightingMode::optimistic},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&MCCFR_OS_optimistic_simultaneous)(benchmark::State& state) = mccfr_bench<
-   rm::MCCFRConfig{
-      .update_mode = rm::UpdateMode::simultaneous,
-      .algorithm = rm::MCCFRAlgorithmMode::outcome_sampling,
-      .weighting = rm::MCCFRWeightingMode::optimistic},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&MCCFR_OS_lazy_alternating)(benchmark::State& state) = mccfr_bench<
-   rm::MCCFRConfig{
-      .update_mode = rm::UpdateMode::alternating,
-      .algorithm = rm::MCCFRAlgorithmMode::outcome_sampling,
-      .weighting = rm::MCCFRWeightingMode::lazy},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&MCCFR_OS_lazy_simultaneous)(benchmark::State& state) = mccfr_bench<
-   rm::MCCFRConfig{
-      .update_mode = rm::UpdateMode::simultaneous,
-      .algorithm = rm::MCCFRAlgorithmMode::outcome_sampling,
-      .weighting = rm::MCCFRWeightingMode::lazy},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&MCCFR_OS_stochastic_alternating)(benchmark::State& state) = mccfr_bench<
-   rm::MCCFRConfig{
-      .update_mode = rm::UpdateMode::alternating,
-      .algorithm = rm::MCCFRAlgorithmMode::outcome_sampling,
-      .weighting = rm::MCCFRWeightingMode::stochastic},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&MCCFR_OS_stochastic_simultaneous)(benchmark::State& state) = mccfr_bench<
-   rm::MCCFRConfig{
-      .update_mode = rm::UpdateMode::simultaneous,
-      .algorithm = rm::MCCFRAlgorithmMode::outcome_sampling,
-      .weighting = rm::MCCFRWeightingMode::stochastic},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&MCCFR_ES_stochastic)(benchmark::State& state) = mccfr_bench<
-   rm::MCCFRConfig{
-      .update_mode = rm::UpdateMode::alternating,
-      .algorithm = rm::MCCFRAlgorithmMode::external_sampling,
-      .weighting = rm::MCCFRWeightingMode::stochastic},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&MCCFR_CS_alternating)(benchmark::State& state) = mccfr_bench<
-   rm::MCCFRConfig{
-      .update_mode = rm::UpdateMode::alternating,
-      .algorithm = rm::MCCFRAlgorithmMode::chance_sampling,
-      .weighting = rm::MCCFRWeightingMode::none},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&MCCFR_CS_simultaneous)(benchmark::State& state) = mccfr_bench<
-   rm::MCCFRConfig{
-      .update_mode = rm::UpdateMode::simultaneous,
-      .algorithm = rm::MCCFRAlgorithmMode::chance_sampling,
-      .weighting = rm::MCCFRWeightingMode::none},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&CFR_PURE_alternating)(benchmark::State& state) = mccfr_bench<
-   rm::MCCFRConfig{
-      .update_mode = rm::UpdateMode::alternating,
-      .algorithm = rm::MCCFRAlgorithmMode::pure_cfr,
-      .weighting = rm::MCCFRWeightingMode::none},
-   games::kuhn::Environment >;  // function reference
-
-inline void (&CFR_PURE_simultaneous)(benchmark::State& state) = mccfr_bench<
-   rm::MCCFRConfig{
-      .update_mode = rm::UpdateMode::simultaneous,
-      .algorithm = rm::MCCFRAlgorithmMode::pure_cfr,
-      .weighting = rm::MCCFRWeightingMode::none},
-   games::kuhn::Environment >;  // function reference
+inline constexpr auto mccfr_os_optimistic_alternating = rm::MCCFRConfig{
+   .update_mode = rm::UpdateMode::alternating,
+   .algorithm = rm::MCCFRAlgorithmMode::outcome_sampling,
+   .weighting = rm::MCCFRWeightingMode::optimistic};
+inline constexpr auto mccfr_os_optimistic_simultaneous = rm::MCCFRConfig{
+   .update_mode = rm::UpdateMode::simultaneous,
+   .algorithm = rm::MCCFRAlgorithmMode::outcome_sampling,
+   .weighting = rm::MCCFRWeightingMode::optimistic};
+inline constexpr auto mccfr_os_lazy_alternating = rm::MCCFRConfig{
+   .update_mode = rm::UpdateMode::alternating,
+   .algorithm = rm::MCCFRAlgorithmMode::outcome_sampling,
+   .weighting = rm::MCCFRWeightingMode::lazy};
+inline constexpr auto mccfr_os_lazy_simultaneous = rm::MCCFRConfig{
+   .update_mode = rm::UpdateMode::simultaneous,
+   .algorithm = rm::MCCFRAlgorithmMode::outcome_sampling,
+   .weighting = rm::MCCFRWeightingMode::lazy};
+inline constexpr auto mccfr_os_stochastic_alternating = rm::MCCFRConfig{
+   .update_mode = rm::UpdateMode::alternating,
+   .algorithm = rm::MCCFRAlgorithmMode::outcome_sampling,
+   .weighting = rm::MCCFRWeightingMode::stochastic};
+inline constexpr auto mccfr_os_stochastic_simultaneous = rm::MCCFRConfig{
+   .update_mode = rm::UpdateMode::simultaneous,
+   .algorithm = rm::MCCFRAlgorithmMode::outcome_sampling,
+   .weighting = rm::MCCFRWeightingMode::stochastic};
+inline constexpr auto mccfr_es_stochastic = rm::MCCFRConfig{
+   .update_mode = rm::UpdateMode::alternating,
+   .algorithm = rm::MCCFRAlgorithmMode::external_sampling,
+   .weighting = rm::MCCFRWeightingMode::stochastic};
+inline constexpr auto mccfr_cs_alternating = rm::MCCFRConfig{
+   .update_mode = rm::UpdateMode::alternating,
+   .algorithm = rm::MCCFRAlgorithmMode::chance_sampling,
+   .weighting = rm::MCCFRWeightingMode::none};
+inline constexpr auto mccfr_cs_simultaneous = rm::MCCFRConfig{
+   .update_mode = rm::UpdateMode::simultaneous,
+   .algorithm = rm::MCCFRAlgorithmMode::chance_sampling,
+   .weighting = rm::MCCFRWeightingMode::none};
+inline constexpr auto cfr_pure_alternating = rm::MCCFRConfig{
+   .update_mode = rm::UpdateMode::alternating,
+   .algorithm = rm::MCCFRAlgorithmMode::pure_cfr,
+   .weighting = rm::MCCFRWeightingMode::none};
+inline constexpr auto cfr_pure_simultaneous = rm::MCCFRConfig{
+   .update_mode = rm::UpdateMode::simultaneous,
+   .algorithm = rm::MCCFRAlgorithmMode::pure_cfr,
+   .weighting = rm::MCCFRWeightingMode::none};
+
+/// registers every MCCFR variant for the given game. Each of external sampling, chance sampling and
+/// pure CFR still traverses every action of the traversing player, so they are skipped for games
+/// too large to traverse.
+template < typename Game >
+void register_mccfr_benchmarks()
+{
+   auto name = [](std::string algo) { return algo + "/" + Game::name(); };
+   benchmark::RegisterBenchmark(
+      name("MCCFR_OS_optimistic_alternating").c_str(),
+      mccfr_bench< mccfr_os_optimistic_alternating, Game >
+   );
+   benchmark::RegisterBenchmark(
+      name("MCCFR_OS_optimistic_simultaneous").c_str(),
+      mccfr_bench< mccfr_os_optimistic_simultaneous, Game >
+   );
+   benchmark::RegisterBenchmark(
+      name("MCCFR_OS_lazy_alternating").c_str(), mccfr_bench< mccfr_os_lazy_alternating, Game >
+   );
+   benchmark::RegisterBenchmark(
+      name("MCCFR_OS_lazy_simultaneous").c_str(), mccfr_bench< mccfr_os_lazy_simultaneous, Game >
+   );
+   benchmark::RegisterBenchmark(
+      name("MCCFR_OS_stochastic_alternating").c_str(),
+      mccfr_bench< mccfr_os_stochastic_alternating, Game >
+   );
+   benchmark::RegisterBenchmark(
+      name("MCCFR_OS_stochastic_simultaneous").c_str(),
+      mccfr_bench< mccfr_os_stochastic_simultaneous, Game >
+   );
+   if constexpr(Game::full_traversal_feasible) {
+      benchmark::RegisterBenchmark(
+         name("MCCFR_ES_stochastic").c_str(), mccfr_bench< mccfr_es_stochastic, Game >
+      );
+      benchmark::RegisterBenchmark(
+         name("MCCFR_CS_alternating").c_str(), mccfr_bench< mccfr_cs_alternating, Game >
+      );
+      benchmark::RegisterBenchmark(
+         name("MCCFR_CS_simultaneous").c_str(), mccfr_bench< mccfr_cs_simultaneous, Game >
+      );
+      benchmark::RegisterBenchmark(
+         name("CFR_PURE_alternating").c_str(), mccfr_bench< cfr_pure_alternating, Game >
+      );
+      benchmark::RegisterBenchmark(
+         name("CFR_PURE_simultaneous").c_str(), mccfr_bench< cfr_pure_simultaneous, Game >
+      );
+   }
+}
 
 }  // namespace benchmarks
 
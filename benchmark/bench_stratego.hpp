@@ -0,0 +1,195 @@
+#ifndef NOR_BENCH_STRATEGO_HPP
+#define NOR_BENCH_STRATEGO_HPP
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include "stratego/stratego.hpp"
+
+namespace benchmarks {
+
+/// a game on one of the default board sizes whose setups are drawn at random
+inline stratego::State stratego_start_state(stratego::DefinedBoardSizes size)
+{
+   using namespace stratego;
+   auto dim = static_cast< size_t >(size);
+   Config::token_variant_t tokens = default_token_sets(dim);
+   size_t n_pieces = 0;
+   for(const auto& [token, count] : std::get< Config::token_counter_t >(tokens)) {
+      n_pieces += count;
+   }
+   // the teams fill their rows from the board's edges
+   std::map< Team, std::optional< std::vector< Position2D > > > start_fields{
+      {Team::BLUE, std::vector< Position2D >{}}, {Team::RED, std::vector< Position2D >{}}};
+   for(size_t i = 0; i < n_pieces; i++) {
+      auto row = int(i / dim);
+      auto col = int(i % dim);
+      start_fields[Team::BLUE]->emplace_back(Position2D{row, col});
+      start_fields[Team::RED]->emplace_back(Position2D{int(dim) - 1 - row, col});
+   }
+   return State{
+      Config{
+         Team::BLUE,
+         dim,
+         std::nullopt,
+         std::map< Team, std::optional< Config::token_variant_t > >{
+            {Team::BLUE, tokens}, {Team::RED, tokens}},
+         start_fields},
+      size_t(0)};
+}
+
+inline std::string stratego_board_name(stratego::DefinedBoardSizes size)
+{
+   auto dim = std::to_string(static_cast< size_t >(size));
+   return dim + "x" + dim;
+}
+
+/// single playouts on one thread, rewinding the state after each of them
+inline void stratego_playout_bench(benchmark::State& state, stratego::DefinedBoardSizes size)
+{
+   auto game = stratego_start_state(size);
+   auto start_round = game.turn_count();
+   stratego::RandomPlayout playout{size_t(0)};
+   size_t n_moves = 0;
+   for(auto _ : state) {
+      benchmark::DoNotOptimize(playout.run(game));
+      n_moves += game.turn_count() - start_round;
+      game.restore_to_round(start_round);
+   }
+   state.SetItemsProcessed(state.iterations());
+   state.counters["moves"] = benchmark::Counter(double(n_moves), benchmark::Counter::kIsRate);
+}
+
+/// batches of playouts on the given number of threads (range(0))
+inline void stratego_playout_batch_bench(benchmark::State& state, stratego::DefinedBoardSizes size)
+{
+   constexpr size_t batch_size = 1024;
+   auto game = stratego_start_state(size);
+   size_t seed = 0;
+   for(auto _ : state) {
+      auto outcomes = stratego::RandomPlayout::run_batch(
+         game, batch_size, seed, size_t(state.range(0))
+      );
+      benchmark::DoNotOptimize(outcomes.data());
+      seed += batch_size;
+   }
+   state.SetItemsProcessed(state.iterations() * long(batch_size));
+}
+
+/// positions along random games from the start, to generate moves in
+inline std::vector< stratego::State > stratego_positions(stratego::DefinedBoardSizes size)
+{
+   constexpr size_t n_positions = 64;
+   constexpr size_t turns_between = 4;
+   auto game = stratego_start_state(size);
+   std::mt19937_64 rng{0};
+   std::vector< stratego::State > positions;
+   positions.reserve(n_positions);
+   while(positions.size() < n_positions) {
+      auto state = game;
+      while(positions.size() < n_positions and state.status() == stratego::Status::ONGOING) {
+         positions.emplace_back(state);
+         for(size_t turn = 0; turn < turns_between; turn++) {
+            auto actions = state.logic()->valid_actions(state, state.active_team());
+            if(actions.empty()) {
+               break;
+            }
+            state.transition(
+               actions[std::uniform_int_distribution< size_t >(0, actions.size() - 1)(rng)]
+            );
+         }
+      }
+   }
+   return positions;
+}
+
+/// the (from, to) moves of the bitboard generation into a reused buffer
+inline void stratego_movegen_bitboard_bench(
+   benchmark::State& state,
+   stratego::DefinedBoardSizes size
+)
+{
+   auto positions = stratego_positions(size);
+   std::vector< std::array< size_t, 2 > > moves;
+   for(auto _ : state) {
+      for(const auto& position : positions) {
+         stratego::Logic::valid_moves(position, position.active_team(), moves);
+         benchmark::DoNotOptimize(moves.data());
+      }
+   }
+   state.SetItemsProcessed(state.iterations() * long(positions.size()));
+}
+
+/// the valid actions of the bitboard generation
+inline void stratego_movegen_actions_bench(
+   benchmark::State& state,
+   stratego::DefinedBoardSizes size
+)
+{
+   auto positions = stratego_positions(size);
+   for(auto _ : state) {
+      for(const auto& position : positions) {
+         auto actions = position.logic()->valid_actions(position, position.active_team());
+         benchmark::DoNotOptimize(actions.data());
+      }
+   }
+   state.SetItemsProcessed(state.iterations() * long(positions.size()));
+}
+
+/// the valid actions of the board scan, as generated before the bitboards
+inline void stratego_movegen_scan_bench(benchmark::State& state, stratego::DefinedBoardSizes size)
+{
+   auto positions = stratego_positions(size);
+   for(auto _ : state) {
+      for(const auto& position : positions) {
+         auto actions = position.logic()->scan_valid_actions(position, position.active_team());
+         benchmark::DoNotOptimize(actions.data());
+      }
+   }
+   state.SetItemsProcessed(state.iterations() * long(positions.size()));
+}
+
+inline void register_stratego_benchmarks()
+{
+   auto max_threads = long(std::max(1u, std::thread::hardware_concurrency()));
+   for(auto size : {stratego::DefinedBoardSizes::small, stratego::DefinedBoardSizes::large}) {
+      auto board = stratego_board_name(size);
+      benchmark::RegisterBenchmark(
+         ("STRATEGO_MOVEGEN/bitboard_moves/" + board).c_str(),
+         stratego_movegen_bitboard_bench,
+         size
+      );
+      benchmark::RegisterBenchmark(
+         ("STRATEGO_MOVEGEN/bitboard_actions/" + board).c_str(),
+         stratego_movegen_actions_bench,
+         size
+      );
+      benchmark::RegisterBenchmark(
+         ("STRATEGO_MOVEGEN/scan_actions/" + board).c_str(), stratego_movegen_scan_bench, size
+      );
+      benchmark::RegisterBenchmark(
+         ("STRATEGO_PLAYOUT/single/" + board).c_str(), stratego_playout_bench, size
+      );
+      // the batches run on their own threads, so only the wall clock time is meaningful
+      benchmark::RegisterBenchmark(
+         ("STRATEGO_PLAYOUT/batch/" + board).c_str(), stratego_playout_batch_bench, size
+      )
+         ->ArgName("threads")
+         ->RangeMultiplier(2)
+         ->Range(1, max_threads)
+         ->UseRealTime();
+   }
+}
+
+}  // namespace benchmarks
+
+#endif  // NOR_BENCH_STRATEGO_HPP
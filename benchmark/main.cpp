@@ -1,28 +1,57 @@
+
 #include <benchmark/benchmark.h>
 
+#include "alloc_counter.hpp"
 #include "bench_cfr.hpp"
+#include "bench_evaluator.hpp"
+#include "bench_exploitability.hpp"
+#include "bench_games.hpp"
 #include "bench_mccfr.hpp"
+#include "bench_stratego.hpp"
+#include "perf_counters.hpp"
+
+namespace benchmarks {
 
-BENCHMARK(benchmarks::CFR_VANILLA_alternating);
-BENCHMARK(benchmarks::CFR_VANILLA_simultaneous);
-BENCHMARK(benchmarks::CFR_LINEAR_alternating);
-BENCHMARK(benchmarks::CFR_LINEAR_simultaneous);
-BENCHMARK(benchmarks::CFR_DISCOUNTED_alternating);
-BENCHMARK(benchmarks::CFR_DISCOUNTED_simultaneous);
-BENCHMARK(benchmarks::CFR_EXPONENTIAL_alternating);
-BENCHMARK(benchmarks::CFR_EXPONENTIAL_simultaneous);
+template < typename... Games >
+void register_all()
+{
+   (register_cfr_benchmarks< Games >(), ...);
+   (register_mccfr_benchmarks< Games >(), ...);
+   (register_evaluation_benchmarks< Games >(), ...);
+}
 
-BENCHMARK(benchmarks::CFR_PURE_alternating);
-BENCHMARK(benchmarks::CFR_PURE_simultaneous);
+}  // namespace benchmarks
 
-BENCHMARK(benchmarks::MCCFR_OS_optimistic_alternating);
-BENCHMARK(benchmarks::MCCFR_OS_optimistic_simultaneous);
-BENCHMARK(benchmarks::MCCFR_OS_lazy_alternating);
-BENCHMARK(benchmarks::MCCFR_OS_lazy_simultaneous);
-BENCHMARK(benchmarks::MCCFR_OS_stochastic_alternating);
-BENCHMARK(benchmarks::MCCFR_OS_stochastic_simultaneous);
-BENCHMARK(benchmarks::MCCFR_ES_stochastic);
-BENCHMARK(benchmarks::MCCFR_CS_alternating);
-BENCHMARK(benchmarks::MCCFR_CS_simultaneous);
+int main(int argc, char** argv)
+{
+   using namespace benchmarks::games;
+   benchmarks::register_all<
+      kuhn,
+      // a ladder of about 10^2, ..., 10^7 infostates
+      kuhn_general< 2, 25 >,
+      kuhn_general< 3, 40 >,
+      kuhn_general< 4, 32 >,
+      kuhn_general< 6, 52 >,
+      kuhn_general< 8, 100 >,
+      kuhn_general< 10, 200 >,
+      kuhn_general< 10, 2000 >,
+      leduc< 2 >,
+      leduc< 3 >,
+      leduc5< 2 >,
+      leduc5< 3 >,
+      rps,
+      stratego_small,
+      limit_holdem >();
+   benchmarks::register_evaluator_benchmarks();
+   benchmarks::register_stratego_benchmarks();
 
-BENCHMARK_MAIN();
+   benchmarks::alloc::parse_budget_flags(argc, argv);
+   benchmarks::perf::parse_perf_flags(argc, argv);
+   benchmark::Initialize(&argc, argv);
+   if(benchmark::ReportUnrecognizedArguments(argc, argv)) {
+      return 1;
+   }
+   benchmark::RunSpecifiedBenchmarks();
+   benchmark::Shutdown();
+   return benchmarks::alloc::budget_exceeded() ? 1 : 0;
+}
@@ -0,0 +1,78 @@
+
+#include <sys/resource.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "alloc_counter.hpp"
+
+namespace benchmarks::alloc {
+
+Budget& budget()
+{
+   static Budget budget_{};
+   return budget_;
+}
+
+bool& budget_exceeded()
+{
+   static bool exceeded = false;
+   return exceeded;
+}
+
+void parse_budget_flags(int& argc, char** argv)
+{
+   auto parse_flag = [](std::string_view arg, std::string_view flag, std::optional< double >& out) {
+      if(arg.starts_with(flag) and arg.size() > flag.size() and arg[flag.size()] == '=') {
+         out = std::stod(std::string(arg.substr(flag.size() + 1)));
+         return true;
+      }
+      return false;
+   };
+   int kept = 1;
+   for(int i = 1; i < argc; ++i) {
+      std::string_view arg{argv[i]};
+      if(parse_flag(arg, "--alloc_budget_per_iter", budget().allocs_per_iter)
+         or parse_flag(arg, "--bytes_budget_per_iter", budget().bytes_per_iter)
+         or parse_flag(arg, "--peak_rss_budget_mb", budget().peak_rss_mb)) {
+         continue;
+      }
+      argv[kept++] = argv[i];
+   }
+   argc = kept;
+   if(not tracking_enabled
+      and (budget().allocs_per_iter.has_value() or budget().bytes_per_iter.has_value()
+           or budget().peak_rss_mb.has_value())) {
+      std::cerr << "Allocation tracking is not compiled in (ENABLE_BENCHMARK_ALLOC_TRACKING=OFF). "
+                   "The memory budgets are not checked.\n";
+   }
+}
+
+void reset_peak_rss()
+{
+   // writing '5' to clear_refs resets the VmHWM (peak RSS) counter of the process
+   std::ofstream clear_refs("/proc/self/clear_refs");
+   if(clear_refs) {
+      clear_refs << "5";
+   }
+}
+
+size_t peak_rss_bytes()
+{
+   std::ifstream status("/proc/self/status");
+   std::string line;
+   while(std::getline(status, line)) {
+      if(line.starts_with("VmHWM:")) {
+         return std::stoul(line.substr(std::strlen("VmHWM:"))) * 1024;
+      }
+   }
+   // fall back to the process-lifetime maximum if procfs is not available
+   rusage usage{};
+   getrusage(RUSAGE_SELF, &usage);
+   return static_cast< size_t >(usage.ru_maxrss) * 1024;
+}
+
+}  // namespace benchmarks::alloc
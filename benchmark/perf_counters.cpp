@@ -0,0 +1,177 @@
+
+#include "perf_counters.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string_view>
+#include <utility>
+
+#ifdef __linux__
+   #include <linux/perf_event.h>
+   #include <sys/ioctl.h>
+   #include <sys/syscall.h>
+   #include <unistd.h>
+#endif
+
+namespace benchmarks::perf {
+
+bool& requested()
+{
+   static bool requested_ = false;
+   return requested_;
+}
+
+void parse_perf_flags(int& argc, char** argv)
+{
+   int kept = 1;
+   for(int i = 1; i < argc; ++i) {
+      if(std::string_view{argv[i]} == "--perf_counters") {
+         requested() = true;
+         continue;
+      }
+      argv[kept++] = argv[i];
+   }
+   argc = kept;
+}
+
+#ifdef __linux__
+
+namespace {
+
+int open_event(uint32_t type, uint64_t config, int group_fd)
+{
+   perf_event_attr attr{};
+   attr.size = sizeof(perf_event_attr);
+   attr.type = type;
+   attr.config = config;
+   attr.disabled = group_fd == -1 ? 1 : 0;
+   attr.exclude_kernel = 1;
+   attr.exclude_hv = 1;
+   attr.read_format = PERF_FORMAT_GROUP;
+   return static_cast< int >(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+}  // namespace
+
+Counters::Counters()
+{
+   m_fds.fill(-1);
+   if(not requested()) {
+      return;
+   }
+   constexpr std::array< std::pair< uint32_t, uint64_t >, n_events > events{
+      std::pair{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      std::pair{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      std::pair{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+      std::pair{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+      std::pair{
+         PERF_TYPE_HW_CACHE,
+         PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)}};
+   for(size_t i = 0; i < n_events; ++i) {
+      m_fds[i] = open_event(events[i].first, events[i].second, m_group_fd);
+      if(m_fds[i] < 0) {
+         static bool warned = false;
+         if(not std::exchange(warned, true)) {
+            std::cerr << "Could not open perf event '" << event_names[i]
+                      << "'. Hardware counters are disabled.\n";
+         }
+         _close();
+         return;
+      }
+      if(i == 0) {
+         m_group_fd = m_fds[0];
+      }
+   }
+   ioctl(m_group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+}
+
+Counters::~Counters()
+{
+   _close();
+}
+
+void Counters::_close()
+{
+   for(int& fd : m_fds) {
+      if(fd >= 0) {
+         close(fd);
+      }
+      fd = -1;
+   }
+   m_group_fd = -1;
+}
+
+void Counters::start() const
+{
+   if(active()) {
+      ioctl(m_group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+   }
+}
+
+void Counters::stop() const
+{
+   if(active()) {
+      ioctl(m_group_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+   }
+}
+
+std::array< uint64_t, Counters::n_events > Counters::read() const
+{
+   std::array< uint64_t, n_events > values{};
+   if(not active()) {
+      return values;
+   }
+   // PERF_FORMAT_GROUP layout: the number of events followed by one value per event
+   std::array< uint64_t, n_events + 1 > buffer{};
+   if(::read(m_group_fd, buffer.data(), sizeof(buffer)) > 0) {
+      std::copy(buffer.begin() + 1, buffer.end(), values.begin());
+   }
+   return values;
+}
+
+#else
+
+Counters::Counters()
+{
+   m_fds.fill(-1);
+}
+Counters::~Counters() = default;
+void Counters::_close() {}
+void Counters::start() const {}
+void Counters::stop() const {}
+std::array< uint64_t, Counters::n_events > Counters::read() const
+{
+   return {};
+}
+
+#endif
+
+void Counters::report(benchmark::State& state, size_t n_nodes, size_t n_threads) const
+{
+   if(not active()) {
+      return;
+   }
+   if(n_threads > 1) {
+      static bool warned = false;
+      if(not std::exchange(warned, true)) {
+         std::cerr << "Hardware counters only cover the calling thread. They are not reported for "
+                      "multi-threaded runs.\n";
+      }
+      return;
+   }
+   using benchmark::Counter;
+   auto values = read();
+   for(size_t i = 0; i < n_events; ++i) {
+      auto name = std::string(event_names[i]);
+      state.counters[name + "_per_iter"] = Counter(double(values[i]), Counter::kAvgIterations);
+      if(n_nodes > 0) {
+         state.counters[name + "_per_node"] = double(values[i]) / double(n_nodes);
+      }
+   }
+   if(values[cycles] > 0) {
+      state.counters["ipc"] = double(values[instructions]) / double(values[cycles]);
+   }
+}
+
+}  // namespace benchmarks::perf
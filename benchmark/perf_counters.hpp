@@ -0,0 +1,78 @@
+
+#ifndef NOR_BENCH_PERF_COUNTERS_HPP
+#define NOR_BENCH_PERF_COUNTERS_HPP
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace benchmarks::perf {
+
+/// whether the hardware counters were requested on the command line via `--perf_counters`
+bool& requested();
+
+/// parses and removes the `--perf_counters` flag from the command line
+void parse_perf_flags(int& argc, char** argv);
+
+/**
+ * @brief A group of Linux hardware performance counters (via perf_event_open).
+ *
+ * The counters only run between `start` and `stop`, so wrapping a single solver iteration with
+ * them excludes the benchmark loop's own bookkeeping. If the counters were not requested, the
+ * platform is not Linux or the kernel refuses access (see /proc/sys/kernel/perf_event_paranoid),
+ * then every member function is a no-op.
+ *
+ * The events are counted for the calling thread only. Work done by worker threads (parallel
+ * solvers, parallelized chance nodes) is therefore invisible to them, which is why `report` drops
+ * the hardware metrics of any run whose nodes were touched by more than one thread.
+ */
+class Counters {
+  public:
+   enum Event : uint8_t {
+      cycles = 0,
+      instructions,
+      cache_misses,
+      branch_misses,
+      dtlb_misses,
+      n_events
+   };
+
+   static constexpr std::array< const char*, n_events > event_names{
+      "cycles", "instructions", "cache_misses", "branch_misses", "dtlb_misses"};
+
+   Counters();
+   Counters(const Counters&) = delete;
+   Counters& operator=(const Counters&) = delete;
+   Counters(Counters&&) = delete;
+   Counters& operator=(Counters&&) = delete;
+   ~Counters();
+
+   [[nodiscard]] bool active() const { return m_group_fd >= 0; }
+
+   void start() const;
+   void stop() const;
+
+   /// the accumulated counts over all start/stop spans
+   [[nodiscard]] std::array< uint64_t, n_events > read() const;
+
+   /**
+    * @brief Reports each event per iteration and per node (if `n_nodes` > 0) as benchmark counters.
+    *
+    * @param n_nodes the number of nodes touched over all threads.
+    * @param n_threads the number of threads which touched nodes. Only single-threaded runs are
+    * reported, since the counters miss the events of the other threads.
+    */
+   void report(benchmark::State& state, size_t n_nodes, size_t n_threads) const;
+
+  private:
+   int m_group_fd = -1;
+   std::array< int, n_events > m_fds{};
+
+   void _close();
+};
+
+}  // namespace benchmarks::perf
+
+#endif  // NOR_BENCH_PERF_COUNTERS_HPP
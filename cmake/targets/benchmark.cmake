@@ -1,7 +1,18 @@
-set(BENCHMARK_SOURCES main.cpp)
+set(BENCHMARK_SOURCES main.cpp memory_budget.cpp perf_counters.cpp)
+if(ENABLE_BENCHMARK_ALLOC_TRACKING)
+    # replaces the global operator new/delete to count every heap allocation of the benchmark
+    list(APPEND BENCHMARK_SOURCES alloc_counter.cpp)
+else()
+    message(STATUS "Benchmark allocation tracking is disabled: the allocs_per_iter, bytes_per_iter, "
+                   "bytes_per_infostate and peak_rss_mb counters are not available and the memory budgets are not checked.")
+endif()
 
 list(TRANSFORM BENCHMARK_SOURCES PREPEND "${PROJECT_NOR_BENCHMARK_SRC_DIR}/")
 
 add_executable(${nor_benchmark} ${BENCHMARK_SOURCES})
 
 target_link_libraries(${nor_benchmark} PRIVATE ${nor_lib}_envs benchmark::benchmark)
+
+if(ENABLE_BENCHMARK_ALLOC_TRACKING)
+    target_compile_definitions(${nor_benchmark} PRIVATE NOR_BENCHMARK_TRACK_ALLOCATIONS)
+endif()
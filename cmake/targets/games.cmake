@@ -1,16 +1,23 @@
 # required dependencies for the games:
 find_package(xtensor REQUIRED)
+find_package(Threads REQUIRED)
 
 # ######################################################################################################################
 # Stratego
 # ######################################################################################################################
 
 set(STRATEGO_SOURCES
+    Belief.cpp
+    Bitboard.cpp
     Game.cpp
+    ISMCTS.cpp
     Config.cpp
     Utils.cpp
     State.cpp
-    Logic.cpp)
+    Logic.cpp
+    Playout.cpp
+    Setup.cpp
+    Zobrist.cpp)
 
 list(TRANSFORM STRATEGO_SOURCES PREPEND "${PROJECT_GAMES_DIR}/stratego/impl/")
 
@@ -25,7 +32,8 @@ target_link_libraries(
            common
            xtensor
            range-v3::range-v3
-           namedtype::namedtype)
+           namedtype::namedtype
+           Threads::Threads)
 
 # ######################################################################################################################
 # Leduc Poker
@@ -41,11 +49,31 @@ target_include_directories(leduc_poker PUBLIC ${PROJECT_GAMES_DIR}/leduc_poker/i
 
 target_link_libraries(leduc_poker PUBLIC required_min_libs common range-v3::range-v3)
 
+# ######################################################################################################################
+# Texas Hold'em Poker
+# ######################################################################################################################
+
+set(TEXASHOLDEMPOKER_SOURCES
+    state.cpp
+    hand_rank.cpp
+    evaluator.cpp
+    hand_indexer.cpp
+    abstraction.cpp
+    action_abstraction.cpp)
+
+list(TRANSFORM TEXASHOLDEMPOKER_SOURCES PREPEND "${PROJECT_GAMES_DIR}/texas_holdem_poker/impl/")
+
+add_library(texas_holdem_poker SHARED ${TEXASHOLDEMPOKER_SOURCES})
+
+target_include_directories(texas_holdem_poker PUBLIC ${PROJECT_GAMES_DIR}/texas_holdem_poker/include)
+
+target_link_libraries(texas_holdem_poker PUBLIC required_min_libs common range-v3::range-v3 Threads::Threads)
+
 # ######################################################################################################################
 # Kuhn Poker
 # ######################################################################################################################
 
-set(KUHNPOKER_SOURCES state.cpp)
+set(KUHNPOKER_SOURCES state.cpp general.cpp)
 
 list(TRANSFORM KUHNPOKER_SOURCES PREPEND "${PROJECT_GAMES_DIR}/kuhn_poker/impl/")
 
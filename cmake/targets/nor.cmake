@@ -28,6 +28,10 @@ target_link_libraries(
 
 set_target_properties(${nor_lib} PROPERTIES CXX_VISIBILITY_PRESET hidden)
 
+if(ENABLE_SOLVER_INSTRUMENTATION)
+    target_compile_definitions(${nor_lib} INTERFACE NOR_ENABLE_SOLVER_INSTRUMENTATION)
+endif()
+
 # ######################################################################################################################
 # NOR Environment Wrappers      ###
 # ######################################################################################################################
@@ -36,7 +40,8 @@ set(WRAPPER_SOURCES
     stratego.cpp
     kuhn.cpp
     leduc.cpp
-    rps.cpp)
+    rps.cpp
+    texholdem.cpp)
 list(TRANSFORM WRAPPER_SOURCES PREPEND "${PROJECT_NOR_DIR}/impl/")
 
 if(ENABLE_GAMES)
@@ -51,5 +56,6 @@ if(ENABLE_GAMES)
                stratego
                kuhn_poker
                leduc_poker
-               rock_paper_scissors)
+               rock_paper_scissors
+               texas_holdem_poker)
 endif()
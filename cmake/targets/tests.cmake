@@ -13,6 +13,9 @@ register_nor_target(${nor_test}_cfr_monte_carlo test_cfr_monte_carlo.cpp)
 register_nor_target(${nor_test}_policy test_policy.cpp)
 register_nor_target(${nor_test}_helpers test_helpers.cpp)
 register_nor_target(${nor_test}_exploitability test_exploitability.cpp)
+register_nor_target(${nor_test}_env_kuhn test_env_kuhn.cpp)
+register_nor_target(${nor_test}_env_stratego test_env_stratego.cpp)
+register_nor_target(${nor_test}_batch test_batch.cpp)
 # for the overall test executable we simply merge all other test files together
 foreach(sources_list IN LISTS REGISTERED_TEST_SOURCES_LIST)
     list(APPEND NOR_TEST_SOURCES ${${sources_list}})
@@ -41,7 +44,12 @@ if(ENABLE_GAMES)
         test_config.cpp
         test_game.cpp
         test_state.cpp
-        test_piece.cpp)
+        test_piece.cpp
+        test_bitboard.cpp
+        test_zobrist.cpp
+        test_ismcts.cpp
+        test_setup.cpp
+        test_belief.cpp)
     register_game_target(
         kuhn_poker
         INCLUDE_DIR
@@ -49,7 +57,8 @@ if(ENABLE_GAMES)
         LINK_LIBRARY
         kuhn_poker
         SOURCE_FILES
-        test_state.cpp)
+        test_state.cpp
+        test_general.cpp)
     register_game_target(
         leduc_poker
         INCLUDE_DIR
@@ -58,4 +67,16 @@ if(ENABLE_GAMES)
         leduc_poker
         SOURCE_FILES
         test_state.cpp)
+    register_game_target(
+        texas_holdem_poker
+        INCLUDE_DIR
+        texas_holdem_poker
+        LINK_LIBRARY
+        texas_holdem_poker
+        SOURCE_FILES
+        test_state.cpp
+        test_evaluator.cpp
+        test_hand_indexer.cpp
+        test_abstraction.cpp
+        test_action_abstraction.cpp)
 endif()
@@ -0,0 +1,46 @@
+
+#include "kuhn_poker/general.hpp"
+
+namespace kuhn::general {
+
+std::vector< ChanceOutcome > State::chance_actions() const
+{
+   if(m_n_dealt == m_n_players) {
+      return {};
+   }
+   std::vector< ChanceOutcome > outcomes;
+   outcomes.reserve(m_n_cards - m_n_dealt);
+   for(Card card = 0; card < m_n_cards; card++) {
+      if(not _is_dealt(card)) {
+         outcomes.emplace_back(ChanceOutcome{Player(m_n_dealt), card});
+      }
+   }
+   return outcomes;
+}
+
+std::vector< Action > State::actions() const
+{
+   if(not is_valid(Action::check)) {
+      return {};
+   }
+   return std::vector< Action >{Action::check, Action::bet};
+}
+
+std::vector< Action > State::history() const
+{
+   std::vector< Action > history;
+   history.reserve(m_n_actions);
+   if(m_bettor < 0) {
+      history.assign(m_n_actions, Action::check);
+      return history;
+   }
+   // everyone before the bettor checked
+   history.assign(size_t(m_bettor), Action::check);
+   history.emplace_back(Action::bet);
+   for(size_t response = 0; response < m_n_responses; response++) {
+      history.emplace_back(Action((m_calls >> response) & 1u));
+   }
+   return history;
+}
+
+}  // namespace kuhn::general
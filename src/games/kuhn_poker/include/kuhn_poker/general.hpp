@@ -0,0 +1,259 @@
+
+#ifndef NOR_KUHN_POKER_GENERAL_HPP
+#define NOR_KUHN_POKER_GENERAL_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "kuhn_poker/state.hpp"
+
+/// Kuhn poker with any number of players and cards (the variant of Kuhn's 3-player paper).
+namespace kuhn::general {
+
+/// the most players a game can seat, which bounds the inline storage of the state
+inline constexpr size_t max_players = 10;
+/// the most cards a deck can hold (the largest card value is reserved for 'not dealt')
+inline constexpr size_t max_cards = std::numeric_limits< uint16_t >::max();
+
+/// the cards are the ranks 0, ..., n_cards - 1 and the higher rank wins the showdown
+using Card = uint16_t;
+
+/**
+ * @brief The size of a generalised Kuhn game.
+ *
+ * Every player antes 1 and is dealt one card. In turn, players check or bet 1 until the first bet,
+ * after which every other player calls (`Action::bet`) or folds (`Action::check`) exactly once.
+ *
+ * A player's infostate is their card and the public betting sequence, of which every player has
+ * 2^(n_players - 1) to decide at. This gives n_players * n_cards * 2^(n_players - 1) infostates in
+ * total, i.e. a continuous knob on the tree size between Kuhn (12 infostates) and far beyond Leduc.
+ */
+struct Config {
+   size_t n_players = 2;
+   size_t n_cards = 3;
+
+   /// throws if the game is not playable or exceeds the inline capacities of the state
+   constexpr void validate() const
+   {
+      if(n_players < 2 or n_players > max_players) {
+         throw std::invalid_argument(
+            "The number of players has to be in [2, " + std::to_string(max_players) + "], but is "
+            + std::to_string(n_players) + "."
+         );
+      }
+      if(n_cards < n_players or n_cards > max_cards) {
+         throw std::invalid_argument(
+            "The number of cards has to be in [n_players, " + std::to_string(max_cards)
+            + "], but is " + std::to_string(n_cards) + "."
+         );
+      }
+   }
+
+   /// the number of betting sequences each player acts at
+   [[nodiscard]] constexpr size_t n_histories_per_player() const
+   {
+      return size_t(1) << (n_players - 1);
+   }
+   [[nodiscard]] constexpr size_t n_infostates_per_player() const
+   {
+      return n_cards * n_histories_per_player();
+   }
+   [[nodiscard]] constexpr size_t n_infostates() const
+   {
+      return n_players * n_infostates_per_player();
+   }
+};
+
+struct ChanceOutcome {
+   Player player;
+   Card card;
+};
+
+inline bool operator==(const ChanceOutcome& outcome1, const ChanceOutcome& outcome2)
+{
+   return outcome1.player == outcome2.player and outcome1.card == outcome2.card;
+}
+
+/**
+ * @brief The world state of a generalised Kuhn game.
+ *
+ * Like the 2-player state it is trivially copyable and small (the config is stored inline), and
+ * all queries other than the listing of actions and outcomes are constexpr and allocation free.
+ * Cards are dealt by the chance player one at a time in seat order.
+ */
+class State {
+  public:
+   constexpr State(Config config = {})
+       : m_n_cards(uint16_t(config.n_cards)), m_n_players(uint8_t(config.n_players))
+   {
+      config.validate();
+      m_cards.fill(not_dealt);
+   }
+
+   constexpr void apply_action(Action action)
+   {
+      if(active_player() == Player::chance or is_terminal()) {
+         throw std::logic_error("No player is to act in this state.");
+      }
+      auto player = static_cast< size_t >(active_player());
+      if(m_bettor < 0) {
+         if(action == Action::bet) {
+            m_bettor = int8_t(player);
+         }
+      } else {
+         m_calls |= uint16_t(unsigned(action == Action::bet) << m_n_responses);
+         m_n_responses++;
+      }
+      m_n_actions++;
+   }
+   constexpr void apply_action(ChanceOutcome outcome)
+   {
+      if(not is_valid(outcome)) {
+         throw std::logic_error(
+            "Card " + std::to_string(outcome.card) + " can not be dealt to player "
+            + std::to_string(int(outcome.player)) + "."
+         );
+      }
+      m_cards[m_n_dealt++] = outcome.card;
+   }
+   [[nodiscard]] constexpr bool is_valid(Action) const
+   {
+      return active_player() != Player::chance and not is_terminal();
+   }
+   [[nodiscard]] constexpr bool is_valid(ChanceOutcome outcome) const
+   {
+      return m_n_dealt < m_n_players and static_cast< size_t >(outcome.player) == m_n_dealt
+             and outcome.card < m_n_cards and not _is_dealt(outcome.card);
+   }
+   [[nodiscard]] constexpr bool is_terminal() const
+   {
+      if(m_bettor < 0) {
+         return m_n_actions == m_n_players;
+      }
+      return m_n_responses == m_n_players - 1u;
+   }
+   [[nodiscard]] std::vector< Action > actions() const;
+   [[nodiscard]] std::vector< ChanceOutcome > chance_actions() const;
+   [[nodiscard]] constexpr double chance_probability(ChanceOutcome) const
+   {
+      if(m_n_dealt == m_n_players) {
+         return 0.;
+      }
+      return 1. / double(m_n_cards - m_n_dealt);
+   }
+   [[nodiscard]] constexpr int payoff(Player player) const
+   {
+      if(player == Player::chance) {
+         throw std::invalid_argument("Can't provide payoff for chance player.");
+      }
+      if(not is_terminal()) {
+         return 0;
+      }
+      // the winner is the highest card among the players who did not fold
+      int pot = m_n_players;
+      size_t winner = 0;
+      bool has_contender = false;
+      for(size_t p = 0; p < m_n_players; p++) {
+         pot += _has_bet(p);
+         if(not _has_folded(p) and (not has_contender or m_cards[p] > m_cards[winner])) {
+            winner = p;
+            has_contender = true;
+         }
+      }
+      auto p = static_cast< size_t >(player);
+      return (p == winner ? pot : 0) - 1 - int(_has_bet(p));
+   }
+
+   [[nodiscard]] constexpr Player active_player() const
+   {
+      if(m_n_dealt < m_n_players) {
+         return Player::chance;
+      }
+      if(m_bettor < 0) {
+         return Player(m_n_actions % m_n_players);
+      }
+      return Player((size_t(m_bettor) + 1 + m_n_responses) % m_n_players);
+   }
+   [[nodiscard]] constexpr std::optional< Card > card(Player player) const
+   {
+      auto card = m_cards[static_cast< size_t >(player)];
+      if(card == not_dealt) {
+         return std::nullopt;
+      }
+      return card;
+   }
+   /// the decoded action history in the order of play
+   [[nodiscard]] std::vector< Action > history() const;
+   [[nodiscard]] constexpr size_t history_size() const { return m_n_actions; }
+   [[nodiscard]] constexpr Config config() const { return {m_n_players, m_n_cards}; }
+
+   /**
+    * @brief The index of the public betting sequence among the sequences of the active player.
+    *
+    * Before any bet, the active player has only seen checks (index 0). After a bet with k of the
+    * other players having responded since, the k responses form the low bits of the index
+    * 2^k + responses, which covers [1, 2^(n_players - 1)) over k = 0, ..., n_players - 2.
+    */
+   [[nodiscard]] constexpr size_t history_index() const
+   {
+      if(m_bettor < 0) {
+         return 0;
+      }
+      return (size_t(1) << m_n_responses) + m_calls;
+   }
+   /// the index of the active player's infostate in [0, config().n_infostates_per_player())
+   [[nodiscard]] constexpr size_t infostate_index() const
+   {
+      return size_t(m_cards[static_cast< size_t >(active_player())])
+                * config().n_histories_per_player()
+             + history_index();
+   }
+
+  private:
+   static constexpr Card not_dealt = std::numeric_limits< Card >::max();
+
+   std::array< Card, max_players > m_cards{};
+   uint16_t m_n_cards;
+   /// the bits of the responses to the bet (in order of play), set for a call
+   uint16_t m_calls = 0;
+   uint8_t m_n_players;
+   uint8_t m_n_dealt = 0;
+   uint8_t m_n_actions = 0;
+   uint8_t m_n_responses = 0;
+   int8_t m_bettor = -1;
+
+   [[nodiscard]] constexpr bool _is_dealt(Card card) const
+   {
+      for(size_t p = 0; p < m_n_dealt; p++) {
+         if(m_cards[p] == card) {
+            return true;
+         }
+      }
+      return false;
+   }
+   /// the position of the player's response to the bet
+   [[nodiscard]] constexpr size_t _response_position(size_t player) const
+   {
+      return (player + m_n_players - size_t(m_bettor) - 1) % m_n_players;
+   }
+   [[nodiscard]] constexpr bool _has_bet(size_t player) const
+   {
+      if(m_bettor < 0) {
+         return false;
+      }
+      return player == size_t(m_bettor) or ((m_calls >> _response_position(player)) & 1u);
+   }
+   [[nodiscard]] constexpr bool _has_folded(size_t player) const
+   {
+      return m_bettor >= 0 and not _has_bet(player);
+   }
+};
+
+}  // namespace kuhn::general
+
+#endif  // NOR_KUHN_POKER_GENERAL_HPP
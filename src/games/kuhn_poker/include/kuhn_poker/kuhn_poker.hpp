@@ -3,6 +3,7 @@
 #ifndef NOR_KUHN_POKER_HPP
 #define NOR_KUHN_POKER_HPP
 
+#include "kuhn_poker/general.hpp"
 #include "kuhn_poker/state.hpp"
 #include "kuhn_poker/utils.hpp"
 
@@ -3,9 +3,13 @@
 #define NOR_KUHN_POKER_STATE_HPP
 
 #include <array>
+#include <bit>
+#include <cstdint>
+#include <initializer_list>
 #include <optional>
 #include <range/v3/all.hpp>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 
 namespace kuhn {
@@ -58,40 +62,214 @@ inline bool operator==(const History& left, const History& right)
    });
 }
 
+/// the longest action sequence a state can store (terminal sequences are at most 3 actions long)
+inline constexpr size_t max_history_length = 7;
+
+namespace detail {
+
+/**
+ * @brief A betting sequence as a single byte.
+ *
+ * The i-th action is stored in bit i (set for a bet) below a leading sentinel bit at the position
+ * of the sequence length. The empty sequence is therefore 1 and every code is unique.
+ */
+using SequenceCode = uint8_t;
+
+inline constexpr SequenceCode empty_sequence = 1;
+
+constexpr size_t sequence_length(SequenceCode code)
+{
+   return size_t(std::bit_width(code)) - 1;
+}
+
+constexpr SequenceCode append(SequenceCode code, Action action)
+{
+   auto length = sequence_length(code);
+   return SequenceCode(
+      (code ^ (1u << length)) | (unsigned(action) << length) | (1u << (length + 1))
+   );
+}
+
+constexpr Action action_at(SequenceCode code, size_t index)
+{
+   return Action((code >> index) & 1u);
+}
+
+/// the outcome of a betting sequence
+struct SequenceInfo {
+   bool is_terminal = false;
+   /// the chips each player has put into the pot (including the ante of 1)
+   std::array< int8_t, 2 > contributions = {1, 1};
+   /// the player who folded (-1 if the sequence ends in a showdown)
+   int8_t folder = -1;
+};
+
+/// plays out every betting sequence once, so that the state only has to look its code up
+constexpr std::array< SequenceInfo, 1u << (max_history_length + 1) > make_sequence_table()
+{
+   std::array< SequenceInfo, 1u << (max_history_length + 1) > table{};
+   for(size_t code = empty_sequence; code < table.size(); code++) {
+      auto& info = table[code];
+      int bettor = -1;
+      bool is_over = false;
+      for(size_t i = 0; i < sequence_length(SequenceCode(code)); i++) {
+         if(is_over) {
+            // actions after the end of the game void the sequence
+            info = SequenceInfo{};
+            break;
+         }
+         auto player = i % 2;
+         if(action_at(SequenceCode(code), i) == Action::bet) {
+            info.contributions[player] += 1;
+            // a bet into a bet is a call and leads to the showdown
+            is_over = bettor != -1;
+            bettor = int(player);
+         } else if(bettor != -1) {
+            // checking after a bet folds
+            info.folder = int8_t(player);
+            is_over = true;
+         } else {
+            // checking around leads to the showdown
+            is_over = i == 1;
+         }
+         info.is_terminal = is_over;
+      }
+   }
+   return table;
+}
+
+inline constexpr auto sequence_table = make_sequence_table();
+
+constexpr uint16_t card_bit(Card card)
+{
+   return uint16_t(1u << unsigned(card));
+}
+
+}  // namespace detail
+
+/**
+ * @brief The world state of Kuhn poker.
+ *
+ * The whole state fits into 4 bytes: the card pool as a bitmask over the ranks, both players'
+ * cards as one nibble each and the betting sequence as a `detail::SequenceCode`. Transitions are
+ * bit operations and terminal checks and payoffs are lookups of the sequence code in a table that
+ * is built at compile time, so that the state adds next to no overhead to the solvers that run on
+ * it.
+ */
 class State {
   public:
-   State(std::vector< Card > card_pool = {Card::jack, Card::queen, Card::king})
-       : m_card_pool(std::move(card_pool))
+   constexpr State(std::initializer_list< Card > card_pool = {Card::jack, Card::queen, Card::king})
    {
+      for(auto card : card_pool) {
+         m_card_pool |= detail::card_bit(card);
+      }
    }
 
-   void apply_action(Action action);
-   void apply_action(ChanceOutcome action);
-   [[nodiscard]] bool is_valid(Action action) const;
-   [[nodiscard]] bool is_valid(ChanceOutcome outcome) const;
-   [[nodiscard]] bool is_terminal() const;
+   constexpr void apply_action(Action action)
+   {
+      // the game is over after at most 3 actions, so the history can never overflow
+      if(is_terminal()) {
+         throw std::logic_error("Can't apply an action to a terminal state.");
+      }
+      m_sequence = detail::append(m_sequence, action);
+   }
+   constexpr void apply_action(ChanceOutcome action)
+   {
+      if(card(action.player).has_value()) {
+         throw std::logic_error("Card has already been assigned.");
+      }
+      m_cards |= uint8_t(unsigned(action.card) << _nibble(action.player));
+   }
+   [[nodiscard]] constexpr bool is_valid(Action) const
+   {
+      return _all_cards_engaged() and not is_terminal();
+   }
+   [[nodiscard]] constexpr bool is_valid(ChanceOutcome outcome) const
+   {
+      return not _all_cards_engaged() and outcome.player == _player_to_deal()
+             and (_available_cards() & detail::card_bit(outcome.card));
+   }
+   [[nodiscard]] constexpr bool is_terminal() const
+   {
+      return detail::sequence_table[m_sequence].is_terminal;
+   }
    [[nodiscard]] std::vector< Action > actions() const;
    [[nodiscard]] std::vector< ChanceOutcome > chance_actions() const;
-   [[nodiscard]] double chance_probability(ChanceOutcome action) const;
-   [[nodiscard]] int payoff(Player player) const;
+   [[nodiscard]] constexpr double chance_probability(ChanceOutcome) const
+   {
+      if(_all_cards_engaged()) {
+         return 0.;
+      }
+      return 1. / double(std::popcount(_available_cards()));
+   }
+   [[nodiscard]] constexpr int payoff(Player player) const
+   {
+      if(player == Player::chance) {
+         throw std::invalid_argument("Can't provide payoff for chance player.");
+      }
+      const auto& info = detail::sequence_table[m_sequence];
+      if(not info.is_terminal) {
+         return 0;
+      }
+      auto p = static_cast< size_t >(player);
+      if(info.folder != -1) {
+         auto folder = static_cast< size_t >(info.folder);
+         return p == folder ? -info.contributions[folder] : info.contributions[folder];
+      }
+      // the contributions are equal in a showdown
+      return card(player) > card(Player(1 - p)) ? info.contributions[p] : -info.contributions[p];
+   }
 
-   [[nodiscard]] auto active_player() const { return m_active_player; }
-   [[nodiscard]] auto card(Player player) const
+   [[nodiscard]] constexpr Player active_player() const
+   {
+      if(not _all_cards_engaged()) {
+         return Player::chance;
+      }
+      return Player(detail::sequence_length(m_sequence) % 2);
+   }
+   [[nodiscard]] constexpr std::optional< Card > card(Player player) const
+   {
+      auto rank = (m_cards >> _nibble(player)) & 0xFu;
+      if(rank == 0) {
+         return std::nullopt;
+      }
+      return Card(rank);
+   }
+   /// the decoded action history
+   [[nodiscard]] History history() const;
+   [[nodiscard]] constexpr size_t history_size() const
+   {
+      return detail::sequence_length(m_sequence);
+   }
+   [[nodiscard]] constexpr std::array< std::optional< Card >, 2 > cards() const
    {
-      return m_player_cards[static_cast< uint8_t >(player)];
+      return {card(Player::one), card(Player::two)};
    }
-   [[nodiscard]] auto& history() const { return m_history; }
-   [[nodiscard]] auto& cards() const { return m_player_cards; }
 
   private:
-   Player m_active_player = Player::chance;
-   std::array< std::optional< Card >, 2 > m_player_cards = {std::nullopt, std::nullopt};
-   History m_history{};
-   std::vector< Card > m_card_pool;
-
-   static const std::vector< History >& _all_terminal_histories();
-   [[nodiscard]] bool _all_cards_engaged() const;
-   bool _has_higher_card(Player player) const;
+   uint16_t m_card_pool = 0;
+   uint8_t m_cards = 0;
+   detail::SequenceCode m_sequence = detail::empty_sequence;
+
+   static constexpr unsigned _nibble(Player player) { return 4 * static_cast< unsigned >(player); }
+   [[nodiscard]] constexpr bool _all_cards_engaged() const
+   {
+      return (m_cards & 0xFu) and (m_cards >> 4);
+   }
+   [[nodiscard]] constexpr Player _player_to_deal() const
+   {
+      return (m_cards & 0xFu) ? Player::two : Player::one;
+   }
+   [[nodiscard]] constexpr uint16_t _available_cards() const
+   {
+      uint16_t available = m_card_pool;
+      for(auto player : {Player::one, Player::two}) {
+         if(auto player_card = card(player); player_card.has_value()) {
+            available &= uint16_t(~detail::card_bit(*player_card));
+         }
+      }
+      return available;
+   }
 };
 
 }  // namespace kuhn
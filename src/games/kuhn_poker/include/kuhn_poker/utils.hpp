@@ -5,6 +5,7 @@
 #include <string>
 
 #include "common/common.hpp"
+#include "general.hpp"
 #include "state.hpp"
 // #include ""
 
@@ -61,12 +62,19 @@ inline std::string to_string(const kuhn::ChanceOutcome &value)
    return std::string(kuhn::card_name_bij.at(value.card));
 }
 
+template <>
+inline std::string to_string(const kuhn::general::ChanceOutcome &value)
+{
+   return std::to_string(value.card);
+}
+
 }  // namespace common
 
 COMMON_ENABLE_PRINT(kuhn, Card);
 COMMON_ENABLE_PRINT(kuhn, Action);
 COMMON_ENABLE_PRINT(kuhn, Player);
 COMMON_ENABLE_PRINT(kuhn, ChanceOutcome);
+COMMON_ENABLE_PRINT(kuhn::general, ChanceOutcome);
 
 // // these operator<< definitions are specifically made for gtest which cannot handle the lookup in
 // // global namespace without throwing multiple template matching errors.
@@ -114,6 +122,17 @@ struct hash< kuhn::ChanceOutcome > {
       return std::hash< std::string >{}(ss.str());
    }
 };
+
+template <>
+struct hash< kuhn::general::ChanceOutcome > {
+   size_t operator()(const kuhn::general::ChanceOutcome &chance_outcome) const noexcept
+   {
+      size_t seed{0};
+      common::hash_combine(seed, std::hash< kuhn::Player >{}(chance_outcome.player));
+      common::hash_combine(seed, std::hash< kuhn::general::Card >{}(chance_outcome.card));
+      return seed;
+   }
+};
 }  // namespace std
 
 #endif  // NOR_KUHN_POKER_UTILS_HPP
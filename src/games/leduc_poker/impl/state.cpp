@@ -1,20 +1,20 @@
 
 #include "leduc_poker/state.hpp"
 
-#include <unordered_set>
+#include <cassert>
 
 namespace leduc {
 
 inline Player State::_cycle_active_player(bool folded, size_t shift_amount)
 {
+   auto begin = m_remaining_players.begin();
    if(folded) {
       // merely boot the front player from the game
-      m_remaining_players.pop_front();
+      std::copy(std::next(begin), begin + m_n_remaining, begin);
+      m_n_remaining -= 1;
    } else {
       // left rotate all entries (pop front and append to the back)
-      ranges::rotate(
-         m_remaining_players, std::next(m_remaining_players.begin(), long(shift_amount))
-      );
+      std::rotate(begin, std::next(begin, long(shift_amount)), begin + m_n_remaining);
    }
    return m_remaining_players.front();
 }
@@ -22,6 +22,8 @@ inline Player State::_cycle_active_player(bool folded, size_t shift_amount)
 void State::apply_action(Action action)
 {
    bool folded = false;
+   // encode first so that a bet size outside of the config throws before the state is changed
+   auto code = _encode(action);
    switch(action.action_type) {
       case ActionType::bet: {
          m_bets_this_round += 1;
@@ -48,16 +50,10 @@ void State::apply_action(Action action)
       }
    }
    // append the active player's action to the last action history
-   m_history.emplace_back(action);
-   m_history_since_last_bet[m_active_player] = std::move(action);
+   m_history[m_history_size++] = code;
+   m_history_since_last_bet[m_active_player] = action;
 
-   if(ranges::all_of(
-         ranges::views::enumerate(m_history_since_last_bet),
-         [&](const auto& player_opt) {
-            const auto& [player, opt] = player_opt;
-            return opt.has_value() or not ranges::contains(m_remaining_players, Player(player));
-         }
-      )) [[unlikely]] {
+   if(m_history_since_last_bet.all_acted(remaining_players())) [[unlikely]] {
       // everyone left in the game acted in this round and the round is over
       // --> on to the public card or the game is over anyway
       m_active_player = Player::chance;
@@ -75,8 +71,6 @@ void State::apply_action(Action action)
    } else [[likely]] {
       m_active_player = _cycle_active_player(folded);
    }
-   // since the state has changed we need to recompute whether the game has terminated
-   m_terminal_checked = false;
 }
 
 void State::_reset_order_of_play()
@@ -87,7 +81,7 @@ void State::_reset_order_of_play()
       std::numeric_limits< int >::max(), std::optional< Player >{std::nullopt}};
    auto min_neg_pair = std::pair{
       std::numeric_limits< int >::max(), std::optional< Player >{std::nullopt}};
-   for(Player player : m_remaining_players) {
+   for(Player player : remaining_players()) {
       int dist = static_cast< int >(player) - starting_player;
       auto& pair_to_update = (dist >= 0) ? min_pos_pair : min_neg_pair;
       if(dist < pair_to_update.first) {
@@ -96,8 +90,9 @@ void State::_reset_order_of_play()
    }
    Player player_to_go_next =
       ((min_pos_pair.second.has_value()) ? *min_pos_pair.second : *min_neg_pair.second);
+   auto remaining = remaining_players();
    auto cycle_table_by = std::distance(
-      m_remaining_players.begin(), ranges::find(m_remaining_players, player_to_go_next)
+      remaining.begin(), std::ranges::find(remaining, player_to_go_next)
    );
    _cycle_active_player(false, size_t(cycle_table_by));
 }
@@ -108,28 +103,17 @@ void State::apply_action(Card action)
       m_public_card = action;
       m_active_player = m_remaining_players.front();
    } else [[likely]] {
-      m_player_cards.emplace_back(action);
+      m_player_cards[m_n_cards_dealt++] = action;
       // we have to recheck here since we added a card to the player cards
       if(_all_player_cards_assigned()) {
          m_active_player = m_remaining_players.front();
       }
    }
-   m_terminal_checked = false;
-}
-
-bool State::is_terminal()
-{
-   if(m_terminal_checked) {
-      return m_is_terminal;
-   }
-   m_is_terminal = std::as_const(*this).is_terminal();
-   m_terminal_checked = true;
-   return m_is_terminal;
 }
 
 bool State::is_terminal() const
 {
-   if(m_remaining_players.size() == 1) {
+   if(m_n_remaining == 1) {
       return true;
    }
    if(not (round_nr() == 1)) {
@@ -146,28 +130,32 @@ bool State::is_terminal() const
    return false;
 }
 
-void State::_single_pot_winner(std::vector< double >& payoffs, Player player) const
+void State::_single_pot_winner(std::span< double > payoffs, Player player) const
 {
    // the chosen player is the winnign player so all the pot goes to him, the payoff is everyone
    // else's bet in the game minus one's own contributions
-   payoffs[as_int(player)] = ranges::accumulate(m_stakes, 0.) - stake(player);
+   payoffs[as_int(player)] = std::accumulate(m_stakes.begin(), m_stakes.end(), 0.) - stake(player);
 }
 
-std::vector< double > State::payoff()
+void State::payoff(std::span< double > payoffs) const
 {
+   const auto n_players = config().n_players;
+   if(payoffs.size() < n_players) {
+      throw std::invalid_argument(
+         "The payoff storage holds " + std::to_string(payoffs.size()) + " values, but "
+         + std::to_string(n_players) + " are needed."
+      );
+   }
    if(not is_terminal()) {
-      return std::vector(config().n_players, 0.);
+      std::fill_n(payoffs.begin(), n_players, 0.);
+      return;
    }
    // initiate payoffs first as negative stakes for each player
-   std::vector< double > payoffs;
-   payoffs.reserve(m_stakes.size());
-   ranges::insert(
-      payoffs, payoffs.begin(), m_stakes | ranges::views::transform([](const auto& value) {
-                                   return -value;
-                                })
-   );
+   for(size_t p = 0; p < n_players; p++) {
+      payoffs[p] = -m_stakes[p];
+   }
 
-   if(auto n_remaining = m_remaining_players.size(); n_remaining == 1) {
+   if(m_n_remaining == 1) {
       _single_pot_winner(payoffs, m_remaining_players[0]);
    } else {
       assert(m_public_card.has_value());
@@ -176,42 +164,92 @@ std::vector< double > State::payoff()
       Card pub_card = *m_public_card;
       // there is a showdown between 2 or more players. We thus need to see who has the pair, if
       // any, or otherwise who has the highest card
-      std::vector< Player > winners;
-      for(auto p : m_remaining_players) {
+      std::array< Player, max_players > winners{};
+      size_t n_winners = 0;
+      for(auto p : remaining_players()) {
          if(card(p).rank == pub_card.rank) {
-            winners.emplace_back(p);
+            winners[n_winners++] = p;
          }
       }
-      if(winners.empty()) {
+      if(n_winners == 0) {
          // no player has a pair --> next critera: who has the highest card?
-         _determine_highest_card_winner(winners);
+         n_winners = _determine_highest_card_winner(winners);
       }
 
-      if(winners.size() == 1) {
+      if(n_winners == 1) {
          // a single winnner takes home the whole pot
          _single_pot_winner(payoffs, winners[0]);
       } else {
          // more than one winner --> split pot
-         _split_pot(payoffs, winners);
+         _split_pot(payoffs, std::span{winners}.first(n_winners));
       }
    }
-   return payoffs;
 }
-void State::_determine_highest_card_winner(std::vector< Player >& winners) const
+
+size_t State::_determine_highest_card_winner(std::span< Player > winners) const
 {
-   auto rem_player_begin = m_remaining_players.begin();
-   winners.emplace_back(*rem_player_begin);
-   Rank highest_rank = card(*rem_player_begin).rank;
-   for(auto rem_player : ranges::subrange{rem_player_begin + 1, m_remaining_players.end()}) {
+   auto remaining = remaining_players();
+   size_t n_winners = 0;
+   winners[n_winners++] = remaining[0];
+   Rank highest_rank = card(remaining[0]).rank;
+   for(auto rem_player : remaining.subspan(1)) {
       auto curr_rank = card(rem_player).rank;
       if(curr_rank > highest_rank) {
-         winners.clear();
-         winners.emplace_back(rem_player);
+         n_winners = 0;
+         winners[n_winners++] = rem_player;
          highest_rank = curr_rank;
       } else if(curr_rank == highest_rank) {
-         winners.emplace_back(rem_player);
+         winners[n_winners++] = rem_player;
       }
    }
+   return n_winners;
+}
+
+std::optional< size_t > State::_bet_size_index(double bet) const
+{
+   auto sizes = bet_sizes(round_nr());
+   auto size_pos = std::ranges::find_if(sizes, [&](double size) {
+      return Action{ActionType::bet, bet} == Action{ActionType::bet, size};
+   });
+   if(size_pos == sizes.end()) {
+      return std::nullopt;
+   }
+   return size_t(std::distance(sizes.begin(), size_pos));
+}
+
+uint8_t State::_encode(const Action& action) const
+{
+   if(action.action_type != ActionType::bet) {
+      return static_cast< uint8_t >(action.action_type);
+   }
+   auto size_index = _bet_size_index(action.bet);
+   if(not size_index.has_value()) {
+      throw std::invalid_argument(
+         "Bet size " + std::to_string(action.bet) + " is not offered in round "
+         + std::to_string(round_nr()) + "."
+      );
+   }
+   auto index = round_nr() * config().bet_sizes_shapes[0] + *size_index;
+   return static_cast< uint8_t >(static_cast< size_t >(ActionType::bet) | (index << 2));
+}
+
+Action State::_decode(uint8_t code) const
+{
+   auto action_type = ActionType(code & 0b11);
+   if(action_type != ActionType::bet) {
+      return Action{action_type};
+   }
+   return Action{action_type, config().bet_sizes[code >> 2]};
+}
+
+std::vector< Action > State::history() const
+{
+   std::vector< Action > history;
+   history.reserve(m_history_size);
+   for(auto code : std::span{m_history}.first(m_history_size)) {
+      history.emplace_back(_decode(code));
+   }
+   return history;
 }
 
 bool State::is_valid(Action action) const
@@ -220,8 +258,8 @@ bool State::is_valid(Action action) const
       return false;
    }
    if(action.action_type == ActionType::bet) {
-      return (m_bets_this_round < m_config.n_raises_allowed)
-             and ranges::contains(bet_sizes(round_nr()), action.bet);
+      return (m_bets_this_round < config().n_raises_allowed)
+             and _bet_size_index(action.bet).has_value();
    }
    return true;
 }
@@ -241,7 +279,7 @@ bool State::is_valid(Card outcome) const
 }
 bool State::_all_player_cards_assigned() const
 {
-   return m_player_cards.size() == m_config.n_players;
+   return m_n_cards_dealt == config().n_players;
 }
 
 std::vector< Card > State::chance_actions() const
@@ -249,9 +287,14 @@ std::vector< Card > State::chance_actions() const
    if(_all_player_cards_assigned() and m_public_card.has_value()) {
       return {};
    }
-   return ranges::to_vector(ranges::views::filter(m_config.available_cards, [&](const auto& card) {
-      return not ranges::contains(m_player_cards, card);
-   }));
+   std::vector< Card > outcomes;
+   outcomes.reserve(config().available_cards.size() - m_n_cards_dealt);
+   for(const auto& card : config().available_cards) {
+      if(std::ranges::find(cards(), card) == cards().end()) {
+         outcomes.emplace_back(card);
+      }
+   }
+   return outcomes;
 }
 
 std::vector< Action > State::actions() const
@@ -260,7 +303,7 @@ std::vector< Action > State::actions() const
       return {};
    }
    std::vector< Action > all_actions{{ActionType::check}, {ActionType::fold}};
-   if(m_config.n_raises_allowed > m_bets_this_round) {
+   if(config().n_raises_allowed > m_bets_this_round) {
       auto all_bets = bet_sizes(round_nr());
       all_actions.reserve(2 + all_bets.size());
       for(auto bet_amount : all_bets) {
@@ -275,23 +318,19 @@ double State::chance_probability(Card) const
    return 1. / double(chance_actions().size());
 }
 
-State::State(LeducConfig config)
-    : m_remaining_players(),
-      m_player_cards(),
-      m_stakes(config.n_players, config.blind),  // everyone places at least the small blind
-      m_history_since_last_bet(config.n_players),
-      m_config(std::move(config))
+State::State(sptr< const LeducConfig > config)
+    : m_config(std::move(config)), m_history_since_last_bet(m_config->n_players)
 {
-   size_t nr_players = m_config.n_players;
-   m_player_cards.reserve(nr_players);
-   size_t start = static_cast< size_t >(m_config.starting_player);
+   size_t nr_players = m_config->n_players;
+   // everyone places at least the small blind
+   std::fill_n(m_stakes.begin(), nr_players, m_config->blind);
+   size_t start = static_cast< size_t >(m_config->starting_player);
    // emplace the players into the order queue from the starting player onwards, i.e.
    // (starter, starter + 1, starter + 2, ..., nr_players, 0, 1, ..., starter - 1)
-   for(size_t p : ranges::views::concat(
-          ranges::views::iota(start, nr_players), ranges::views::iota(size_t(0), start)
-       )) {
-      m_remaining_players.emplace_back(Player(p));
+   for(size_t i = 0; i < nr_players; i++) {
+      m_remaining_players[i] = Player((start + i) % nr_players);
    }
+   m_n_remaining = static_cast< uint8_t >(nr_players);
 }
 
 }  // namespace leduc
@@ -2,11 +2,18 @@
 #ifndef NOR_LEDUC_POKER_STATE_HPP
 #define NOR_LEDUC_POKER_STATE_HPP
 
+#include <algorithm>
 #include <array>
-#include <deque>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <numeric>
 #include <optional>
 #include <range/v3/all.hpp>
+#include <span>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "common/common.hpp"
@@ -27,6 +34,15 @@ enum class Player {
    ten = 9
 };
 
+/// the most players a game can seat, which bounds the inline storage of the state
+inline constexpr size_t max_players = 10;
+/// the most bets (and raises) per betting round that a config may allow
+inline constexpr size_t max_raises = 8;
+/// the most bet sizes (summed over both rounds) that a config may offer
+inline constexpr size_t max_bet_sizes = 64;
+/// every betting round takes at most one action per player before and after each bet
+inline constexpr size_t max_history_length = 2 * (max_raises + 1) * max_players;
+
 template < std::integral To = size_t, typename T >
 inline To as_int(T p)
 {
@@ -34,7 +50,7 @@ inline To as_int(T p)
    return static_cast< To >(p);
 };
 
-enum class Rank {
+enum class Rank : uint8_t {
    two = 2,
    three = 3,
    four = 4,
@@ -50,7 +66,7 @@ enum class Rank {
    ace = 14
 };
 
-enum class Suit { clubs = 0, diamonds = 1, hearts = 2, spades = 3 };
+enum class Suit : uint8_t { clubs = 0, diamonds = 1, hearts = 2, spades = 3 };
 
 struct Card {
    Rank rank;
@@ -62,7 +78,7 @@ inline bool operator==(const Card& card1, const Card& card2)
    return card1.rank == card2.rank and card1.suit == card2.suit;
 }
 
-enum class ActionType {
+enum class ActionType : uint8_t {
    check = 0,  // check also acts as a call upon betting
    fold = 1,
    bet = 2
@@ -84,8 +100,8 @@ inline bool operator==(const Action& action1, const Action& action2)
 class LeducConfig {
   public:
    template <
-      ranges::sized_range Rng1 = std::initializer_list< double >,
-      ranges::sized_range Rng2 = std::initializer_list< double > >
+      std::ranges::sized_range Rng1 = std::initializer_list< double >,
+      std::ranges::sized_range Rng2 = std::initializer_list< double > >
    LeducConfig(
       size_t n_players_ = 2,
       Player starting_player_ = Player::one,
@@ -105,12 +121,30 @@ class LeducConfig {
          starting_player(starting_player_),
          n_raises_allowed(n_raises_allowed_),
          blind(blind_),
-         bet_sizes(ranges::to< std::vector< double > >(
-            ranges::views::concat(bet_sizes_round_one_, bet_sizes_round_two_)
-         )),
+         bet_sizes(
+            std::ranges::begin(bet_sizes_round_one_),
+            std::ranges::end(bet_sizes_round_one_)
+         ),
          bet_sizes_shapes({bet_sizes_round_one_.size(), bet_sizes_round_two_.size()}),
          available_cards(std::move(available_cards_))
    {
+      bet_sizes.insert(
+         bet_sizes.end(),
+         std::ranges::begin(bet_sizes_round_two_),
+         std::ranges::end(bet_sizes_round_two_)
+      );
+      if(n_players > max_players) {
+         throw std::invalid_argument(
+            "At most " + std::to_string(max_players) + " players are supported, but "
+            + std::to_string(n_players) + " were requested."
+         );
+      }
+      if(n_raises_allowed > max_raises or bet_sizes.size() > max_bet_sizes) {
+         throw std::invalid_argument(
+            "At most " + std::to_string(max_raises) + " raises per round and "
+            + std::to_string(max_bet_sizes) + " bet sizes in total are supported."
+         );
+      }
       if(available_cards.size() <= n_players) {
          throw std::invalid_argument(
             "There are too few cards available (" + std::to_string(available_cards.size())
@@ -118,7 +152,7 @@ class LeducConfig {
             + "At least #players + 1 (flop) many are needed."
          );
       }
-      available_cards_.shrink_to_fit();
+      available_cards.shrink_to_fit();
       bet_sizes.shrink_to_fit();
    }
 
@@ -166,58 +200,70 @@ class LeducConfig {
  */
 class HistorySinceBet {
   public:
-   HistorySinceBet(size_t n_players) : m_container(n_players, std::nullopt) {}
-   HistorySinceBet(std::vector< std::optional< Action > > cont) : m_container(std::move(cont)) {}
+   HistorySinceBet(size_t n_players) : m_n_players(n_players) {}
 
    auto& operator[](Player player) { return m_container[as_int(player)]; }
 
    auto& operator[](Player player) const { return m_container[as_int(player)]; }
 
-   auto& at(Player player) { return m_container.at(as_int(player)); }
+   auto& at(Player player) { return container()[_checked(player)]; }
 
-   auto& at(Player player) const { return m_container.at(as_int(player)); }
+   auto& at(Player player) const { return container()[_checked(player)]; }
 
-   void reset()
-   {
-      ranges::for_each(m_container, [](auto& action_opt) { action_opt.reset(); });
-   }
+   void reset() { m_container.fill(std::nullopt); }
 
-   inline bool all_acted(const std::vector< Player >& remaining_players)
+   inline bool all_acted(std::span< const Player > remaining_players) const
    {
-      return ranges::all_of(remaining_players, [&](Player player) {
+      return std::ranges::all_of(remaining_players, [&](Player player) {
          return m_container[as_int(player)].has_value();
       });
    }
 
-   auto begin() const { return m_container.begin(); }
-   auto begin() { return m_container.begin(); }
-   auto end() const { return m_container.end(); }
-   auto end() { return m_container.end(); }
+   auto begin() const { return container().begin(); }
+   auto begin() { return container().begin(); }
+   auto end() const { return container().end(); }
+   auto end() { return container().end(); }
 
-   auto& container() { return m_container; }
-   [[nodiscard]] auto& container() const { return m_container; }
+   std::span< std::optional< Action > > container()
+   {
+      return std::span{m_container}.first(m_n_players);
+   }
+   [[nodiscard]] std::span< const std::optional< Action > > container() const
+   {
+      return std::span{m_container}.first(m_n_players);
+   }
 
   private:
-   std::vector< std::optional< Action > > m_container{};
+   std::array< std::optional< Action >, max_players > m_container{};
+   size_t m_n_players;
+
+   [[nodiscard]] size_t _checked(Player player) const
+   {
+      if(as_int(player) >= m_n_players) {
+         throw std::out_of_range("Player index out of range of the history.");
+      }
+      return as_int(player);
+   }
 };
 
 inline bool operator==(const HistorySinceBet& left, const HistorySinceBet& right)
 {
-   if(left.container().size() != right.container().size()) {
-      return false;
-   }
-   return ranges::all_of(
-      ranges::views::zip(left.container(), right.container()),
-      [](const auto& paired_actions) {
-         const auto& [left_action, right_action] = paired_actions;
-         return left_action == right_action;
-      }
-   );
+   return std::ranges::equal(left.container(), right.container());
 }
 
+/**
+ * @brief The world state of a Leduc poker game.
+ *
+ * All members are stored inline with capacities bounded by `max_players`, and the config is shared
+ * through a pointer, so that copying the state (as the solvers do at every node) is a flat memcpy
+ * and a reference count increment. The action history is stored as one byte per action.
+ */
 class State {
   public:
-   State(LeducConfig config = {});
+   State(sptr< const LeducConfig > config);
+   State(LeducConfig config = {}) : State(std::make_shared< const LeducConfig >(std::move(config)))
+   {
+   }
 
    template < typename... Args >
    auto apply_action(Args... args)
@@ -226,10 +272,21 @@ class State {
    }
    void apply_action(Action action);
    void apply_action(Card action);
-   bool is_terminal();
-   bool is_terminal() const;
-   std::vector< double > payoff();
-   inline double payoff(Player player) { return payoff()[as_int(player)]; }
+   [[nodiscard]] bool is_terminal() const;
+   /// writes the payoff of every player into the first `n_players` entries of `payoffs`
+   void payoff(std::span< double > payoffs) const;
+   [[nodiscard]] std::vector< double > payoff() const
+   {
+      std::vector< double > payoffs(config().n_players, 0.);
+      payoff(payoffs);
+      return payoffs;
+   }
+   [[nodiscard]] double payoff(Player player) const
+   {
+      std::array< double, max_players > payoffs{};
+      payoff(payoffs);
+      return payoffs[as_int(player)];
+   }
 
    template < typename... Args >
    [[nodiscard]] auto is_valid(Args... args) const
@@ -244,10 +301,16 @@ class State {
    [[nodiscard]] double stake(Player player) const { return m_stakes[as_int(player)]; }
 
    [[nodiscard]] auto active_player() const { return m_active_player; }
-   [[nodiscard]] auto remaining_players() const { return m_remaining_players; }
+   /// the players still in the game in their order of play (the active player first)
+   [[nodiscard]] std::span< const Player > remaining_players() const
+   {
+      return std::span{m_remaining_players}.first(m_n_remaining);
+   }
    [[nodiscard]] auto card(Player player) const { return m_player_cards[as_int(player)]; }
    [[nodiscard]] auto public_card() const { return m_public_card; }
-   [[nodiscard]] auto& history() const { return m_history; }
+   /// the decoded action history (allocates, the state only stores the compact encoding)
+   [[nodiscard]] std::vector< Action > history() const;
+   [[nodiscard]] size_t history_size() const { return m_history_size; }
    [[nodiscard]] auto& history_since_bet() const { return m_history_since_last_bet; }
    template < typename IntType >
    [[nodiscard]] auto& history_since_bet(IntType player) const
@@ -255,18 +318,19 @@ class State {
       return m_history_since_last_bet[Player(player)];
    }
    [[nodiscard]] size_t round_nr() const { return m_public_card.has_value(); }
-   [[nodiscard]] auto& cards() const { return m_player_cards; }
-   [[nodiscard]] const auto& config() const { return m_config; }
+   [[nodiscard]] std::span< const Card > cards() const
+   {
+      return std::span{m_player_cards}.first(m_n_cards_dealt);
+   }
+   [[nodiscard]] const LeducConfig& config() const { return *m_config; }
+   [[nodiscard]] const auto& config_ptr() const { return m_config; }
    [[nodiscard]] auto initial_players() const
    {
       std::vector< Player > players;
       players.reserve(config().n_players);
-      ranges::insert(
-         players,
-         players.begin(),
-         ranges::views::iota(0UL, config().n_players)
-            | ranges::views::transform([](int p) { return Player(p); })
-      );
+      for(size_t p = 0; p < config().n_players; p++) {
+         players.emplace_back(Player(p));
+      }
       return players;
    }
    [[nodiscard]] std::span< const double > bet_sizes(bool round_two) const
@@ -280,30 +344,33 @@ class State {
    }
 
   private:
-   Player m_active_player = Player::chance;
-   std::deque< Player > m_remaining_players;
-   std::vector< Card > m_player_cards;
-   std::vector< double > m_stakes;
+   sptr< const LeducConfig > m_config;
+   std::array< double, max_players > m_stakes{};
+   HistorySinceBet m_history_since_last_bet;
+   std::array< Player, max_players > m_remaining_players{};
+   std::array< Card, max_players > m_player_cards{};
    std::optional< Card > m_public_card = std::nullopt;
    std::optional< Player > m_active_bettor = std::nullopt;
-   unsigned int m_bets_this_round = 0;
-   HistorySinceBet m_history_since_last_bet;
-   std::vector< Action > m_history{};
-   bool m_is_terminal = false;
-   bool m_terminal_checked = false;
-   const LeducConfig m_config;
+   Player m_active_player = Player::chance;
+   uint8_t m_n_remaining = 0;
+   uint8_t m_n_cards_dealt = 0;
+   uint8_t m_bets_this_round = 0;
+   uint8_t m_history_size = 0;
+   /// every action as its type in the lowest 2 bits and, for bets, the index of its size in
+   /// `config().bet_sizes` in the upper 6 bits
+   std::array< uint8_t, max_history_length > m_history{};
 
-   static const std::vector< HistorySinceBet >& _all_terminal_histories();
    [[nodiscard]] bool _all_player_cards_assigned() const;
-   [[nodiscard]] bool _has_higher_card(Player player) const;
    Player _cycle_active_player(bool folded, size_t shift_amount = 1);
-   void _single_pot_winner(std::vector< double >& payoffs, Player player) const;
+   void _single_pot_winner(std::span< double > payoffs, Player player) const;
+   /// the position of the bet's size among this round's bet sizes (compared as by `Action::==`)
+   [[nodiscard]] std::optional< size_t > _bet_size_index(double bet) const;
+   [[nodiscard]] uint8_t _encode(const Action& action) const;
+   [[nodiscard]] Action _decode(uint8_t code) const;
 
    double& _stake(Player player) { return m_stakes[as_int(player)]; }
 
-   template < ranges::sized_range Range >
-      requires std::is_same_v< ranges::value_type_t< Range >, Player >
-   void _split_pot(std::vector< double >& payoffs, const Range& winners) const
+   void _split_pot(std::span< double > payoffs, std::span< const Player > winners) const
    {
       double pot = std::accumulate(m_stakes.begin(), m_stakes.end(), 0.);
       double n_winners = static_cast< double >(winners.size());
@@ -311,7 +378,7 @@ class State {
          payoffs[as_int(p)] += pot / n_winners;
       };
    }
-   void _determine_highest_card_winner(std::vector< Player >& winners) const;
+   [[nodiscard]] size_t _determine_highest_card_winner(std::span< Player > winners) const;
    void _reset_order_of_play();
 };
 
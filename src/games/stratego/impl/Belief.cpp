@@ -0,0 +1,433 @@
+#include "stratego/Belief.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <map>
+#include <random>
+#include <span>
+#include <stdexcept>
+
+namespace stratego::detail {
+
+/**
+ * @brief Draws deals of token counts onto pieces with candidate tokens uniformly.
+ *
+ * Pieces with the same candidates form a class, and tokens that are candidates of the same classes
+ * form a group, since the constraints cannot tell them apart. The number of deals of the classes
+ * from the k-th on then only depends on k and the tokens left in each group. Each class draws how
+ * many of its pieces every group serves in proportion to the deals that remain, after which the
+ * pieces of a class and the tokens of a group are matched by shuffling.
+ *
+ * All deal counts are computed on construction, so that drawing only looks them up and a sampler
+ * can be shared by concurrent draws.
+ */
+class DealSampler {
+  public:
+   using token_set = BeliefTracker::token_set;
+
+   DealSampler(
+      std::span< const token_set > candidates,
+      const std::array< unsigned int, n_tokens > &counts
+   )
+   {
+      token_set available = 0;
+      unsigned int n_instances = 0;
+      for(size_t slot = 0; slot < n_tokens; slot++) {
+         if(counts[slot] > 0) {
+            available |= BeliefTracker::bit(Token(slot));
+            n_instances += counts[slot];
+         }
+      }
+      m_n_pieces = candidates.size();
+      m_consistent = n_instances == m_n_pieces;
+      std::map< token_set, std::vector< size_t > > pieces_of;
+      for(size_t piece = 0; piece < candidates.size(); piece++) {
+         pieces_of[candidates[piece] & available].emplace_back(piece);
+      }
+      for(auto &[piece_candidates, pieces] : pieces_of) {
+         m_classes.emplace_back(PieceClass{piece_candidates, std::move(pieces), {}});
+      }
+      // the tightest classes come first, which leaves the larger ones few choices
+      std::ranges::stable_sort(m_classes, {}, [](const PieceClass &piece_class) {
+         return std::popcount(piece_class.candidates);
+      });
+      std::map< std::vector< bool >, size_t > group_of;
+      for(size_t slot = 0; slot < n_tokens; slot++) {
+         if(counts[slot] == 0) {
+            continue;
+         }
+         std::vector< bool > pattern;
+         for(const auto &piece_class : m_classes) {
+            pattern.emplace_back((piece_class.candidates >> slot) & 1u);
+         }
+         auto [iter, inserted] = group_of.try_emplace(std::move(pattern), m_group_tokens.size());
+         if(inserted) {
+            m_group_tokens.emplace_back();
+            m_group_sizes.emplace_back(0);
+         }
+         m_group_tokens[iter->second].insert(
+            m_group_tokens[iter->second].end(), counts[slot], Token(slot)
+         );
+         m_group_sizes[iter->second] += counts[slot];
+      }
+      for(auto &piece_class : m_classes) {
+         for(size_t group = 0; group < m_group_tokens.size(); group++) {
+            auto slot = size_t(m_group_tokens[group].front());
+            if((piece_class.candidates >> slot) & 1u) {
+               piece_class.groups.emplace_back(group);
+            }
+         }
+      }
+      m_memo.resize(m_classes.size());
+      m_binomials.resize(n_instances + 1);
+      for(size_t n = 0; n <= n_instances; n++) {
+         m_binomials[n].resize(n + 1, 1.);
+         for(size_t k = 1; k < n; k++) {
+            m_binomials[n][k] = m_binomials[n - 1][k - 1] + m_binomials[n - 1][k];
+         }
+      }
+      m_feasible = m_consistent and _count_deals(0, m_group_sizes) > 0.;
+   }
+
+   /// the token of every piece, or none if no deal respects the candidates
+   std::optional< std::vector< Token > > sample(common::RNG &rng) const
+   {
+      if(not m_feasible) {
+         return std::nullopt;
+      }
+      auto left = m_group_sizes;
+      std::vector< std::vector< size_t > > pieces_of_group(m_group_tokens.size());
+      for(size_t c = 0; c < m_classes.size(); c++) {
+         auto draw = std::uniform_real_distribution< double >{0., _n_deals(c, left)}(rng);
+         group_counts chosen;
+         _for_each_split(c, left, [&](const group_counts &taken, double weight) {
+            auto n_deals = weight * _n_deals(c + 1, _minus(left, taken));
+            if(n_deals > 0. and (chosen.empty() or draw >= 0.)) {
+               // the last split with deals absorbs the rounding errors of the draw
+               chosen = taken;
+            }
+            draw -= n_deals;
+         });
+         auto pieces = m_classes[c].pieces;
+         std::ranges::shuffle(pieces, rng);
+         auto piece = pieces.begin();
+         for(size_t group = 0; group < chosen.size(); group++) {
+            auto end = piece + chosen[group];
+            pieces_of_group[group].insert(pieces_of_group[group].end(), piece, end);
+            piece = end;
+         }
+         left = _minus(left, chosen);
+      }
+      std::vector< Token > tokens(m_n_pieces);
+      for(size_t group = 0; group < m_group_tokens.size(); group++) {
+         auto group_tokens = m_group_tokens[group];
+         std::ranges::shuffle(group_tokens, rng);
+         for(size_t i = 0; i < group_tokens.size(); i++) {
+            tokens[pieces_of_group[group][i]] = group_tokens[i];
+         }
+      }
+      return tokens;
+   }
+
+  private:
+   using group_counts = std::vector< unsigned int >;
+
+   struct PieceClass {
+      token_set candidates;
+      std::vector< size_t > pieces;
+      /// the groups whose tokens are candidates of the class
+      std::vector< size_t > groups;
+   };
+
+   size_t m_n_pieces;
+   /// whether there are as many tokens to deal as pieces
+   bool m_consistent;
+   /// whether any deal respects the candidates
+   bool m_feasible = false;
+   std::vector< PieceClass > m_classes;
+   /// the tokens of each group (once per instance) and their number
+   std::vector< std::vector< Token > > m_group_tokens;
+   group_counts m_group_sizes;
+   /// the number of deals of the classes from the k-th on for the tokens left in each group
+   std::vector< std::map< group_counts, double > > m_memo;
+   std::vector< std::vector< double > > m_binomials;
+
+   static group_counts _minus(group_counts left, const group_counts &taken)
+   {
+      for(size_t group = 0; group < left.size(); group++) {
+         left[group] -= taken[group];
+      }
+      return left;
+   }
+
+   /**
+    * Calls `visit(taken, weight)` for every way of the class to take its pieces' tokens from the
+    * groups that are left. The weight counts the ways to pick the tokens of each group, up to a
+    * factor that only depends on the class (which thus cancels out of the draws).
+    */
+   template < typename Visitor >
+   void _for_each_split(size_t c, const group_counts &left, Visitor &&visit) const
+   {
+      const auto &groups = m_classes[c].groups;
+      if(groups.empty()) {
+         return;
+      }
+      group_counts taken(left.size(), 0);
+      auto recurse = [&](auto &self, size_t k, unsigned int rest, double weight) -> void {
+         auto group = groups[k];
+         if(k + 1 == groups.size()) {
+            if(rest <= left[group]) {
+               taken[group] = rest;
+               visit(taken, weight * m_binomials[left[group]][rest]);
+            }
+         } else {
+            for(unsigned int n = 0; n <= std::min(rest, left[group]); n++) {
+               taken[group] = n;
+               self(self, k + 1, rest - n, weight * m_binomials[left[group]][n]);
+            }
+         }
+         taken[group] = 0;
+      };
+      recurse(recurse, 0, static_cast< unsigned int >(m_classes[c].pieces.size()), 1.);
+   }
+
+   /// the memoized deal count, which the construction computed for every reachable state
+   [[nodiscard]] double _n_deals(size_t c, const group_counts &left) const
+   {
+      if(c == m_classes.size()) {
+         return std::ranges::all_of(left, [](auto n) { return n == 0; }) ? 1. : 0.;
+      }
+      auto iter = m_memo[c].find(left);
+      return iter != m_memo[c].end() ? iter->second : 0.;
+   }
+
+   double _count_deals(size_t c, const group_counts &left)
+   {
+      if(c == m_classes.size()) {
+         return _n_deals(c, left);
+      }
+      if(auto iter = m_memo[c].find(left); iter != m_memo[c].end()) {
+         return iter->second;
+      }
+      double n_deals = 0.;
+      _for_each_split(c, left, [&](const group_counts &taken, double weight) {
+         n_deals += weight * _count_deals(c + 1, _minus(left, taken));
+      });
+      m_memo[c].emplace(left, n_deals);
+      return n_deals;
+   }
+};
+
+}  // namespace stratego::detail
+
+namespace stratego {
+
+BeliefTracker::BeliefTracker(const State &state, Team observer)
+    : m_observer(observer),
+      m_config(state.config_ptr()),
+      m_piece_at(m_config->game_dims()[0] * m_config->game_dims()[1], -1)
+{
+   auto opponent = observer == Team::BLUE ? Team::RED : Team::BLUE;
+   // the beliefs start from the board before the first recorded move
+   State start = state;
+   start.undo_last_rounds(state.history().size());
+
+   const auto &graveyard = start.graveyard();
+   for(const auto &[token, count] : m_config->token_counters().at(opponent)) {
+      unsigned int dead = 0;
+      if(auto team_iter = graveyard.find(opponent); team_iter != graveyard.end()) {
+         if(auto iter = team_iter->second.find(token); iter != team_iter->second.end()) {
+            dead = iter->second;
+         }
+      }
+      m_alive[static_cast< size_t >(token)] = count - std::min(count, dead);
+   }
+   token_set alive_tokens = 0;
+   for(size_t slot = 0; slot < n_tokens; slot++) {
+      if(m_alive[slot] > 0) {
+         alive_tokens |= bit(Token(slot));
+      }
+   }
+   for(const auto &piece_opt : start.board()) {
+      if(piece_opt.has_value() and piece_opt->team() == opponent) {
+         m_piece_at[_index(piece_opt->position())] = int(m_candidates.size());
+         m_positions.emplace_back(piece_opt->position());
+         m_candidates.emplace_back(
+            piece_opt->flag_hidden() ? alive_tokens : bit(piece_opt->token())
+         );
+      }
+   }
+   m_alive_pieces.reserve(m_candidates.size());
+   _propagate();
+   update(state);
+}
+
+void BeliefTracker::update(const State &state)
+{
+   const auto &records = state.history().records();
+   if(records.size() < m_n_records
+      or (m_last_record.has_value() and records[m_n_records - 1] != *m_last_record)) {
+      *this = BeliefTracker(state, m_observer);
+      return;
+   }
+   if(records.size() == m_n_records) {
+      if(m_sampler == nullptr) {
+         _prepare_deals(state);
+      }
+      return;
+   }
+   for(size_t i = m_n_records; i < records.size(); i++) {
+      _apply(records[i]);
+   }
+   m_n_records = records.size();
+   m_last_record = records.back();
+   _propagate();
+   _prepare_deals(state);
+}
+
+std::optional< BeliefTracker::token_set > BeliefTracker::candidates(const Position2D &pos) const
+{
+   auto piece = m_piece_at[_index(pos)];
+   if(piece < 0) {
+      return std::nullopt;
+   }
+   return m_candidates[size_t(piece)];
+}
+
+void BeliefTracker::_kill(size_t piece, Token token)
+{
+   auto &alive = m_alive[static_cast< size_t >(token)];
+   alive -= std::min(alive, 1u);
+   m_candidates[piece] = 0;
+   m_piece_at[_index(m_positions[piece])] = -1;
+}
+
+void BeliefTracker::_apply(const MoveRecord &record)
+{
+   const auto &move = record.action.move();
+   auto from = _index(move[0]);
+   auto to = _index(move[1]);
+   if(record.team != m_observer) {
+      if(m_piece_at[from] < 0) {
+         throw std::logic_error("The move does not start on a tracked piece.");
+      }
+      auto piece = size_t(m_piece_at[from]);
+      // the piece is neither immovable nor short of the distance it moved
+      auto distance = size_t(
+         std::abs(move[0][0] - move[1][0]) + std::abs(move[0][1] - move[1][1])
+      );
+      token_set movable = 0;
+      for(size_t slot = 0; slot < n_tokens; slot++) {
+         if(m_config->in_move_range(Token(slot), distance)) {
+            movable |= bit(Token(slot));
+         }
+      }
+      m_candidates[piece] &= movable;
+      if(record.defender.has_value()) {
+         _reveal(piece, record.attacker.token());
+      }
+      auto outcome = record.fight_outcome.value_or(FightOutcome::kill);
+      if(outcome == FightOutcome::kill) {
+         m_piece_at[from] = -1;
+         m_piece_at[to] = int(piece);
+         m_positions[piece] = move[1];
+      } else {
+         _kill(piece, record.attacker.token());
+      }
+   } else if(record.defender.has_value()) {
+      if(m_piece_at[to] < 0) {
+         throw std::logic_error("The attacked piece is not tracked.");
+      }
+      auto piece = size_t(m_piece_at[to]);
+      _reveal(piece, record.defender->token());
+      if(*record.fight_outcome != FightOutcome::death) {
+         _kill(piece, record.defender->token());
+      }
+   }
+}
+
+void BeliefTracker::_propagate()
+{
+   bool changed = true;
+   while(changed) {
+      changed = false;
+      std::array< unsigned int, n_tokens > known{};
+      std::array< unsigned int, n_tokens > possible{};
+      for(auto candidates : m_candidates) {
+         if(std::has_single_bit(candidates)) {
+            known[size_t(std::countr_zero(candidates))]++;
+         }
+         for(size_t slot = 0; slot < n_tokens; slot++) {
+            possible[slot] += (candidates >> slot) & 1u;
+         }
+      }
+      for(size_t slot = 0; slot < n_tokens; slot++) {
+         auto token_bit = bit(Token(slot));
+         if(possible[slot] < m_alive[slot]) {
+            throw std::logic_error("The observed moves contradict the token counts.");
+         }
+         for(auto &candidates : m_candidates) {
+            if(not (candidates & token_bit) or candidates == token_bit) {
+               continue;
+            }
+            if(known[slot] == m_alive[slot]) {
+               // all alive pieces of the token are known, so no other piece can be one
+               candidates &= static_cast< token_set >(~token_bit);
+               changed = true;
+            } else if(possible[slot] == m_alive[slot]) {
+               // every piece that can be of the token has to be one
+               candidates = token_bit;
+               changed = true;
+            }
+         }
+         if(changed) {
+            // the counts are stale now
+            break;
+         }
+      }
+   }
+   m_alive_pieces.clear();
+   for(size_t piece = 0; piece < m_candidates.size(); piece++) {
+      if(m_candidates[piece] != 0) {
+         m_alive_pieces.emplace_back(piece);
+      }
+   }
+}
+
+void BeliefTracker::_prepare_deals(const State &state)
+{
+   const auto &board = state.board();
+   // only the hidden pieces are dealt, the revealed ones keep their tokens
+   auto undealt = m_alive;
+   m_hidden.clear();
+   std::vector< token_set > hidden_candidates;
+   for(auto piece : m_alive_pieces) {
+      const auto &piece_opt = board[m_positions[piece]];
+      if(piece_opt.has_value() and piece_opt->flag_hidden()) {
+         m_hidden.emplace_back(piece);
+         hidden_candidates.emplace_back(m_candidates[piece]);
+      } else {
+         auto &count = undealt[size_t(std::countr_zero(m_candidates[piece]))];
+         count -= std::min(count, 1u);
+      }
+   }
+   m_sampler = std::make_shared< const detail::DealSampler >(hidden_candidates, undealt);
+}
+
+void BeliefTracker::determinize_into(State &world, common::RNG &rng) const
+{
+   auto opponent = m_observer == Team::BLUE ? Team::RED : Team::BLUE;
+   auto tokens = m_sampler->sample(rng);
+   if(not tokens.has_value()) {
+      throw std::logic_error("No deal of the undealt tokens respects the beliefs.");
+   }
+   auto &board = world.board();
+   for(size_t i = 0; i < m_hidden.size(); i++) {
+      const auto &pos = m_positions[m_hidden[i]];
+      board[pos] = Piece{opponent, pos, (*tokens)[i], true};
+   }
+   world.sync_board();
+}
+
+}  // namespace stratego
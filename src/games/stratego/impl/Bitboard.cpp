@@ -0,0 +1,91 @@
+#include "stratego/Bitboard.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace stratego {
+
+MoveTables::MoveTables(
+   std::array< size_t, 2 > game_dims,
+   const std::array< std::vector< bool >, n_tokens > &move_distances
+)
+    : m_n_cols(game_dims[1]), m_rays(game_dims[0] * game_dims[1])
+{
+   if(not fits(game_dims)) {
+      throw std::invalid_argument(
+         "A board of shape (" + std::to_string(game_dims[0]) + ", " + std::to_string(game_dims[1])
+         + ") has more than " + std::to_string(Bitboard::max_squares) + " squares."
+      );
+   }
+   auto n_rows = game_dims[0];
+   m_squares = Bitboard::below(n_squares());
+   for(size_t x = 0; x < n_rows; x++) {
+      for(size_t y = 0; y < m_n_cols; y++) {
+         auto &rays = m_rays[x * m_n_cols + y];
+         for(size_t i = 0; i < x; i++) {
+            rays[static_cast< size_t >(Direction::x_down)].set(i * m_n_cols + y);
+         }
+         for(size_t i = x + 1; i < n_rows; i++) {
+            rays[static_cast< size_t >(Direction::x_up)].set(i * m_n_cols + y);
+         }
+         for(size_t j = 0; j < y; j++) {
+            rays[static_cast< size_t >(Direction::y_down)].set(x * m_n_cols + j);
+         }
+         for(size_t j = y + 1; j < m_n_cols; j++) {
+            rays[static_cast< size_t >(Direction::y_up)].set(x * m_n_cols + j);
+         }
+      }
+   }
+   for(size_t token_index = 0; token_index < n_tokens; token_index++) {
+      auto &distances = m_distances[token_index];
+      for(size_t distance = 1; distance < move_distances[token_index].size(); distance++) {
+         if(move_distances[token_index][distance]) {
+            distances.set(distance);
+         }
+      }
+      // distance 0 is never set, so the distances are 1, ..., d exactly if there are d of them
+      if(distances.any() and distances.count() == distances.highest()) {
+         m_contiguous_range[token_index] = distances.highest();
+      }
+   }
+}
+
+Bitboard MoveTables::targets(
+   size_t square,
+   Direction direction,
+   Token token,
+   const Bitboard &occupied
+) const
+{
+   const auto &ray = this->ray(square, direction);
+   auto reach = ray;
+   if(auto blockers = ray & occupied; blockers.any()) {
+      // cut the ray off behind the first blocker, which remains part of the reach
+      auto blocker = _ascending(direction) ? blockers.lowest() : blockers.highest();
+      reach ^= this->ray(blocker, direction);
+   }
+   auto token_index = static_cast< size_t >(token);
+   auto step = _step(direction);
+   if(const auto &range = m_contiguous_range[token_index]; range.has_value()) {
+      // keep the first `range` squares of the ray
+      if(_ascending(direction)) {
+         return reach & Bitboard::below(square + *range * step + 1);
+      }
+      auto range_offset = *range * step;
+      return range_offset >= square ? reach : reach & ~Bitboard::below(square - range_offset);
+   }
+   // a range with gaps: check the distance of every reachable square individually
+   const auto &distances = m_distances[token_index];
+   Bitboard targets;
+   for(auto rest = reach; rest.any();) {
+      auto target = rest.pop_lowest();
+      auto distance = (target > square ? target - square : square - target) / step;
+      if(distances.test(distance)) {
+         targets.set(target);
+      }
+   }
+   return targets;
+}
+
+}  // namespace stratego
@@ -27,6 +27,29 @@ std::map< Token, std::function< bool(size_t) > > default_move_ranges()
    return moverange;
 }
 
+std::array< std::vector< bool >, n_tokens > compile_move_distances(
+   std::array< size_t, 2 > game_dims,
+   const std::map< Token, std::function< bool(size_t) > >& move_ranges
+)
+{
+   // no move can be longer than the larger board dimension minus one
+   auto max_distance = std::max(game_dims[0], game_dims[1]) - 1;
+   std::array< std::vector< bool >, n_tokens > move_distances;
+   for(const auto& [token, in_range] : move_ranges) {
+      auto token_index = static_cast< size_t >(token);
+      if(token_index >= n_tokens) {
+         // holes do not move
+         continue;
+      }
+      auto& distances = move_distances[token_index];
+      distances.resize(max_distance + 1);
+      for(size_t distance = 0; distance <= max_distance; distance++) {
+         distances[distance] = in_range(distance);
+      }
+   }
+   return move_distances;
+}
+
 std::map< std::pair< Token, Token >, FightOutcome > default_battlematrix()
 {
    std::map< std::pair< Token, Token >, FightOutcome > bm;
@@ -309,6 +332,34 @@ std::vector< Position2D > Config::_init_hole_positions(
              );
 }
 
+void Config::_compile_tables()
+{
+   for(const auto& [att_def, outcome] : m_battle_matrix) {
+      auto [attacker, defender] = std::pair{
+         static_cast< size_t >(att_def.first), static_cast< size_t >(att_def.second)};
+      if(attacker < n_tokens and defender < n_tokens) {
+         m_fight_outcomes[attacker][defender] = outcome;
+      }
+   }
+   m_move_distances = compile_move_distances(m_game_dims, m_move_ranges);
+   m_max_move_ranges.fill(0);
+   m_full_move_ranges.fill(false);
+   for(size_t token_index = 0; token_index < n_tokens; token_index++) {
+      const auto& distances = m_move_distances[token_index];
+      size_t n_distances = 0;
+      for(size_t distance = 1; distance < distances.size(); distance++) {
+         if(distances[distance]) {
+            m_max_move_ranges[token_index] = distance;
+            n_distances++;
+         }
+      }
+      m_full_move_ranges[token_index] = n_distances == m_max_move_ranges[token_index];
+   }
+   if(MoveTables::fits(m_game_dims)) {
+      m_move_tables = std::make_shared< const MoveTables >(m_game_dims, m_move_distances);
+   }
+}
+
 Config::token_counter_t tokens_from_setup(const Config::setup_t& setup)
 {
    auto values = setup | ranges::views::values;
@@ -392,16 +443,6 @@ Config::Config(
 )
     : starting_team(starting_team_),
       fixed_starting_team(fixed_starting_team_),
-      game_dims(std::visit(
-         common::Overload{
-            [](size_t d) {
-               return std::array{d, d};
-            },
-            [](ranges::span< size_t, 2 > d) {
-               return std::array{d[0], d[1]};
-            }},
-         game_dims_
-      )),
       max_turn_count(max_turn_count_),
       fixed_setups(std::visit(
          common::Overload{
@@ -415,23 +456,41 @@ Config::Config(
          fixed_setups_
       )),
       setups(_init_setups(setups_, token_set_, start_fields_, game_dims_)),
-      token_counters(_init_tokencounters(token_set_, setups_)),
-      start_fields(_init_start_fields(start_fields_, setups_)),
-      battle_matrix(std::move(battle_matrix_)),
       hole_positions(_init_hole_positions(hole_positions_, game_dims_)),
-      move_ranges(std::move(move_ranges_))
+      m_game_dims(std::visit(
+         common::Overload{
+            [](size_t d) {
+               return std::array{d, d};
+            },
+            [](ranges::span< size_t, 2 > d) {
+               return std::array{d[0], d[1]};
+            }},
+         game_dims_
+      )),
+      m_token_counters(_init_tokencounters(token_set_, setups_)),
+      m_start_fields(_init_start_fields(start_fields_, setups_)),
+      m_battle_matrix(std::move(battle_matrix_)),
+      m_move_ranges(std::move(move_ranges_)),
+      m_zobrist_keys(std::make_shared< const ZobristKeys >(m_game_dims))
 {
+   _compile_tables();
    for(int i = 0; i < 2; ++i) {
-      if(utils::flatten_counter(token_counters[Team(i)]).size() != start_fields[Team(i)].size()) {
+      if(utils::flatten_counter(m_token_counters.at(Team(i))).size()
+         != m_start_fields.at(Team(i)).size()) {
          SPDLOG_DEBUG(
-            "Token vector size: {}", utils::flatten_counter(token_counters[Team(i)]).size()
+            "Token vector size: {}", utils::flatten_counter(m_token_counters.at(Team(i))).size()
          );
-         SPDLOG_DEBUG("Field vector size: {}", start_fields[Team(i)].size());
+         SPDLOG_DEBUG("Field vector size: {}", m_start_fields.at(Team(i)).size());
          throw std::invalid_argument(
             "Token counters and start position vectors do not match in size"
          );
       }
    }
+   for(auto team : {Team::BLUE, Team::RED}) {
+      m_setup_spaces[team] = std::make_shared< const SetupSpace >(
+         m_start_fields.at(team), m_token_counters.at(team)
+      );
+   }
 }
 
 Config::Config(
@@ -501,7 +560,9 @@ Config::Config(
     : Config(
        starting_team_,
        game_dims_,
-       default_setup(game_dims),
+       std::map< Team, std::optional< setup_t > >{
+          std::pair{Team::BLUE, default_setup(static_cast< size_t >(game_dims_), Team::BLUE)},
+          std::pair{Team::RED, default_setup(static_cast< size_t >(game_dims_), Team::RED)}},
        default_holes(static_cast< size_t >(game_dims_)),
        std::map{
           std::pair{Team::BLUE, std::optional< token_variant_t >{default_token_sets(game_dims_)}},
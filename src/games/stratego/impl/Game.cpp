@@ -29,9 +29,7 @@ Status Game::run(const sptr< utils::Plotter< State > >& plotter)
       auto available_actions = state().logic()->valid_actions(state(), active_team);
       auto action = agent(active_team)->decide_action(state(), available_actions);
 
-      SPDLOG_DEBUG(
-         fmt::format("Possible Moves {}", state().logic()->valid_actions(state(), active_team))
-      );
+      SPDLOG_DEBUG(fmt::format("Possible Moves {}", available_actions));
       SPDLOG_DEBUG(fmt::format("Selected Action by team {}: {}", active_team, action));
 
       m_state->transition(action);
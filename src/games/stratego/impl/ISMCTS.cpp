@@ -0,0 +1,227 @@
+#include "stratego/ISMCTS.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "stratego/Logic.hpp"
+
+namespace stratego {
+
+namespace {
+
+double reward(Status status, Team team)
+{
+   if(status == Status::TIE) {
+      return .5;
+   }
+   return (status == Status::WIN_BLUE) == (team == Team::BLUE) ? 1. : 0.;
+}
+
+}  // namespace
+
+ISMCTSAgent::Node *ISMCTSAgent::Node::child(const Action &action) const
+{
+   for(const auto &child : children) {
+      if(child->action == action) {
+         return child.get();
+      }
+   }
+   return nullptr;
+}
+
+ISMCTSAgent::ISMCTSAgent(Team team, ISMCTSConfig config) : Agent(team), m_config(config)
+{
+   if(not m_config.time_budget.has_value() and m_config.max_iterations == 0) {
+      throw std::invalid_argument("ISMCTS needs either a time budget or an iteration limit.");
+   }
+}
+
+Action ISMCTSAgent::decide_action(const State &state, const std::vector< Action > &poss_moves)
+{
+   if(poss_moves.empty()) {
+      throw std::invalid_argument("ISMCTS cannot decide without any possible moves.");
+   }
+   size_t n_threads = m_config.n_threads;
+   if(n_threads == 0) {
+      n_threads = std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+   }
+   _advance_trees(state, n_threads);
+   if(m_beliefs.has_value()) {
+      m_beliefs->update(state);
+   } else {
+      m_beliefs.emplace(state, team());
+   }
+
+   auto deadline = std::chrono::steady_clock::now()
+                   + m_config.time_budget.value_or(std::chrono::milliseconds(0));
+   // the first exception of any thread stops the search and is rethrown once all threads joined
+   std::exception_ptr error;
+   std::mutex error_mutex;
+   std::atomic< bool > failed{false};
+   auto search = [&](size_t thread) {
+      try {
+         RandomPlayout playout{m_config.seed + m_n_decisions * n_threads + thread};
+         auto &root = *m_trees[thread];
+         for(size_t iteration = 0;
+             m_config.max_iterations == 0 or iteration < m_config.max_iterations;
+             iteration++) {
+            if(failed.load(std::memory_order_relaxed)
+               or (m_config.time_budget.has_value()
+                   and std::chrono::steady_clock::now() >= deadline)) {
+               break;
+            }
+            _iterate(root, state, playout);
+         }
+      } catch(...) {
+         std::scoped_lock lock{error_mutex};
+         if(not error) {
+            error = std::current_exception();
+         }
+         failed = true;
+      }
+   };
+   {
+      std::vector< std::jthread > workers;
+      for(size_t t = 1; t < n_threads; t++) {
+         workers.emplace_back(search, t);
+      }
+      search(0);
+   }
+   if(error) {
+      // an iteration may have been cut short mid-update, so the trees are not reused
+      m_trees.clear();
+      m_root_turn.reset();
+      std::rethrow_exception(error);
+   }
+   m_root_turn = state.turn_count();
+   m_n_decisions++;
+
+   // the most visited move over all trees
+   const Action *best = &poss_moves.front();
+   size_t best_visits = 0;
+   for(const auto &action : poss_moves) {
+      size_t visits = 0;
+      for(const auto &tree : m_trees) {
+         if(const auto *child = tree->child(action)) {
+            visits += child->visits;
+         }
+      }
+      if(visits > best_visits) {
+         best = &action;
+         best_visits = visits;
+      }
+   }
+   return *best;
+}
+
+void ISMCTSAgent::_advance_trees(const State &state, size_t n_threads)
+{
+   // the moves played since the last search, which have to be in the history to be followed
+   std::vector< const MoveRecord * > played;
+   if(m_root_turn.has_value()) {
+      for(const auto &record : state.history()) {
+         if(record.turn >= *m_root_turn) {
+            played.emplace_back(&record);
+         }
+      }
+   }
+   bool reuse = m_config.reuse_tree and m_root_turn.has_value() and m_trees.size() == n_threads
+                and *m_root_turn <= state.turn_count()
+                and played.size() == state.turn_count() - *m_root_turn;
+   if(not reuse) {
+      m_trees.clear();
+      m_trees.resize(n_threads);
+   }
+   for(auto &tree : m_trees) {
+      for(const auto *record : played) {
+         if(tree == nullptr or not reuse) {
+            break;
+         }
+         auto iter = std::ranges::find_if(tree->children, [&](const auto &child) {
+            return child->action == record->action;
+         });
+         if(iter == tree->children.end()) {
+            tree.reset();
+            break;
+         }
+         // detach the subtree before its parent is destroyed
+         auto subtree = std::move(*iter);
+         tree = std::move(subtree);
+      }
+      if(tree == nullptr) {
+         tree = std::make_unique< Node >(Node{std::nullopt, team()});
+      }
+   }
+}
+
+void ISMCTSAgent::_iterate(Node &root, const State &state, RandomPlayout &playout) const
+{
+   auto world = m_beliefs->determinize(state, playout.rng());
+   std::vector< Node * > path{&root};
+   auto *node = &root;
+   std::vector< Node * > available;
+   std::vector< const Action * > untried;
+   while(world.status() == Status::ONGOING) {
+      auto active_team = world.active_team();
+      auto actions = world.logic()->valid_actions(world, active_team);
+      available.clear();
+      untried.clear();
+      for(const auto &action : actions) {
+         if(auto *child = node->child(action)) {
+            available.emplace_back(child);
+         } else {
+            untried.emplace_back(&action);
+         }
+      }
+      for(auto *child : available) {
+         child->availability++;
+      }
+      if(not untried.empty()) {
+         // expand a move not yet in the tree and leave the rest of the game to the playout
+         const auto &action = *untried[std::uniform_int_distribution< size_t >(
+            0, untried.size() - 1
+         )(playout.rng())];
+         node->children.emplace_back(std::make_unique< Node >(Node{action, active_team}));
+         node = node->children.back().get();
+         node->availability++;
+         path.emplace_back(node);
+         world.transition(action);
+         break;
+      }
+      Node *selected = nullptr;
+      double best_value = -std::numeric_limits< double >::infinity();
+      for(auto *child : available) {
+         auto visits = double(child->visits);
+         auto value = child->reward / visits
+                      + m_config.exploration
+                           * std::sqrt(std::log(double(child->availability)) / visits);
+         if(value > best_value) {
+            selected = child;
+            best_value = value;
+         }
+      }
+      node = selected;
+      path.emplace_back(node);
+      world.transition(*node->action);
+   }
+   auto status = world.status() == Status::ONGOING ? playout.run(world) : world.status();
+   for(auto *visited : path) {
+      visited->visits++;
+      visited->reward += reward(status, visited->team);
+   }
+}
+
+State ISMCTSAgent::determinize(const State &state, Team observer, common::RNG &rng)
+{
+   return BeliefTracker{state, observer}.determinize(state, rng);
+}
+
+}  // namespace stratego
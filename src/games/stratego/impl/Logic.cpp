@@ -51,16 +51,25 @@ void Logic::apply_action(State &state, const Action &action)
    if(piece_to_opt.has_value()) {
       auto &piece_to = piece_to_opt.value();
       // engage in fight, since piece_to is not a null piece
-      handle_fight(state, piece_from, piece_to);
+      state.history().commit_fight(handle_fight(state, piece_from, piece_to));
    } else {
       // no fight happened, simply move piece_from onto new position
+      std::optional< Piece > moved = piece_from;
       update_board(board, to, piece_from);
       update_board(board, from);
+      state.sync_square(from, moved);
+      state.sync_square(to, std::nullopt);
    }
+   // both teams observe the move and the tokens that its fight revealed
+   state.observe_move(state.history().last());
 }
 FightOutcome Logic::handle_fight(State &state, Piece &attacker, Piece &defender)
 {
    auto &board = state.board();
+   auto from = attacker.position();
+   auto to = defender.position();
+   std::optional< Piece > attacker_before = attacker;
+   std::optional< Piece > defender_before = defender;
    // uncover participant pieces
    attacker.flag_hidden(false);
    defender.flag_hidden(false);
@@ -85,6 +94,8 @@ FightOutcome Logic::handle_fight(State &state, Piece &attacker, Piece &defender)
          break;
       }
    }
+   state.sync_square(from, attacker_before);
+   state.sync_square(to, defender_before);
    return outcome;
 }
 bool Logic::is_valid(const State &state, const Action &action, std::optional< Team > team_opt)
@@ -128,7 +139,7 @@ bool Logic::is_valid(const State &state, const Action &action, std::optional< Te
    int move_dist = abs(pos_after[1] - pos_before[1]) + abs(pos_after[0] - pos_before[0]);
 
    // check if the move distance is within the move range of the token
-   if(not state.config().move_ranges.at(p_b.token())(static_cast< unsigned long >(move_dist))) {
+   if(not state.config().in_move_range(p_b.token(), static_cast< size_t >(move_dist))) {
       return false;
    }
 
@@ -159,23 +170,27 @@ bool Logic::is_valid(const State &state, const Action &action, std::optional< Te
 std::vector< Action > Logic::valid_actions(const State &state, Team team)
 {
    SPDLOG_DEBUG("Checking for valid actions.");
-   const auto &board = state.board();
    std::vector< Action > actions_possible;
+   if(const auto *tables = state.config().move_tables().get()) {
+      _visit_moves(state, team, [&](size_t from, size_t to) {
+         actions_possible.emplace_back(team, Move{tables->position(from), tables->position(to)});
+         return false;
+      });
+      return actions_possible;
+   }
+   return scan_valid_actions(state, team);
+}
+std::vector< Action > Logic::scan_valid_actions(const State &state, Team team)
+{
+   std::vector< Action > actions_possible;
+   const auto &board = state.board();
    for(const auto &elem : board) {
       if(elem.has_value()) {
          const auto &piece = elem.value();
          if(piece.team() == team) {
             // the position we are dealing with
             auto pos = piece.position();
-            int token_move_range = 0;
-            auto mr_tester = state.config().move_ranges.at(piece.token());
-            for(int distance :
-                ranges::views::iota(1, int(ranges::max(board.shape()))) | ranges::views::reverse) {
-               if(mr_tester(static_cast< size_t >(distance))) {
-                  token_move_range = distance;
-                  break;
-               }
-            }
+            auto token_move_range = int(state.config().max_move_ranges()[size_t(piece.token())]);
             ranges::for_each(
                _valid_vectors(pos, board.shape(), token_move_range),
                [&](const Position2D &pos_to) {
@@ -191,28 +206,35 @@ std::vector< Action > Logic::valid_actions(const State &state, Team team)
 
    return actions_possible;
 }
+void Logic::valid_moves(
+   const State &state,
+   Team team,
+   std::vector< std::array< size_t, 2 > > &moves
+)
+{
+   moves.clear();
+   _visit_moves(state, team, [&](size_t from, size_t to) {
+      moves.push_back({from, to});
+      return false;
+   });
+}
 bool Logic::has_valid_actions(const State &state, Team team)
 {
+   if(state.config().move_tables()) {
+      return _visit_moves(state, team, [](size_t, size_t) { return true; });
+   }
    const auto &board = state.board();
    for(const auto &piece_opt : board) {
       if(piece_opt.has_value()) {
          const auto &piece = piece_opt.value();
          if(Token token = piece.token();
-            piece.team() == team && not std::set{Token::flag, Token::bomb}.contains(token)) {
+            piece.team() == team and token != Token::flag and token != Token::bomb) {
             // the position we are dealing with
             auto pos = piece.position();
 
             //               SPDLOG_DEBUG("check for piece", utils::to_string(piece.token()) + " :
             //               {}" + utils::to_string(piece.team()));
-            int token_move_range = 0;
-            auto mr_tester = state.config().move_ranges.at(piece.token());
-            for(int distance :
-                ranges::views::iota(1, int(ranges::max(board.shape()))) | ranges::views::reverse) {
-               if(mr_tester(static_cast< size_t >(distance))) {
-                  token_move_range = distance;
-                  break;
-               }
-            }
+            auto token_move_range = int(state.config().max_move_ranges()[size_t(piece.token())]);
 
             if(ranges::any_of(
                   _valid_vectors(pos, board.shape(), token_move_range),
@@ -235,51 +257,37 @@ std::map< Position2D, Token > stratego::Logic::draw_setup_uniform(
    common::RNG &rng
 )
 {
-   std::map< Position2D, Token > setup_out;
-
-   auto start_fields = config.start_fields.at(team);
-   auto token_counter = config.token_counters.at(team);
-   auto uniq_token_view = token_counter | ranges::views::keys;
-   std::vector< Token > tokenvec = {uniq_token_view.begin(), uniq_token_view.end()};
-
-   ranges::shuffle(start_fields, rng);
-   auto int_dist = std::uniform_int_distribution< size_t >(0, tokenvec.size() - 1);
-
-   while(not start_fields.empty()) {
-      auto &pos = start_fields.back();
-      if(curr_board[pos].has_value()) {
-         // if the current board already has a piece at this location, then remove the
-         // position from the possible ones.
-         start_fields.pop_back();
-         continue;
-      }
-      auto choice = int_dist(rng);
-      auto token = tokenvec[choice];
-      // needs to be refernce since it is decremented inplace
-      auto &count = token_counter[token];
-      if(count > 0) {
-         setup_out[pos] = token;
-         count--;
-         start_fields.pop_back();
-      }
-      if(count == 0) {
-         tokenvec.erase(tokenvec.begin() + static_cast< long >(choice));
-         int_dist = std::uniform_int_distribution< size_t >(0, tokenvec.size() - 1);
+   const auto &fields = config.start_fields().at(team);
+   std::vector< Position2D > free_fields;
+   free_fields.reserve(fields.size());
+   for(const auto &pos : fields) {
+      if(not curr_board[pos].has_value()) {
+         free_fields.emplace_back(pos);
       }
    }
-   if(not tokenvec.empty()) {
-      throw std::invalid_argument(
-         "Current board setup and config could not be made to agree with number of tokens to "
-         "place on it."
-      );
+   // the cached setup space covers the full start fields, a partially filled board needs its own
+   auto space = config.setup_spaces().at(team);
+   if(free_fields.size() != fields.size() or space == nullptr) {
+      try {
+         space = std::make_shared< const SetupSpace >(
+            std::move(free_fields), config.token_counters().at(team)
+         );
+      } catch(const std::invalid_argument &) {
+         throw std::invalid_argument(
+            "Current board setup and config could not be made to agree with number of tokens to "
+            "place on it."
+         );
+      }
    }
-   return setup_out;
+   std::vector< Token > setup(space->n_pieces());
+   space->sample(rng, setup);
+   return space->to_map(setup);
 }
 Board Logic::create_empty_board(const Config &config)
 {
-   Board b(config.game_dims);
-   for(auto x : ranges::views::iota(size_t(0), config.game_dims[0])) {
-      for(auto y : ranges::views::iota(size_t(0), config.game_dims[1])) {
+   Board b(config.game_dims());
+   for(auto x : ranges::views::iota(size_t(0), config.game_dims()[0])) {
+      for(auto y : ranges::views::iota(size_t(0), config.game_dims()[1])) {
          b[{x, y}] = std::nullopt;
       }
    }
@@ -321,11 +329,13 @@ Logic *Logic::clone_impl() const
 }
 void Logic::reset(State &state)
 {
-   if(not state.config().fixed_starting_team) {
-      Config cfg_copy = state.config();
+   auto config = state.config_ptr();
+   if(not config->fixed_starting_team) {
+      Config cfg_copy = *config;
       cfg_copy.starting_team = common::choose(std::array{Team::BLUE, Team::RED}, state.rng());
+      config = std::make_shared< const Config >(std::move(cfg_copy));
    }
-   state = State(state.config());
+   state = State(std::move(config));
 }
 bool Logic::is_valid(const State &state, Move move, Team team)
 {
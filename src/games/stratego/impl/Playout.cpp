@@ -0,0 +1,110 @@
+#include "stratego/Playout.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+
+#include "stratego/Logic.hpp"
+
+namespace stratego {
+
+Status RandomPlayout::run(State &state)
+{
+   const auto &config = state.config();
+   const auto *tables = config.move_tables().get();
+   auto *logic = state.logic();
+   if(config.max_turn_count > state.turn_count()) {
+      state.reserve_history(config.max_turn_count - state.turn_count());
+   }
+   while(true) {
+      // the terminal conditions in the order of Logic::check_terminal, whose check for any valid
+      // move of the active team is answered by the moves generated for it anyway
+      if(state.graveyard(Team::BLUE).at(Token::flag) != 0) {
+         return state.status(Status::WIN_RED);
+      }
+      if(state.graveyard(Team::RED).at(Token::flag) != 0) {
+         return state.status(Status::WIN_BLUE);
+      }
+      auto team = state.active_team();
+      size_t n_moves = 0;
+      if(tables != nullptr) {
+         Logic::valid_moves(state, team, m_moves);
+         n_moves = m_moves.size();
+      } else {
+         m_actions = logic->valid_actions(state, team);
+         n_moves = m_actions.size();
+      }
+      if(n_moves == 0) {
+         return state.status(team == Team::BLUE ? Status::WIN_RED : Status::WIN_BLUE);
+      }
+      if(std::cmp_greater_equal(state.turn_count(), config.max_turn_count)) {
+         return state.status(Status::TIE);
+      }
+      auto choice = std::uniform_int_distribution< size_t >(0, n_moves - 1)(m_rng);
+      if(tables != nullptr) {
+         const auto &[from, to] = m_moves[choice];
+         state.transition(Action{team, Move{tables->position(from), tables->position(to)}});
+      } else {
+         state.transition(m_actions[choice]);
+      }
+   }
+}
+
+std::vector< Status > RandomPlayout::run_batch(
+   const State &state,
+   size_t n_playouts,
+   size_t seed,
+   size_t n_threads
+)
+{
+   std::vector< Status > outcomes(n_playouts, Status::ONGOING);
+   // playouts are handed out to the threads in chunks to keep the contention on the counter low
+   constexpr size_t chunk_size = 64;
+   size_t n_chunks = (n_playouts + chunk_size - 1) / chunk_size;
+   std::atomic< size_t > next_chunk{0};
+   // the first exception of any thread is rethrown once all of them have joined
+   std::exception_ptr error;
+   std::mutex error_mutex;
+   auto work = [&] {
+      try {
+         auto worker_state = state;
+         auto start_round = worker_state.turn_count();
+         RandomPlayout playout{seed};
+         for(size_t chunk = next_chunk++; chunk < n_chunks; chunk = next_chunk++) {
+            auto end = std::min(n_playouts, (chunk + 1) * chunk_size);
+            for(size_t i = chunk * chunk_size; i < end; i++) {
+               playout.rng().seed(seed + i);
+               outcomes[i] = playout.run(worker_state);
+               worker_state.restore_to_round(start_round);
+            }
+         }
+      } catch(...) {
+         std::scoped_lock lock{error_mutex};
+         if(not error) {
+            error = std::current_exception();
+         }
+         next_chunk = n_chunks;
+      }
+   };
+   if(n_threads == 0) {
+      n_threads = std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+   }
+   n_threads = std::min(n_threads, n_chunks);
+   {
+      std::vector< std::jthread > workers;
+      for(size_t t = 1; t < n_threads; t++) {
+         workers.emplace_back(work);
+      }
+      work();
+   }
+   if(error) {
+      std::rethrow_exception(error);
+   }
+   return outcomes;
+}
+
+}  // namespace stratego
@@ -0,0 +1,262 @@
+#include "stratego/Setup.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+
+namespace stratego {
+
+SetupIndex SetupIndex::scaled(uint32_t factor, uint32_t divisor) const
+{
+   // the product in 32 bit limbs (least significant first), with one limb of headroom
+   std::array< uint64_t, 5 > limbs{
+      low & 0xffffffff, low >> 32, high & 0xffffffff, high >> 32, 0};
+   uint64_t carry = 0;
+   for(auto &limb : limbs) {
+      auto product = limb * factor + carry;
+      limb = product & 0xffffffff;
+      carry = product >> 32;
+   }
+   if(limbs[4] != 0) {
+      throw std::overflow_error("The setup index product does not fit into 128 bits.");
+   }
+   uint64_t remainder = 0;
+   for(auto &limb : limbs | std::views::reverse) {
+      auto dividend = remainder << 32 | limb;
+      limb = dividend / divisor;
+      remainder = dividend % divisor;
+   }
+   assert(remainder == 0);
+   return {limbs[3] << 32 | limbs[2], limbs[1] << 32 | limbs[0]};
+}
+
+SetupSpace::SetupSpace(std::vector< Position2D > fields, const token_counter_t &tokens)
+    : m_fields(std::move(fields))
+{
+   std::sort(m_fields.begin(), m_fields.end());
+   if(std::adjacent_find(m_fields.begin(), m_fields.end()) != m_fields.end()) {
+      throw std::invalid_argument("The start fields of a setup space have to be distinct.");
+   }
+   m_tokens.reserve(m_fields.size());
+   for(const auto &[token, count] : tokens) {
+      auto slot = static_cast< size_t >(token);
+      if(slot >= n_tokens) {
+         throw std::invalid_argument("Only the tokens of a team can be placed in a setup.");
+      }
+      m_counts[slot] += count;
+      m_tokens.insert(m_tokens.end(), count, token);
+   }
+   if(m_tokens.size() != m_fields.size()) {
+      throw std::invalid_argument("The number of tokens and start fields of a setup differ.");
+   }
+   // the multinomial coefficient as the product of binomials C(placed + count, count)
+   m_size = 1;
+   uint32_t placed = 0;
+   for(auto count : m_counts) {
+      for(uint32_t i = 1; i <= count; i++) {
+         m_size = m_size.scaled(++placed, i);
+      }
+   }
+}
+
+template < typename TokenAt >
+SetupIndex SetupSpace::_rank(TokenAt token_at) const
+{
+   auto counts = m_counts;
+   // the number of arrangements of the tokens that remain to be placed
+   auto remaining = m_size;
+   SetupIndex index = 0;
+   for(size_t i = 0; i < n_pieces(); i++) {
+      auto n_remaining = static_cast< uint32_t >(n_pieces() - i);
+      auto slot = static_cast< size_t >(token_at(i));
+      if(slot >= n_tokens or counts[slot] == 0) {
+         throw std::invalid_argument("The setup does not hold the tokens of the setup space.");
+      }
+      // skip the arrangements beginning with a lesser token
+      for(size_t lesser = 0; lesser < slot; lesser++) {
+         if(counts[lesser] > 0) {
+            index += remaining.scaled(counts[lesser], n_remaining);
+         }
+      }
+      remaining = remaining.scaled(counts[slot], n_remaining);
+      counts[slot]--;
+   }
+   return index;
+}
+
+SetupIndex SetupSpace::rank(std::span< const Token > setup) const
+{
+   if(setup.size() != n_pieces()) {
+      throw std::invalid_argument("The setup does not have a token for every start field.");
+   }
+   return _rank([&](size_t i) { return setup[i]; });
+}
+
+SetupIndex SetupSpace::rank(const std::map< Position2D, Token > &setup) const
+{
+   // both the map and the fields are in ascending order of the positions
+   auto iter = setup.begin();
+   if(setup.size() != n_pieces()
+      or not std::all_of(m_fields.begin(), m_fields.end(), [&](const Position2D &field) {
+            return field == (iter++)->first;
+         })) {
+      throw std::invalid_argument("The setup does not place a token on every start field.");
+   }
+   iter = setup.begin();
+   return _rank([&](size_t) { return (iter++)->second; });
+}
+
+void SetupSpace::unrank(SetupIndex index, std::span< Token > setup) const
+{
+   if(index >= m_size) {
+      throw std::out_of_range("The setup index exceeds the size of the setup space.");
+   }
+   if(setup.size() != n_pieces()) {
+      throw std::invalid_argument("The setup does not have a token for every start field.");
+   }
+   auto counts = m_counts;
+   auto remaining = m_size;
+   for(size_t i = 0; i < n_pieces(); i++) {
+      auto n_remaining = static_cast< uint32_t >(n_pieces() - i);
+      for(size_t slot = 0; slot < n_tokens; slot++) {
+         if(counts[slot] == 0) {
+            continue;
+         }
+         auto block = remaining.scaled(counts[slot], n_remaining);
+         if(index < block) {
+            setup[i] = Token(slot);
+            remaining = block;
+            counts[slot]--;
+            break;
+         }
+         index -= block;
+      }
+   }
+}
+
+void SetupSpace::sample(common::RNG &rng, std::span< Token > setup) const
+{
+   if(setup.size() != n_pieces()) {
+      throw std::invalid_argument("The setup does not have a token for every start field.");
+   }
+   // the inside-out Fisher-Yates shuffle, which writes the tokens in place
+   for(size_t i = 0; i < n_pieces(); i++) {
+      auto j = std::uniform_int_distribution< size_t >(0, i)(rng);
+      setup[i] = setup[j];
+      setup[j] = m_tokens[i];
+   }
+}
+
+std::map< Position2D, Token > SetupSpace::to_map(std::span< const Token > setup) const
+{
+   if(setup.size() != n_pieces()) {
+      throw std::invalid_argument("The setup does not have a token for every start field.");
+   }
+   std::map< Position2D, Token > map;
+   for(size_t i = 0; i < n_pieces(); i++) {
+      map.emplace_hint(map.end(), m_fields[i], setup[i]);
+   }
+   return map;
+}
+
+SetupConstraints
+SetupConstraints::flag_on_back_row(const SetupSpace &space, Team team, bool bombs_around_flag)
+{
+   // blue starts on the low rows and red on the high ones
+   const auto &fields = space.fields();
+   auto back_row = team == Team::BLUE ? fields.front()[0] : fields.back()[0];
+   SetupConstraints constraints{.bombs_around_flag = bombs_around_flag};
+   for(const auto &field : fields) {
+      if(field[0] == back_row) {
+         constraints.flag_fields.emplace_back(field);
+      }
+   }
+   return constraints;
+}
+
+SetupSampler::SetupSampler(const SetupSpace &space, const SetupConstraints &constraints)
+    : m_n_pieces(space.n_pieces())
+{
+   const auto &fields = space.fields();
+   const auto &tokens = space.tokens();
+   auto n_bombs = static_cast< size_t >(std::ranges::count(tokens, Token::bomb));
+   auto flag_iter = std::ranges::find(tokens, Token::flag);
+   if(flag_iter == tokens.end()) {
+      throw std::invalid_argument("A setup without a flag cannot be constrained by it.");
+   }
+   m_rest_tokens.reserve(tokens.size() - 1);
+   std::ranges::copy_if(tokens, std::back_inserter(m_rest_tokens), [](Token token) {
+      return token != Token::bomb;
+   });
+   m_rest_tokens.erase(std::ranges::find(m_rest_tokens, Token::flag));
+   m_rest_tokens.insert(m_rest_tokens.end(), n_bombs, Token::bomb);
+
+   // the log of the number of arrangements of the remaining tokens, up to their common divisor
+   auto log_factorial = [](size_t n) { return std::lgamma(double(n) + 1.); };
+   std::vector< double > log_weights;
+   for(size_t flag = 0; flag < fields.size(); flag++) {
+      if(not constraints.flag_fields.empty()
+         and std::ranges::find(constraints.flag_fields, fields[flag])
+                == constraints.flag_fields.end()) {
+         continue;
+      }
+      FlagOption option{flag, {}, {}};
+      for(size_t i = 0; i < fields.size(); i++) {
+         if(i == flag) {
+            continue;
+         }
+         auto distance = std::abs(fields[i][0] - fields[flag][0])
+                         + std::abs(fields[i][1] - fields[flag][1]);
+         if(constraints.bombs_around_flag and distance == 1) {
+            option.bombs.emplace_back(i);
+         } else {
+            option.rest.emplace_back(i);
+         }
+      }
+      if(option.bombs.size() > n_bombs) {
+         continue;
+      }
+      log_weights.emplace_back(
+         log_factorial(option.rest.size()) - log_factorial(n_bombs - option.bombs.size())
+      );
+      m_options.emplace_back(std::move(option));
+   }
+   if(m_options.empty()) {
+      throw std::invalid_argument("No setup satisfies the constraints.");
+   }
+   auto max_log_weight = std::ranges::max(log_weights);
+   double total = 0.;
+   for(auto log_weight : log_weights) {
+      total += std::exp(log_weight - max_log_weight);
+      m_cumulative_weights.emplace_back(total);
+   }
+}
+
+void SetupSampler::sample(common::RNG &rng, std::span< Token > setup) const
+{
+   if(setup.size() != m_n_pieces) {
+      throw std::invalid_argument("The setup does not have a token for every start field.");
+   }
+   auto u = std::uniform_real_distribution< double >(0., m_cumulative_weights.back())(rng);
+   auto choice = std::min(
+      size_t(std::ranges::upper_bound(m_cumulative_weights, u) - m_cumulative_weights.begin()),
+      m_options.size() - 1
+   );
+   const auto &option = m_options[choice];
+   setup[option.flag] = Token::flag;
+   for(auto bomb : option.bombs) {
+      setup[bomb] = Token::bomb;
+   }
+   // the forced bombs are cut off the back of the remaining tokens, the rest is shuffled in
+   const auto &rest = option.rest;
+   for(size_t i = 0; i < rest.size(); i++) {
+      auto j = std::uniform_int_distribution< size_t >(0, i)(rng);
+      setup[rest[i]] = setup[rest[j]];
+      setup[rest[j]] = m_rest_tokens[i];
+   }
+}
+
+}  // namespace stratego
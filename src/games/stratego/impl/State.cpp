@@ -11,11 +11,31 @@ namespace stratego {
 void State::undo_last_rounds(size_t n)
 {
    for(size_t i = 0; i < n; ++i) {
-      auto [turn, team, move, pieces] = m_move_history.pop_last();
-      m_board[move[1]] = std::move(std::get< 1 >(pieces));
-      m_board[move[0]] = std::move(std::get< 0 >(pieces));
+      auto record = m_move_history.pop_last();
+      observe_move(record);
+      const auto &move = record.action.move();
+      if(record.fight_outcome.has_value()) {
+         // revive the pieces that the fight sent to the graveyard
+         const auto &attacker = record.attacker;
+         const auto &defender = record.defender.value();
+         if(*record.fight_outcome != FightOutcome::kill) {
+            m_graveyard[attacker.team()][attacker.token()]--;
+         }
+         if(*record.fight_outcome != FightOutcome::death) {
+            m_graveyard[defender.team()][defender.token()]--;
+         }
+      }
+      std::array< std::optional< Piece >, 2 > current{m_board[move[0]], m_board[move[1]]};
+      m_board[move[1]] = std::move(record.defender);
+      m_board[move[0]] = std::move(record.attacker);
+      sync_square(move[0], current[0]);
+      sync_square(move[1], current[1]);
+      if(m_hash_history.size() > 1) {
+         m_hash_history.pop_back();
+      }
    }
    m_turn_count -= n;
+   m_status_checked = false;
 }
 
 void State::restore_to_round(size_t round)
@@ -28,9 +48,9 @@ void State::restore_to_round(size_t round)
 }
 
 State::State(
-   Config config,
+   sptr< const Config > config,
    graveyard_type graveyard,
-   uptr< Logic > logic,
+   sptr< Logic > logic,
    Board board,
    size_t turn_count,
    const History &history,
@@ -50,40 +70,79 @@ State::State(
             : common::create_rng()
       )
 {
+   sync_board();
+   for(const auto &record : m_move_history) {
+      observe_move(record);
+   }
 }
 
-State::State(Config cfg, std::optional< std::variant< size_t, common::RNG > > seed)
+State::State(
+   Config config,
+   graveyard_type graveyard,
+   sptr< Logic > logic,
+   Board board,
+   size_t turn_count,
+   const History &history,
+   std::optional< std::variant< size_t, common::RNG > > seed
+)
     : State(
-       std::move(cfg),
+       std::make_shared< const Config >(std::move(config)),
+       std::move(graveyard),
+       std::move(logic),
+       std::move(board),
+       turn_count,
+       history,
+       std::move(seed)
+    )
+{
+}
+
+State::State(sptr< const Config > cfg, std::optional< std::variant< size_t, common::RNG > > seed)
+    : State(
+       cfg,
        graveyard_type{},
-       std::make_unique< Logic >(),
-       Logic::create_empty_board(cfg),
+       std::make_shared< Logic >(),
+       Logic::create_empty_board(*cfg),
        0,
        History{},
-       seed
+       std::move(seed)
     )
 {
    Logic::place_holes(config(), board());
    std::map< Team, std::map< Position2D, Token > > setups;
+   bool drawn_setups = false;
    for(auto team : std::array{Team::BLUE, Team::RED}) {
       if(not config().setups.at(team).has_value()) {
          setups.emplace(team, logic()->draw_setup_uniform(config(), board(), team, rng()));
+         drawn_setups = true;
       } else {
          setups.emplace(team, config().setups.at(team).value());
       }
    }
-   m_config.setups[Team::BLUE] = setups[Team::BLUE];
-   m_config.setups[Team::RED] = setups[Team::RED];
+   if(drawn_setups) {
+      // the shared config is immutable, so the drawn setups go into a copy owned by this game
+      Config cfg_copy = config();
+      cfg_copy.setups[Team::BLUE] = setups[Team::BLUE];
+      cfg_copy.setups[Team::RED] = setups[Team::RED];
+      m_config = std::make_shared< const Config >(std::move(cfg_copy));
+   }
    logic()->draw_board(config(), board(), setups);
+   sync_board();
    _fill_dead_pieces();
    status(Status::ONGOING);
 }
 
+State::State(Config cfg, std::optional< std::variant< size_t, common::RNG > > seed)
+    : State(std::make_shared< const Config >(std::move(cfg)), std::move(seed))
+{
+}
+
 void State::transition(const Action &action)
 {
    status_checked() = false;
    logic()->apply_action(*this, action);
    incr_turn_count();
+   m_hash_history.emplace_back(hash());
 }
 
 void State::transition(Move move)
@@ -91,9 +150,27 @@ void State::transition(Move move)
    return transition(Action{active_team(), std::move(move)});
 }
 
+void State::sync_board()
+{
+   m_bitboards.clear();
+   m_hash = 0;
+   m_observed_board_hashes.fill(0);
+   const auto *tables = config().move_tables().get();
+   for(const auto &piece_opt : m_board) {
+      if(piece_opt.has_value()) {
+         _xor_keys(*piece_opt);
+         if(tables != nullptr) {
+            m_bitboards.place(tables->index(piece_opt->position()), piece_opt);
+         }
+      }
+   }
+   // the history of positions starts anew from the synced board
+   m_hash_history.assign(1, hash());
+}
+
 void State::_fill_dead_pieces()
 {  // fill the dead pieces counter of each team if this is already an advanced configuration
-   auto counters = config().token_counters;
+   auto counters = config().token_counters();
    for(const auto &piece_opt : board()) {
       if(piece_opt.has_value()) {
          const auto &piece = piece_opt.value();
@@ -131,17 +208,4 @@ Status State::status()
    return m_status;
 }
 
-State::State(const State &state)
-    : State(
-       state.config(),
-       state.graveyard(),
-       state.logic()->clone(),
-       state.board(),
-       state.turn_count(),
-       state.history(),
-       state.rng()
-    )
-{
-}
-
 }  // namespace stratego
@@ -0,0 +1,47 @@
+#include "stratego/Zobrist.hpp"
+
+namespace stratego {
+
+namespace {
+
+/// the splitmix64 generator, which is enough to draw well-mixed keys from a fixed seed
+uint64_t splitmix64(uint64_t &state)
+{
+   uint64_t z = (state += 0x9e3779b97f4a7c15);
+   z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+   z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+   return z ^ (z >> 31);
+}
+
+}  // namespace
+
+ZobristKeys::ZobristKeys(std::array< size_t, 2 > game_dims)
+    : m_n_cols(game_dims[1]),
+      m_n_squares(game_dims[0] * game_dims[1]),
+      m_keys(m_n_squares * 2 * n_slots * 2)
+{
+   uint64_t state = 0x5354524154454730;
+   for(auto &key : m_keys) {
+      key = splitmix64(state);
+   }
+   m_side = splitmix64(state);
+   m_move_seed = splitmix64(state);
+}
+
+uint64_t ZobristKeys::move_key(
+   size_t turn,
+   const Position2D &from,
+   const Position2D &to,
+   std::optional< Token > revealed
+) const
+{
+   // the unknown slot stands for no revealed token
+   auto slot = revealed.has_value() ? static_cast< size_t >(*revealed) : unknown_slot;
+   uint64_t state = m_move_seed
+                    ^ (((uint64_t(turn) * m_n_squares + index(from)) * m_n_squares + index(to))
+                          * n_slots
+                       + slot);
+   return splitmix64(state);
+}
+
+}  // namespace stratego
@@ -35,7 +35,6 @@ template < class StateType >
 class RandomAgent: public Agent< StateType > {
    using base_type = Agent< StateType >;
    using base_type::base_type;
-   using Action = typename base_type::Action;
 
   public:
    explicit RandomAgent(Team team, unsigned int seed = std::random_device{}())
@@ -46,11 +45,7 @@ class RandomAgent: public Agent< StateType > {
    Action decide_action(const StateType & /*state*/, const std::vector< Action > &poss_moves)
       override
    {
-      std::vector< Action > selected_move;
-      selected_move.reserve(1);
-      std::sample(poss_moves.begin(), poss_moves.end(), std::back_inserter(selected_move), 1, mt);
-
-      return selected_move[0];
+      return poss_moves[std::uniform_int_distribution< size_t >(0, poss_moves.size() - 1)(mt)];
    }
 
   private:
@@ -104,7 +99,6 @@ template < class StateType >
 class InputAgent: public Agent< StateType > {
    using base_type = Agent< StateType >;
    using base_type::base_type;
-   using Action = typename base_type::Action;
 
   public:
    explicit InputAgent(
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "State.hpp"
+#include "StrategoDefs.hpp"
+
+namespace stratego {
+
+namespace detail {
+class DealSampler;
+}
+
+/**
+ * @brief Tracks the tokens that each piece of the opponent can still be, as seen by one team.
+ *
+ * Every opponent piece holds a bitset of its candidate tokens. Moves rule out the tokens that
+ * cannot move (or not as far), fights reveal the tokens of the fighting pieces and dead pieces
+ * leave the counts of the tokens still alive. After every change the counts are propagated: a
+ * token whose alive pieces are all known is ruled out for the others, and a token that only as
+ * many pieces can be as it has alive pieces is fixed on them.
+ *
+ * The tracker is updated with the records that the history gained since the last update, so that
+ * it need not be rebuilt for every decision. Determinizations are drawn uniformly from all deals of
+ * the tokens that respect the candidate sets (see `determinize_into`). The deal counts only depend
+ * on the beliefs, so they are computed once per update and every determinization merely draws.
+ */
+class BeliefTracker {
+  public:
+   /// the bitset of candidate tokens, with bit i standing for the token of value i
+   using token_set = uint16_t;
+
+   /// builds the beliefs of the observer from the start of the state's history
+   BeliefTracker(const State &state, Team observer);
+
+   /**
+    * @brief Applies the moves that the state's history gained since the last update.
+    *
+    * A state that is not a continuation of the tracked one (e.g. its moves were undone) rebuilds
+    * the beliefs.
+    */
+   void update(const State &state);
+
+   [[nodiscard]] auto observer() const { return m_observer; }
+   /// the candidate tokens of the opponent piece on the given square (none for other squares)
+   [[nodiscard]] std::optional< token_set > candidates(const Position2D &pos) const;
+   /// the number of alive opponent pieces of the token
+   [[nodiscard]] unsigned int alive(Token token) const
+   {
+      return m_alive[static_cast< size_t >(token)];
+   }
+
+   /**
+    * @brief Deals the tokens of the opponent's hidden pieces on the world's board anew.
+    *
+    * The deal is drawn uniformly from all deals of the undealt tokens in which every piece
+    * receives one of its candidates. Pieces of equal candidates and tokens that are candidates of
+    * the same pieces cannot be told apart by the beliefs, so the deals are counted over these
+    * groups (by a recursion memoized on the tokens left per group) rather than enumerated. The
+    * counts are built by the last update, so the world has to be the tracked state or a
+    * determinization of it.
+    *
+    * @throws std::logic_error if no deal respects the candidates of all hidden pieces
+    */
+   void determinize_into(State &world, common::RNG &rng) const;
+   /// a copy of the state with the opponent's hidden pieces dealt anew (see `determinize_into`)
+   [[nodiscard]] State determinize(const State &state, common::RNG &rng) const
+   {
+      State world = state;
+      determinize_into(world, rng);
+      return world;
+   }
+
+   static constexpr token_set bit(Token token)
+   {
+      return static_cast< token_set >(1u << static_cast< unsigned int >(token));
+   }
+
+  private:
+   Team m_observer;
+   sptr< const Config > m_config;
+   /// the tracked pieces' candidate tokens (0 once the piece died) and squares
+   std::vector< token_set > m_candidates;
+   std::vector< Position2D > m_positions;
+   /// the index of the tracked piece on each square, -1 if there is none
+   std::vector< int > m_piece_at;
+   std::array< unsigned int, n_tokens > m_alive{};
+   /// the pieces that are still alive
+   std::vector< size_t > m_alive_pieces;
+   /// the number of history records applied and the last of them
+   size_t m_n_records = 0;
+   std::optional< MoveRecord > m_last_record;
+   /// the alive pieces that are hidden in the tracked state and the sampler of their deals
+   std::vector< size_t > m_hidden;
+   sptr< const detail::DealSampler > m_sampler;
+
+   [[nodiscard]] size_t _index(const Position2D &pos) const
+   {
+      return size_t(pos[0]) * m_config->game_dims()[1] + size_t(pos[1]);
+   }
+   void _apply(const MoveRecord &record);
+   void _reveal(size_t piece, Token token) { m_candidates[piece] = bit(token); }
+   void _kill(size_t piece, Token token);
+   void _propagate();
+   void _prepare_deals(const State &state);
+};
+
+}  // namespace stratego
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Piece.hpp"
+#include "StrategoDefs.hpp"
+
+namespace stratego {
+
+/**
+ * @brief A set of squares of a board with at most 128 squares, stored as two 64 bit words.
+ *
+ * The square (x, y) of a board with n columns has the index x * n + y. The largest predefined
+ * board (10x10) thus takes up the first 100 bits.
+ */
+class Bitboard {
+  public:
+   static constexpr size_t max_squares = 128;
+
+   constexpr Bitboard() = default;
+   constexpr Bitboard(uint64_t low, uint64_t high) : m_words{low, high} {}
+
+   static constexpr Bitboard square(size_t index)
+   {
+      Bitboard board;
+      board.set(index);
+      return board;
+   }
+   /// the set of all squares with an index below the given one
+   static constexpr Bitboard below(size_t index)
+   {
+      if(index >= max_squares) {
+         return {~uint64_t(0), ~uint64_t(0)};
+      }
+      if(index >= 64) {
+         return {~uint64_t(0), (uint64_t(1) << (index - 64)) - 1};
+      }
+      return {(uint64_t(1) << index) - 1, 0};
+   }
+
+   [[nodiscard]] constexpr bool test(size_t index) const
+   {
+      return (m_words[index >> 6] >> (index & 63)) & 1u;
+   }
+   constexpr void set(size_t index) { m_words[index >> 6] |= uint64_t(1) << (index & 63); }
+   constexpr void reset(size_t index) { m_words[index >> 6] &= ~(uint64_t(1) << (index & 63)); }
+
+   [[nodiscard]] constexpr bool any() const { return (m_words[0] | m_words[1]) != 0; }
+   [[nodiscard]] constexpr bool none() const { return not any(); }
+   [[nodiscard]] constexpr size_t count() const
+   {
+      return size_t(std::popcount(m_words[0]) + std::popcount(m_words[1]));
+   }
+   /// the lowest index in the set, which must not be empty
+   [[nodiscard]] constexpr size_t lowest() const
+   {
+      if(m_words[0] != 0) {
+         return size_t(std::countr_zero(m_words[0]));
+      }
+      return 64 + size_t(std::countr_zero(m_words[1]));
+   }
+   /// the highest index in the set, which must not be empty
+   [[nodiscard]] constexpr size_t highest() const
+   {
+      if(m_words[1] != 0) {
+         return 127 - size_t(std::countl_zero(m_words[1]));
+      }
+      return 63 - size_t(std::countl_zero(m_words[0]));
+   }
+   /// removes the lowest index from the set and returns it
+   constexpr size_t pop_lowest()
+   {
+      auto index = lowest();
+      auto &word = m_words[index >> 6];
+      word &= word - 1;
+      return index;
+   }
+
+   constexpr Bitboard operator&(const Bitboard &other) const
+   {
+      return {m_words[0] & other.m_words[0], m_words[1] & other.m_words[1]};
+   }
+   constexpr Bitboard operator|(const Bitboard &other) const
+   {
+      return {m_words[0] | other.m_words[0], m_words[1] | other.m_words[1]};
+   }
+   constexpr Bitboard operator^(const Bitboard &other) const
+   {
+      return {m_words[0] ^ other.m_words[0], m_words[1] ^ other.m_words[1]};
+   }
+   constexpr Bitboard operator~() const { return {~m_words[0], ~m_words[1]}; }
+   constexpr Bitboard &operator&=(const Bitboard &other) { return *this = *this & other; }
+   constexpr Bitboard &operator|=(const Bitboard &other) { return *this = *this | other; }
+   constexpr Bitboard &operator^=(const Bitboard &other) { return *this = *this ^ other; }
+   constexpr Bitboard operator<<(size_t shift) const
+   {
+      if(shift == 0) {
+         return *this;
+      }
+      if(shift >= max_squares) {
+         return {};
+      }
+      if(shift >= 64) {
+         return {0, m_words[0] << (shift - 64)};
+      }
+      return {m_words[0] << shift, (m_words[1] << shift) | (m_words[0] >> (64 - shift))};
+   }
+   constexpr Bitboard operator>>(size_t shift) const
+   {
+      if(shift == 0) {
+         return *this;
+      }
+      if(shift >= max_squares) {
+         return {};
+      }
+      if(shift >= 64) {
+         return {m_words[1] >> (shift - 64), 0};
+      }
+      return {(m_words[0] >> shift) | (m_words[1] << (64 - shift)), m_words[1] >> shift};
+   }
+   constexpr bool operator==(const Bitboard &other) const = default;
+
+  private:
+   std::array< uint64_t, 2 > m_words{};
+};
+
+/**
+ * @brief The precomputed tables of bitboard move generation for a board of at most 128 squares.
+ *
+ * For every square and direction it holds the ray of squares up to the board's edge. The squares
+ * a piece can reach are then the ray cut off behind its first blocker, without walking the board
+ * square by square. The move distances that the config compiled from its move range predicates are
+ * kept as one set per token.
+ */
+class MoveTables {
+  public:
+   enum class Direction : uint8_t { x_down = 0, x_up = 1, y_down = 2, y_up = 3 };
+   static constexpr std::array directions{
+      Direction::x_down, Direction::x_up, Direction::y_down, Direction::y_up};
+
+   MoveTables(
+      std::array< size_t, 2 > game_dims,
+      const std::array< std::vector< bool >, n_tokens > &move_distances
+   );
+
+   /// whether a board of the given dimensions fits into a bitboard
+   static bool fits(std::array< size_t, 2 > game_dims)
+   {
+      return game_dims[0] * game_dims[1] <= Bitboard::max_squares;
+   }
+
+   [[nodiscard]] size_t index(const Position2D &pos) const
+   {
+      return size_t(pos[0]) * m_n_cols + size_t(pos[1]);
+   }
+   [[nodiscard]] Position2D position(size_t index) const
+   {
+      return {int(index / m_n_cols), int(index % m_n_cols)};
+   }
+   [[nodiscard]] size_t n_squares() const { return m_rays.size(); }
+   [[nodiscard]] const Bitboard &squares() const { return m_squares; }
+   [[nodiscard]] const Bitboard &ray(size_t square, Direction direction) const
+   {
+      return m_rays[square][static_cast< size_t >(direction)];
+   }
+   /// the distances (as indices of the set) that the token may move in a single turn
+   [[nodiscard]] const Bitboard &distances(Token token) const
+   {
+      return m_distances[static_cast< size_t >(token)];
+   }
+
+   /**
+    * @brief The squares a token on the given square can move to in the given direction.
+    *
+    * The walk stops at the first occupied square, which is included (to be attacked, or excluded
+    * by the caller if it holds an own piece or a hole).
+    */
+   [[nodiscard]] Bitboard targets(
+      size_t square,
+      Direction direction,
+      Token token,
+      const Bitboard &occupied
+   ) const;
+
+  private:
+   size_t m_n_cols;
+   Bitboard m_squares;
+   std::vector< std::array< Bitboard, 4 > > m_rays;
+   std::array< Bitboard, n_tokens > m_distances;
+   /// the largest distance of each token, if it may move any distance up to it
+   std::array< std::optional< size_t >, n_tokens > m_contiguous_range;
+
+   [[nodiscard]] size_t _step(Direction direction) const
+   {
+      return direction == Direction::x_down or direction == Direction::x_up ? m_n_cols : 1;
+   }
+   [[nodiscard]] static bool _ascending(Direction direction)
+   {
+      return direction == Direction::x_up or direction == Direction::y_up;
+   }
+};
+
+/**
+ * @brief The bitboard representation of the pieces on a board.
+ *
+ * Holds the squares of each team, of each token of a team, the revealed pieces of each team and
+ * the holes. It mirrors the piece board of a state and is kept in sync by it.
+ */
+class PieceBitboards {
+  public:
+   void clear() { *this = PieceBitboards{}; }
+
+   /// sets the square to the given piece (or empties it)
+   void place(size_t square, const std::optional< Piece > &piece_opt)
+   {
+      remove(square);
+      if(not piece_opt.has_value()) {
+         return;
+      }
+      const auto &piece = piece_opt.value();
+      if(piece.token() == Token::hole) {
+         m_holes.set(square);
+         return;
+      }
+      auto team = static_cast< size_t >(piece.team());
+      m_pieces[team].set(square);
+      m_tokens[team][static_cast< size_t >(piece.token())].set(square);
+      if(not piece.flag_hidden()) {
+         m_revealed[team].set(square);
+      }
+   }
+   void remove(size_t square)
+   {
+      m_holes.reset(square);
+      for(size_t team = 0; team < 2; team++) {
+         if(m_pieces[team].test(square)) {
+            m_pieces[team].reset(square);
+            m_revealed[team].reset(square);
+            for(auto &token_board : m_tokens[team]) {
+               token_board.reset(square);
+            }
+         }
+      }
+   }
+
+   [[nodiscard]] const Bitboard &pieces(Team team) const
+   {
+      return m_pieces[static_cast< size_t >(team)];
+   }
+   [[nodiscard]] const Bitboard &pieces(Team team, Token token) const
+   {
+      return m_tokens[static_cast< size_t >(team)][static_cast< size_t >(token)];
+   }
+   [[nodiscard]] const Bitboard &revealed(Team team) const
+   {
+      return m_revealed[static_cast< size_t >(team)];
+   }
+   [[nodiscard]] Bitboard hidden(Team team) const { return pieces(team) & ~revealed(team); }
+   [[nodiscard]] const Bitboard &holes() const { return m_holes; }
+   [[nodiscard]] Bitboard occupied() const { return m_pieces[0] | m_pieces[1] | m_holes; }
+
+   bool operator==(const PieceBitboards &other) const = default;
+
+  private:
+   std::array< Bitboard, 2 > m_pieces{};
+   std::array< std::array< Bitboard, n_tokens >, 2 > m_tokens{};
+   std::array< Bitboard, 2 > m_revealed{};
+   Bitboard m_holes{};
+};
+
+}  // namespace stratego
@@ -1,19 +1,33 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <functional>
 #include <map>
+#include <optional>
 #include <range/v3/all.hpp>
 #include <set>
+#include <stdexcept>
 #include <utility>
 #include <variant>
+#include <vector>
 
+#include "Bitboard.hpp"
+#include "Setup.hpp"
 #include "StrategoDefs.hpp"
 #include "Utils.hpp"
+#include "Zobrist.hpp"
 
 namespace stratego {
 
 auto default_move_ranges() -> std::map< Token, std::function< bool(size_t) > >;
 
+/// whether each token may move each distance from 0 up to the longest move on the board
+auto compile_move_distances(
+   std::array< size_t, 2 > game_dims,
+   const std::map< Token, std::function< bool(size_t) > >& move_ranges
+) -> std::array< std::vector< bool >, n_tokens >;
+
 auto default_battlematrix() -> std::map< std::pair< Token, Token >, FightOutcome >;
 
 struct Config {
@@ -28,26 +42,90 @@ struct Config {
    Team starting_team;
    /// whether the starting team is always the same
    bool fixed_starting_team;
-   /// the board dimensions in (x,y)
-   std::array< size_t, 2 > game_dims;
    /// the maximum number of turns to play before the game is counted as a draw
    size_t max_turn_count;
    /// whether a given setup in the config is to be seen as fixed (no resampling on reset)
    std::array< bool, 2 > fixed_setups;
    /// an optional setup for each team
    std::map< Team, std::optional< setup_t > > setups;
+   /// the positions of the holes for the gane
+   std::vector< Position2D > hole_positions;
+
+   /// the board dimensions in (x,y)
+   [[nodiscard]] const auto& game_dims() const { return m_game_dims; }
    /// the tokens that each player gets to place on the board
-   std::map< Team, token_counter_t > token_counters;
+   [[nodiscard]] const auto& token_counters() const { return m_token_counters; }
    /// the start positions that each team can use to place tokens
-   std::map< Team, std::vector< Position2D > > start_fields;
+   [[nodiscard]] const auto& start_fields() const { return m_start_fields; }
    /// the battle matrix determining outcomes of token fights
-   std::map< std::pair< Token, Token >, FightOutcome > battle_matrix;
-   /// the positions of the holes for the gane
-   std::vector< Position2D > hole_positions;
+   [[nodiscard]] const auto& battle_matrix() const { return m_battle_matrix; }
    /// holds a predicate for each token to check if a given distance is within move range
-   std::map< Token, std::function< bool(size_t) > > move_ranges;
+   [[nodiscard]] const auto& move_ranges() const { return m_move_ranges; }
+   /// the space of setups of each team's tokens on its start fields (for ranking and sampling)
+   [[nodiscard]] const auto& setup_spaces() const { return m_setup_spaces; }
+   /// the bitboard move generation tables, null for boards too large
+   [[nodiscard]] const auto& move_tables() const { return m_move_tables; }
+   /// the keys for Zobrist hashing the boards of this game
+   [[nodiscard]] const auto& zobrist_keys() const { return m_zobrist_keys; }
+   /// the largest distance each token can move on the board
+   [[nodiscard]] const auto& max_move_ranges() const { return m_max_move_ranges; }
+   /// whether each token can move every distance up to its largest one, so that the predicate of
+   /// its move range need not be asked
+   [[nodiscard]] const auto& full_move_ranges() const { return m_full_move_ranges; }
+
+   [[nodiscard]] FightOutcome fight_outcome(Token attacker, Token defender) const
+   {
+      auto attacker_index = static_cast< size_t >(attacker);
+      auto defender_index = static_cast< size_t >(defender);
+      if(attacker_index >= n_tokens or defender_index >= n_tokens) {
+         return m_battle_matrix.at({attacker, defender});
+      }
+      const auto& outcome = m_fight_outcomes[attacker_index][defender_index];
+      if(not outcome.has_value()) {
+         throw std::out_of_range("The battle matrix holds no outcome for this fight.");
+      }
+      return *outcome;
+   }
+   [[nodiscard]] bool in_move_range(Token token, size_t distance) const
+   {
+      auto token_index = static_cast< size_t >(token);
+      if(token_index >= n_tokens) {
+         return m_move_ranges.at(token)(distance);
+      }
+      const auto& distances = m_move_distances[token_index];
+      return distance < distances.size() and distances[distance];
+   }
 
   private:
+   // The tables below are compiled from the game's rules on construction and shared by every
+   // State (and config copy), so neither the rules nor the tables may change afterwards.
+
+   /// the board dimensions in (x,y)
+   std::array< size_t, 2 > m_game_dims;
+   /// the tokens that each player gets to place on the board
+   std::map< Team, token_counter_t > m_token_counters;
+   /// the start positions that each team can use to place tokens
+   std::map< Team, std::vector< Position2D > > m_start_fields;
+   /// the battle matrix determining outcomes of token fights (the input form of `m_fight_outcomes`)
+   std::map< std::pair< Token, Token >, FightOutcome > m_battle_matrix;
+   /// holds a predicate for each token to check if a given distance is within move range (the
+   /// input form of `m_move_distances`)
+   std::map< Token, std::function< bool(size_t) > > m_move_ranges;
+   /// the keys for Zobrist hashing the boards of this game
+   sptr< const ZobristKeys > m_zobrist_keys;
+   /// the space of setups of each team's tokens on its start fields
+   std::map< Team, sptr< const SetupSpace > > m_setup_spaces;
+   /// the bitboard move generation tables (compiled from the above), null for boards too large
+   sptr< const MoveTables > m_move_tables;
+   /// the battle matrix as a dense (attacker, defender) table, empty where it has no outcome
+   std::array< std::array< std::optional< FightOutcome >, n_tokens >, n_tokens > m_fight_outcomes;
+   /// whether each token may move each distance on the board (indexed by the distance)
+   std::array< std::vector< bool >, n_tokens > m_move_distances;
+   /// the largest distance each token can move on the board
+   std::array< size_t, n_tokens > m_max_move_ranges;
+   /// whether each token can move every distance up to its largest one
+   std::array< bool, n_tokens > m_full_move_ranges;
+
    template < typename T, typename U >
    static std::map< Team, std::optional< setup_t > > _init_setups(
       const std::map< Team, std::optional< setup_t > >& setups_,
@@ -71,6 +149,9 @@ struct Config {
       game_dim_variant_t game_dims_
    );
 
+   /// compiles the battle matrix and move ranges into their dense tables and the move tables
+   void _compile_tables();
+
   public:
    template < common::StringLiteral arg >
    static auto nullarg();
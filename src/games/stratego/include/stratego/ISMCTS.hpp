@@ -0,0 +1,95 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Action.hpp"
+#include "Agent.h"
+#include "Belief.hpp"
+#include "Playout.hpp"
+#include "State.hpp"
+#include "StrategoDefs.hpp"
+
+namespace stratego {
+
+struct ISMCTSConfig {
+   /// the time to search for each decision (none for no time limit)
+   std::optional< std::chrono::milliseconds > time_budget = std::chrono::milliseconds(100);
+   /// the number of search iterations of each thread for each decision (0 for no limit)
+   size_t max_iterations = 0;
+   /// the number of threads searching in parallel (0 uses all hardware threads)
+   size_t n_threads = 1;
+   /// the exploration constant of the UCB selection
+   double exploration = 0.7;
+   size_t seed = 0;
+   /// whether to keep the subtree of the moves played since the last decision
+   bool reuse_tree = true;
+};
+
+/**
+ * @brief An agent choosing its moves by single-observer Information-Set MCTS.
+ *
+ * The tree holds the moves of both teams as seen by the agent, so that each node stands for an
+ * information set of it. Every iteration samples a determinization of the opponent's hidden pieces
+ * from the agent's beliefs (which are updated once per decision), descends the tree with the moves
+ * that are valid in it (selecting by UCB among the available children), expands one move and
+ * finishes the game with a random playout.
+ *
+ * The search is root-parallel: every thread grows a tree of its own and the decision sums their
+ * root visit counts. The trees are kept between decisions and the subtree of the moves played in
+ * the meantime is searched on.
+ */
+class ISMCTSAgent: public Agent< State > {
+  public:
+   struct Node {
+      /// the move leading to this node (none for the root)
+      std::optional< Action > action;
+      /// the team that played the move
+      Team team;
+      /// the summed playout rewards of the team, with 1 for a win, 0.5 for a tie and 0 for a loss
+      double reward = 0.;
+      size_t visits = 0;
+      /// how often the move was valid when this node's parent was visited
+      size_t availability = 0;
+      std::vector< uptr< Node > > children{};
+
+      [[nodiscard]] Node *child(const Action &action) const;
+   };
+
+   ISMCTSAgent(Team team, ISMCTSConfig config);
+
+   Action decide_action(const State &state, const std::vector< Action > &poss_moves) override;
+
+   /**
+    * @brief Samples the hidden pieces of the observer's opponent.
+    *
+    * The tokens of the opponent's hidden pieces are dealt out anew from the beliefs of the observer
+    * (see `BeliefTracker::determinize_into`), which are built from the state's history for this
+    * one call. Every piece receives a token that its observed moves and fights allow.
+    *
+    * @throws std::logic_error if no deal respects the observations
+    */
+   static State determinize(const State &state, Team observer, common::RNG &rng);
+
+   /// the root of the search tree of the given thread
+   [[nodiscard]] const Node *root(size_t thread = 0) const
+   {
+      return thread < m_trees.size() ? m_trees[thread].get() : nullptr;
+   }
+
+  private:
+   ISMCTSConfig m_config;
+   std::vector< uptr< Node > > m_trees;
+   /// the beliefs about the opponent's pieces as of the last decision
+   std::optional< BeliefTracker > m_beliefs;
+   /// the turn count of the state the trees were last searched from
+   std::optional< size_t > m_root_turn;
+   size_t m_n_decisions = 0;
+
+   void _advance_trees(const State &state, size_t n_threads);
+   void _iterate(Node &root, const State &state, RandomPlayout &playout) const;
+};
+
+}  // namespace stratego
@@ -36,9 +36,24 @@ class Logic {
    auto _valid_vectors(Position2D pos, Range shape, int distance = 1);
 
    std::vector< Action > valid_actions(const State &state, Team team);
+   /// the valid actions found by checking every move within range of each piece on the board.
+   /// This is what `valid_actions` falls back to for boards too large for bitboards.
+   std::vector< Action > scan_valid_actions(const State &state, Team team);
 
    bool has_valid_actions(const State &state, Team team);
 
+   /**
+    * @brief Writes the (from, to) square indices of every valid move of the team into the buffer.
+    *
+    * The buffer is cleared first and keeps its capacity, so that repeated calls allocate nothing.
+    * Requires the config to provide move tables.
+    */
+   static void valid_moves(
+      const State &state,
+      Team team,
+      std::vector< std::array< size_t, 2 > > &moves
+   );
+
    void reset(State &state);
 
    static std::map< Position2D, Token >
@@ -67,7 +82,7 @@ class Logic {
 
    static FightOutcome fight(const Config &config, const std::pair< Token, Token > &att_def)
    {
-      return config.battle_matrix.at(att_def);
+      return config.fight_outcome(att_def.first, att_def.second);
    }
 
    static void update_board(Board &board, const Position2D &new_pos, Piece &piece)
@@ -134,8 +149,46 @@ class Logic {
    static void place_holes(const Config &cfg, Board &board);
 
    static std::map< Team, std::map< Position2D, Token > > extract_setup(const Board &board);
+
+  private:
+   /**
+    * @brief Calls the visitor with the (from, to) square indices of every valid move of the team.
+    *
+    * Moves are generated from the bitboards of the state, which requires the config to provide
+    * move tables. The visitor returns whether to stop, and so does this function.
+    */
+   template < typename Visitor >
+   static bool _visit_moves(const State &state, Team team, Visitor &&visitor);
 };
 
+template < typename Visitor >
+bool Logic::_visit_moves(const State &state, Team team, Visitor &&visitor)
+{
+   const auto &tables = *state.config().move_tables();
+   const auto &bitboards = state.bitboards();
+   const auto occupied = bitboards.occupied();
+   // neither own pieces nor holes can be moved onto
+   const auto blocked = bitboards.pieces(team) | bitboards.holes();
+   for(size_t token_index = 0; token_index < n_tokens; token_index++) {
+      auto token = Token(token_index);
+      if(tables.distances(token).none()) {
+         continue;
+      }
+      for(auto pieces = bitboards.pieces(team, token); pieces.any();) {
+         auto from = pieces.pop_lowest();
+         for(auto direction : MoveTables::directions) {
+            auto targets = tables.targets(from, direction, token, occupied) & ~blocked;
+            while(targets.any()) {
+               if(visitor(from, targets.pop_lowest())) {
+                  return true;
+               }
+            }
+         }
+      }
+   }
+   return false;
+}
+
 template < ranges::contiguous_range Range >
 auto Logic::_valid_vectors(Position2D pos, Range shape, int distance)
 {
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "Action.hpp"
+#include "State.hpp"
+#include "StrategoDefs.hpp"
+
+namespace stratego {
+
+/**
+ * @brief Plays games to their end with uniformly random moves of both teams.
+ *
+ * Built for rollout throughput: the moves are generated from the bitboards of the state into a
+ * buffer owned by the playout and the history of the state is reserved up to the maximum turn
+ * count, so that a playout allocates nothing per move. Boards too large for bitboards fall back to
+ * `Logic::valid_actions`.
+ */
+class RandomPlayout {
+  public:
+   explicit RandomPlayout(common::RNG rng) : m_rng(std::move(rng)) {}
+   explicit RandomPlayout(size_t seed) : m_rng(seed) {}
+
+   /// plays the state to its end and returns its final status
+   Status run(State &state);
+
+   /**
+    * @brief Runs random playouts from the given state across threads.
+    *
+    * Playout i draws its moves from an RNG seeded with `seed + i`, so that the outcomes do not
+    * depend on the number of threads. Every thread copies the state once and rewinds its copy by
+    * undoing the moves after each playout.
+    *
+    * @param n_threads the number of worker threads (0 uses all hardware threads)
+    * @return the final status of each playout
+    */
+   static std::vector< Status > run_batch(
+      const State &state,
+      size_t n_playouts,
+      size_t seed,
+      size_t n_threads = 0
+   );
+
+   auto &rng() { return m_rng; }
+
+  private:
+   common::RNG m_rng;
+   /// the move buffer of bitboard move generation
+   std::vector< std::array< size_t, 2 > > m_moves;
+   /// the action buffer of the fallback move generation
+   std::vector< Action > m_actions;
+};
+
+}  // namespace stratego
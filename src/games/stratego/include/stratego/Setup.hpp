@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <vector>
+
+#include "StrategoDefs.hpp"
+
+namespace stratego {
+
+/**
+ * @brief The index of a setup in its setup space.
+ *
+ * The number of setups of the full 10x10 game (about 1.4e33) exceeds 64 bits, so the index is a
+ * 128 bit unsigned integer of two words. Only the arithmetic that ranking needs is supported.
+ */
+struct SetupIndex {
+   uint64_t high = 0;
+   uint64_t low = 0;
+
+   constexpr SetupIndex() = default;
+   constexpr SetupIndex(uint64_t value) : low(value) {}
+   constexpr SetupIndex(uint64_t high_, uint64_t low_) : high(high_), low(low_) {}
+
+   SetupIndex &operator+=(const SetupIndex &other)
+   {
+      low += other.low;
+      high += other.high + static_cast< uint64_t >(low < other.low);
+      return *this;
+   }
+   SetupIndex &operator-=(const SetupIndex &other)
+   {
+      high -= other.high + static_cast< uint64_t >(low < other.low);
+      low -= other.low;
+      return *this;
+   }
+   friend SetupIndex operator+(SetupIndex lhs, const SetupIndex &rhs) { return lhs += rhs; }
+   friend SetupIndex operator-(SetupIndex lhs, const SetupIndex &rhs) { return lhs -= rhs; }
+
+   /// multiplies by a factor and exactly divides by a divisor (throws if the product does not fit
+   /// in 128 bits, asserts that the division leaves no remainder)
+   [[nodiscard]] SetupIndex scaled(uint32_t factor, uint32_t divisor) const;
+
+   auto operator<=>(const SetupIndex &other) const = default;
+};
+
+/**
+ * @brief The space of all setups of one team's tokens on its start fields.
+ *
+ * A setup is a vector of tokens aligned with the (sorted) start fields. The setups are ranked as
+ * the permutations of the token multiset in lexicographic order, so that every setup maps to a
+ * unique index below `size()` and back. Ranking, unranking and uniform sampling take O(pieces)
+ * steps and allocate nothing.
+ */
+class SetupSpace {
+  public:
+   using token_counter_t = std::map< Token, unsigned int >;
+
+   SetupSpace(std::vector< Position2D > fields, const token_counter_t &tokens);
+
+   /// the start fields in ascending order, which the tokens of a setup are aligned to
+   [[nodiscard]] auto &fields() const { return m_fields; }
+   /// the token multiset in ascending order, which is also the setup of index 0
+   [[nodiscard]] auto &tokens() const { return m_tokens; }
+   [[nodiscard]] size_t n_pieces() const { return m_fields.size(); }
+   /// the number of distinct setups
+   [[nodiscard]] SetupIndex size() const { return m_size; }
+
+   [[nodiscard]] SetupIndex rank(std::span< const Token > setup) const;
+   [[nodiscard]] SetupIndex rank(const std::map< Position2D, Token > &setup) const;
+   void unrank(SetupIndex index, std::span< Token > setup) const;
+
+   /// draws a setup uniformly at random
+   void sample(common::RNG &rng, std::span< Token > setup) const;
+
+   [[nodiscard]] std::map< Position2D, Token > to_map(std::span< const Token > setup) const;
+
+  private:
+   std::vector< Position2D > m_fields;
+   std::vector< Token > m_tokens;
+   std::array< uint32_t, n_tokens > m_counts{};
+   SetupIndex m_size;
+
+   template < typename TokenAt >
+   SetupIndex _rank(TokenAt token_at) const;
+};
+
+struct SetupConstraints {
+   /// the start fields that the flag may be placed on (any of them if empty)
+   std::vector< Position2D > flag_fields{};
+   /// whether the start fields next to the flag have to hold bombs
+   bool bombs_around_flag = false;
+
+   /// the flag on the team's back row, i.e. the row of its start fields farthest from the centre
+   static SetupConstraints
+   flag_on_back_row(const SetupSpace &space, Team team, bool bombs_around_flag = true);
+};
+
+/**
+ * @brief Draws setups uniformly among those satisfying the constraints.
+ *
+ * The flag field is drawn weighted by the number of setups completing it, after which the forced
+ * bombs are placed and the remaining tokens are shuffled onto the remaining fields. Everything
+ * depending on the flag field is precomputed, so that a draw takes O(pieces) and allocates nothing.
+ */
+class SetupSampler {
+  public:
+   SetupSampler(const SetupSpace &space, const SetupConstraints &constraints);
+
+   void sample(common::RNG &rng, std::span< Token > setup) const;
+
+   [[nodiscard]] size_t n_pieces() const { return m_n_pieces; }
+
+  private:
+   struct FlagOption {
+      size_t flag;
+      std::vector< size_t > bombs;
+      std::vector< size_t > rest;
+   };
+   size_t m_n_pieces;
+   std::vector< FlagOption > m_options;
+   std::vector< double > m_cumulative_weights;
+   /// the tokens besides the flag, with the bombs last so that the forced ones can be cut off
+   std::vector< Token > m_rest_tokens;
+};
+
+}  // namespace stratego
@@ -1,27 +1,69 @@
 
 #pragma once
 
+#include <algorithm>
 #include <named_type.hpp>
+#include <stdexcept>
+#include <string>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "Action.hpp"
+#include "Bitboard.hpp"
 #include "Config.hpp"
 #include "Piece.hpp"
 #include "StrategoDefs.hpp"
+#include "Zobrist.hpp"
 
 namespace stratego {
 
 class Logic;
 
+/// a single move of the game as it is recorded in the history
+struct MoveRecord {
+   size_t turn;
+   Team team;
+   Action action;
+   /// the moving piece as it was before the move
+   Piece attacker;
+   /// the piece on the target square as it was before the move (if any)
+   std::optional< Piece > defender;
+   /// the outcome of the fight, if the move attacked a piece
+   std::optional< FightOutcome > fight_outcome = std::nullopt;
+
+   bool operator==(const MoveRecord &other) const = default;
+};
+
+/**
+ * @brief The append-only history of moves of a game.
+ *
+ * The records are stored contiguously in the order of their turns, so that committing and undoing
+ * the latest move are O(1) and copying a state copies a single flat buffer.
+ */
 class History {
   public:
-   auto begin() { return m_history_element.begin(); }
-   auto begin() const { return m_history_element.begin(); }
-   auto end() { return m_history_element.end(); }
-   auto end() const { return m_history_element.end(); }
+   using record_type = MoveRecord;
+
+   [[nodiscard]] auto begin() const { return m_records.begin(); }
+   [[nodiscard]] auto end() const { return m_records.end(); }
 
-   [[nodiscard]] auto &operator[](size_t turn) const { return m_history_element.at(turn); }
+   /// the record of the given turn
+   [[nodiscard]] const MoveRecord &operator[](size_t turn) const
+   {
+      if(not m_records.empty() and turn >= m_records.front().turn) {
+         // turns are usually consecutive, so that the turn's offset is its index
+         auto index = turn - m_records.front().turn;
+         if(index < m_records.size() and m_records[index].turn == turn) {
+            return m_records[index];
+         }
+      }
+      auto iter = std::ranges::lower_bound(m_records, turn, {}, &MoveRecord::turn);
+      if(iter == m_records.end() or iter->turn != turn) {
+         throw std::out_of_range("No move has been recorded for turn " + std::to_string(turn));
+      }
+      return *iter;
+   }
 
    void commit_action(
       size_t turn,
@@ -30,65 +72,47 @@ class History {
       std::pair< Piece, std::optional< Piece > > pieces
    )
    {
-      m_history_element.emplace(turn, std::tuple{team, std::move(action), std::move(pieces)});
-      m_turns.emplace_back(turn);
+      m_records.emplace_back(MoveRecord{
+         turn, team, std::move(action), std::move(pieces.first), std::move(pieces.second)});
    }
 
    void commit_action(const Board &board, Action action, size_t turn)
    {
       commit_action(turn, Team(turn % 2), action, {board[action[0]].value(), board[action[1]]});
    }
+   /// records the outcome of the fight that the latest move started
+   void commit_fight(FightOutcome outcome) { m_records.back().fight_outcome = outcome; }
 
-   auto view_team_history(Team team)
+   [[nodiscard]] auto view_team_history(Team team) const
    {
-      return ranges::views::filter(m_history_element, [&, team = team](const auto &elem_pair_view) {
-         const auto &[team_, action, pieces] = std::get< 1 >(elem_pair_view);
-         return team_ == team;
+      return ranges::views::filter(m_records, [team](const MoveRecord &record) {
+         return record.team == team;
       });
    }
 
-   auto pop_last()
-   {
-      /**
-       * @brief Remove the latest entries from the private_history. Return the
-       * contents, that were removed.
-       * @return tuple,
-       *  all removed entries in sequence: turn, team, move, pieces
-       */
-      auto turn = m_turns.back();
-      auto elem_iter = m_history_element.find(turn);
-      auto ret = std::tuple_cat(std::forward_as_tuple(turn), std::move(elem_iter->second));
-      m_turns.pop_back();
-      m_history_element.erase(elem_iter);
-      return ret;
-   }
-
-   auto view_last() const
-   {
-      /**
-       * @brief Remove the latest entries from the private_history. Return the
-       * contents, that were removed.
-       * @return tuple,
-       *  all removed entries in sequence: turn, team, move, pieces
-       */
-      if(m_turns.empty()) {
-         return m_history_element.end();
-      }
-      auto turn = m_turns.back();
-      auto ret = m_history_element.find(turn);
-      return ret;
+   /// removes the latest record and returns it
+   MoveRecord pop_last()
+   {
+      auto record = std::move(m_records.back());
+      m_records.pop_back();
+      return record;
+   }
+   /// the latest record, which must exist
+   [[nodiscard]] const MoveRecord &last() const { return m_records.back(); }
+
+   void reserve(size_t n_records) { m_records.reserve(n_records); }
+   [[nodiscard]] auto size() const { return m_records.size(); }
+   [[nodiscard]] auto empty() const { return m_records.empty(); }
+   [[nodiscard]] auto turns() const
+   {
+      return ranges::views::transform(m_records, &MoveRecord::turn);
    }
+   [[nodiscard]] auto &records() const { return m_records; }
 
-   [[nodiscard]] auto size() const { return m_turns.size(); }
-   [[nodiscard]] auto &turns() const { return m_turns; }
-   [[nodiscard]] auto &elements_map() const { return m_history_element; }
+   bool operator==(const History &other) const = default;
 
   private:
-   std::vector< size_t > m_turns{};
-   std::unordered_map<
-      size_t,
-      std::tuple< Team, Action, std::pair< Piece, std::optional< Piece > > > >
-      m_history_element{};
+   std::vector< MoveRecord > m_records{};
 };
 
 class State {
@@ -96,14 +120,25 @@ class State {
    using graveyard_type = std::map< Team, std::map< Token, unsigned int > >;
 
   private:
-   /// the specific configuration of the stratego game belonging to this state
-   Config m_config;
+   /// the specific configuration of the stratego game belonging to this state (immutable and shared
+   /// between all states of the same game, so that copies only duplicate the mutable game data)
+   sptr< const Config > m_config;
    /// the board of pieces to play on
    Board m_board;
+   /// the bitboards mirroring the board (only maintained if the config provides move tables)
+   PieceBitboards m_bitboards;
+   /// the Zobrist hash of the board, without the team to move
+   uint64_t m_hash = 0;
+   /// the Zobrist hash of the board as seen by each team (opponent's hidden tokens unknown)
+   std::array< uint64_t, 2 > m_observed_board_hashes{};
+   /// the xor of the keys of the moves each team has observed since the start of the history
+   std::array< uint64_t, 2 > m_observed_move_hashes{};
+   /// the hash of every position since the start of this state, the current one last
+   std::vector< uint64_t > m_hash_history;
    /// the graveyard of dead pieces
    graveyard_type m_graveyard;
-   /// the currently used game logic on this state
-   uptr< Logic > m_logic;
+   /// the currently used game logic on this state (stateless, hence shared between copies as well)
+   sptr< Logic > m_logic;
 
    Status m_status;
    bool m_status_checked;
@@ -116,38 +151,61 @@ class State {
    bool &status_checked() { return m_status_checked; }
    void incr_turn_count(size_t amount = 1) { m_turn_count += amount; }
 
-   [[nodiscard]] State *clone_impl() const;
-
    void _fill_dead_pieces();
+   void _xor_keys(const Piece &piece)
+   {
+      const auto &keys = *m_config->zobrist_keys();
+      m_hash ^= keys.key(piece);
+      for(auto team : {Team::BLUE, Team::RED}) {
+         m_observed_board_hashes[static_cast< size_t >(team)] ^= keys.key(piece, team);
+      }
+   }
 
   public:
+   State(
+      sptr< const Config > config,
+      graveyard_type graveyard,
+      sptr< Logic > logic,
+      Board board,
+      size_t turn_count = 0,
+      const History &history = {},
+      std::optional< std::variant< size_t, common::RNG > > seed = std::nullopt
+   );
    State(
       Config config,
       graveyard_type graveyard,
-      uptr< Logic > logic,
+      sptr< Logic > logic,
       Board board,
       size_t turn_count = 0,
       const History &history = {},
       std::optional< std::variant< size_t, common::RNG > > seed = std::nullopt
    );
 
+   /**
+    * @brief Sets up a new game of the given configuration.
+    *
+    * Setups that the config leaves open are drawn uniformly at random and recorded in a copy of the
+    * config that is private to this game. States copied from this one share that copy.
+    */
+   explicit State(
+      sptr< const Config > config,
+      std::optional< std::variant< size_t, common::RNG > > seed = std::nullopt
+   );
    explicit State(
       Config config,
       std::optional< std::variant< size_t, common::RNG > > seed = std::nullopt
    );
 
-   // definitions for these needs to be in .cpp due to Logic being an incomplete type here and
-   // uniq_ptr accessing it in its destructor
-   State(const State &);
-   State &operator=(const State &state);
-   State(State &&) noexcept = default;
-   State &operator=(State &&) noexcept = default;
-   ~State() = default;
-
    void transition(const Action &action);
    void restore_to_round(size_t round);
 
    void undo_last_rounds(size_t n = 1);
+   /// reserves the history for the given number of further turns, so that they allocate nothing
+   void reserve_history(size_t n_turns)
+   {
+      m_move_history.reserve(m_move_history.size() + n_turns);
+      m_hash_history.reserve(m_hash_history.size() + n_turns);
+   }
 
    inline auto &rng() { return m_rng; }
    inline auto &board() { return m_board; }
@@ -160,7 +218,90 @@ class State {
    [[nodiscard]] auto &history() { return m_move_history; }
    [[nodiscard]] auto board() const { return m_board; }
 
-   void board(Board &&board) { m_board = std::move(board); }
+   void board(Board &&board)
+   {
+      m_board = std::move(board);
+      sync_board();
+   }
+   [[nodiscard]] auto &bitboards() const { return m_bitboards; }
+   /// rebuilds the bitboards and hashes from the board, needed after editing the board in place
+   void sync_board();
+   /**
+    * @brief Updates the bitboards and hashes to the current piece on the given square.
+    *
+    * @param previous the piece that was on the square before the change, whose keys are removed
+    */
+   void sync_square(const Position2D &pos, const std::optional< Piece > &previous)
+   {
+      if(previous.has_value()) {
+         _xor_keys(*previous);
+      }
+      const auto &current = m_board[pos];
+      if(current.has_value()) {
+         _xor_keys(*current);
+      }
+      if(const auto *tables = m_config->move_tables().get()) {
+         m_bitboards.place(tables->index(pos), current);
+      }
+   }
+
+   /// the Zobrist hash of the world state (the board and the team to move)
+   [[nodiscard]] uint64_t hash() const
+   {
+      return m_hash ^ m_config->zobrist_keys()->side_to_move(active_team());
+   }
+   /**
+    * @brief The Zobrist hash of the board as seen by the given team and the team to move.
+    *
+    * It is equal for all boards that differ only in the tokens of the opponent that the team has
+    * not seen yet. This is not a hash of the team's information state, which also depends on the
+    * moves that led here (e.g. which hidden pieces moved and how far). Different information
+    * states with the same visible board collide, so use `infostate_hash` to key infostates.
+    */
+   [[nodiscard]] uint64_t observed_board_hash(Team team) const
+   {
+      return m_observed_board_hashes[static_cast< size_t >(team)]
+             ^ m_config->zobrist_keys()->side_to_move(active_team());
+   }
+   /**
+    * @brief The hash of the information state of the given team.
+    *
+    * Next to the board as the team sees it, it covers every move the team observed since the start
+    * of the history, i.e. the squares of each move and the opponent's tokens that fights revealed.
+    * It is therefore equal for all worlds the team cannot tell apart, but differs between histories
+    * that lead to the same visible board.
+    */
+   [[nodiscard]] uint64_t infostate_hash(Team team) const
+   {
+      return observed_board_hash(team) ^ m_observed_move_hashes[static_cast< size_t >(team)];
+   }
+   /**
+    * @brief Folds the recorded move into the hashes of the moves each team has observed.
+    *
+    * The keys are xor-ed in, so that observing the same record again takes the move back out.
+    */
+   void observe_move(const MoveRecord &record)
+   {
+      const auto &keys = *m_config->zobrist_keys();
+      const auto &move = record.action.move();
+      for(auto team : {Team::BLUE, Team::RED}) {
+         std::optional< Token > revealed = std::nullopt;
+         if(record.defender.has_value()) {
+            // a fight reveals the opponent's piece (the team knows the token of its own already)
+            const auto &opponent_piece = record.attacker.team() == team ? *record.defender
+                                                                        : record.attacker;
+            revealed = opponent_piece.token();
+         }
+         m_observed_move_hashes[static_cast< size_t >(team)] ^= keys.move_key(
+            record.turn, move[0], move[1], revealed
+         );
+      }
+   }
+   /// how often the current position has occurred before since the start of this state
+   [[nodiscard]] size_t repetitions() const
+   {
+      return size_t(std::count(m_hash_history.begin(), m_hash_history.end() - 1, hash()));
+   }
    Status status(Status status)
    {
       m_status = status;
@@ -180,10 +321,11 @@ class State {
    void transition(Move move);
    [[nodiscard]] Team active_team() const
    {
-      return Team((turn_count() + static_cast< size_t >(m_config.starting_team)) % 2);
+      return Team((turn_count() + static_cast< size_t >(m_config->starting_team)) % 2);
    }
 
-   [[nodiscard]] auto &config() const { return m_config; }
+   [[nodiscard]] const Config &config() const { return *m_config; }
+   [[nodiscard]] auto config_ptr() const { return m_config; }
    [[nodiscard]] auto *logic() const { return &*m_logic; }
    [[nodiscard]] auto &graveyard() const { return m_graveyard; }
    [[nodiscard]] auto &graveyard(Team team) const { return m_graveyard.at(team); }
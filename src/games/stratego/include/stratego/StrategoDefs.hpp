@@ -32,6 +32,8 @@ enum class Token : int8_t {
    bomb = 11,
    hole = 99
 };
+/// the number of tokens which a team can hold (flag, spy, ..., marshall, bomb)
+inline constexpr size_t n_tokens = 12;
 
 enum DefinedBoardSizes : uint8_t { small = 5, medium = 7, large = 10 };
 
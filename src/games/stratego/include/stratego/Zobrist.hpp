@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Piece.hpp"
+#include "StrategoDefs.hpp"
+
+namespace stratego {
+
+/**
+ * @brief The random keys of Zobrist hashing for the boards of one game.
+ *
+ * The hash of a board is the xor of the keys of its pieces, which are drawn per team, square,
+ * token and revealed flag. Moving, revealing or removing a piece thus updates the hash in O(1) by
+ * xor-ing the old key out and the new one in. An extra token slot stands for a hidden piece of the
+ * opponent, so that the board as seen by one team hashes the same for every assignment of the
+ * opponent's hidden tokens. The keys are generated from a fixed seed and are thus equal for every
+ * game of the same board size.
+ *
+ * Moves have keys too, which the hash of the moves a team has observed folds in turn by turn.
+ */
+class ZobristKeys {
+  public:
+   explicit ZobristKeys(std::array< size_t, 2 > game_dims);
+
+   [[nodiscard]] size_t index(const Position2D &pos) const
+   {
+      return size_t(pos[0]) * m_n_cols + size_t(pos[1]);
+   }
+
+   /// the key of a piece as it is in the world state (holes have none since they never change)
+   [[nodiscard]] uint64_t key(const Piece &piece) const
+   {
+      if(piece.token() == Token::hole) {
+         return 0;
+      }
+      auto slot = static_cast< size_t >(piece.token());
+      return _key(piece.team(), index(piece.position()), slot, not piece.flag_hidden());
+   }
+   /// the key of a piece as it is seen by the observing team
+   [[nodiscard]] uint64_t key(const Piece &piece, Team observer) const
+   {
+      if(piece.team() != observer and piece.flag_hidden() and piece.token() != Token::hole) {
+         return _key(piece.team(), index(piece.position()), unknown_slot, false);
+      }
+      return key(piece);
+   }
+   /// the key of the team to move (included for the red team only)
+   [[nodiscard]] uint64_t side_to_move(Team team) const { return team == Team::RED ? m_side : 0; }
+   /**
+    * @brief The key of a move at the given turn as one team observes it.
+    *
+    * The team observes the squares of the move and the token of the opponent's piece if the move
+    * started a fight (`revealed`). Keys of turns and moves are too many to draw upfront, so they
+    * are mixed from their inputs instead. Since the turn is part of the key, the xor of the keys
+    * of a sequence of moves depends on the order of the moves.
+    */
+   [[nodiscard]] uint64_t move_key(
+      size_t turn,
+      const Position2D &from,
+      const Position2D &to,
+      std::optional< Token > revealed
+   ) const;
+
+  private:
+   /// the slot of a hidden token of the opponent
+   static constexpr size_t unknown_slot = n_tokens;
+   static constexpr size_t n_slots = n_tokens + 1;
+
+   size_t m_n_cols;
+   size_t m_n_squares;
+   std::vector< uint64_t > m_keys;
+   uint64_t m_side;
+   uint64_t m_move_seed;
+
+   [[nodiscard]] uint64_t _key(Team team, size_t square, size_t slot, bool revealed) const
+   {
+      return m_keys[((square * 2 + static_cast< size_t >(team)) * n_slots + slot) * 2 + revealed];
+   }
+};
+
+}  // namespace stratego
@@ -1,104 +1,229 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <limits>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
+#include <ostream>
+#include <thread>
 #include <vector>
 
-#include "aze/utils/utils.h"
+#include "Agent.h"
+#include "Game.hpp"
+#include "State.hpp"
+#include "Utils.hpp"
 
 namespace arena {
 
+using stratego::Status;
+using stratego::Team;
+
+/// the result of a single game of the arena
+struct GameResult {
+   size_t game;
+   /// the seed of the game's state (and, derived from it, of its agents)
+   size_t seed;
+   /// the team that the first agent played
+   Team team;
+   Status status;
+   size_t turns;
+
+   bool operator==(const GameResult &other) const = default;
+};
+
+/// the win/draw/loss and game length statistics of an agent
 struct StatTrack {
-   int wins{0};
-   int draws{0};
-   int losses{0};
-   std::vector< int > turn_counts{};
+   size_t wins{0};
+   size_t draws{0};
+   size_t losses{0};
+   size_t total_turns{0};
+   size_t min_turns{std::numeric_limits< size_t >::max()};
+   size_t max_turns{0};
 
-   inline void add_win(int turns = 0)
+   /// adds the outcome of a game in which the agent played the given team
+   void add(Status status, Team team, size_t turns)
    {
-      wins += 1;
-      turn_counts.emplace_back(turns);
+      if(status == Status::TIE) {
+         draws++;
+      } else if((status == Status::WIN_BLUE) == (team == Team::BLUE)) {
+         wins++;
+      } else {
+         losses++;
+      }
+      total_turns += turns;
+      min_turns = std::min(min_turns, turns);
+      max_turns = std::max(max_turns, turns);
+   }
+   void merge(const StatTrack &other)
+   {
+      wins += other.wins;
+      draws += other.draws;
+      losses += other.losses;
+      total_turns += other.total_turns;
+      min_turns = std::min(min_turns, other.min_turns);
+      max_turns = std::max(max_turns, other.max_turns);
    }
-   inline void add_draw(int turns = 0)
+
+   [[nodiscard]] size_t n_games() const { return wins + draws + losses; }
+   [[nodiscard]] double mean_turns() const
    {
-      draws += 1;
-      turn_counts.emplace_back(turns);
+      return n_games() == 0 ? 0. : double(total_turns) / double(n_games());
    }
+
+   bool operator==(const StatTrack &other) const = default;
 };
 
-inline void print_round_results(
-   int round,
-   int num_rounds,
-   const std::vector< std::string > &agent_names,
-   const std::vector< StatTrack > &stats
-)
+struct PitConfig {
+   size_t n_games = 1;
+   /// game i is played with the seed `seed + i`
+   size_t seed = 0;
+   /// the number of worker threads (0 uses all hardware threads)
+   size_t n_threads = 0;
+   /// whether the agents swap teams every other game
+   bool alternate_teams = true;
+   /// if given, every game is written as a CSV row as soon as it finishes (in order of completion)
+   std::ostream *csv_stream = nullptr;
+};
+
+struct PitResults {
+   /// the statistics of the first agent (those of the second are their mirror image)
+   StatTrack stats;
+   /// the results of all games in the order of their index
+   std::vector< GameResult > games;
+};
+
+/// writes the header row of the CSV game results
+inline void write_csv_header(std::ostream &os)
 {
-   static const std::vector< std::string > colors{
-      "\033[1;31m",  // RED
-      "\033[1;34m",  // BLUE
-      "\033[1;32m",  // GREEN
-      "\033[1;33m",  // YELLOW
-      "\033[1;35m",  // MAGENTA
-      "\033[1;36m",  // CYAN
-      "\033[1;37m"};  // WHITE
-   static const std::string reset("\033[0m");
-
-   std::stringstream ss;
-   ss << "Game " << round << "/" << num_rounds;
-   std::string round_display = ss.str();
-   ss.clear();
-
-   ss << "[ ";
-   for(unsigned int i = 0; i < agent_names.size(); ++i) {
-      const auto &color = colors[i];
-      ss << "Agent " << i << " (" << color << agent_names[i] << reset << "): W: " << color
-         << stats[i].wins << reset << ", ";
-   }
-   ss << " ]";
+   os << "game,seed,team,status,turns\n";
 }
 
-template < typename T >
-inline const char *get_typename(T &object)
+/// writes a game result as a CSV row
+inline void write_csv_row(std::ostream &os, const GameResult &game)
 {
-   return typeid(object).name();
+   os << game.game << "," << game.seed << "," << common::to_string(game.team) << ","
+      << common::to_string(game.status) << "," << game.turns << "\n";
 }
 
-template < typename GameType >
-std::tuple< StatTrack, StatTrack > inline pit(
-   GameType &game,
-   int num_sims,
-   bool show_game,
-   int print_every_n_sim
+/// creates the agent playing the given team with the given seed
+using agent_factory = std::function<
+   sptr< stratego::Agent< stratego::State > >(Team team, unsigned int seed) >;
+
+/**
+ * @brief Plays games between two agents on a pool of threads.
+ *
+ * Every game creates its own state and agents from the config and the factories, so that no state
+ * is shared between threads. The state of game i is seeded with `seed + i` (which draws the setups
+ * the config leaves open) and the agents with seeds derived from it, so that the results do not
+ * depend on the number of threads. Each thread aggregates the statistics of its games on its own,
+ * which are merged once all games are played. The first exception of any game (e.g. thrown by an
+ * agent) stops the remaining games and is rethrown once all threads have joined.
+ */
+inline PitResults pit(
+   const sptr< const stratego::Config > &config,
+   const agent_factory &first,
+   const agent_factory &second,
+   const PitConfig &pit_config
 )
 {
-   StatTrack stats0;
-   StatTrack stats1;
-
-   for(int sim = 1; sim < num_sims; ++sim) {
-      game.reset();
-      SPDLOG_DEBUG("After Reset: {}", game.state()->to_string(false, false));
-      int game_outcome = game.run(show_game);
-      if(game_outcome == 1)
-         stats0.add_win("flag", game.state()->get_turn_count());
-      else if(game_outcome == 2)
-         stats0.add_win("moves", game.state()->get_turn_count());
-      else if(game_outcome == -1)
-         stats1.add_win("flag", game.state()->get_turn_count());
-      else if(game_outcome == -2)
-         stats1.add_win("moves", game.state()->get_turn_count());
-      else {
-         stats0.add_draw();
-         stats1.add_draw();
+   const size_t n_games = pit_config.n_games;
+   std::vector< GameResult > games(n_games);
+   constexpr size_t chunk_size = 16;
+   size_t n_chunks = (n_games + chunk_size - 1) / chunk_size;
+   size_t n_threads = pit_config.n_threads;
+   if(n_threads == 0) {
+      n_threads = std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+   }
+   n_threads = std::max(size_t(1), std::min(n_threads, n_chunks));
+   std::vector< StatTrack > thread_stats(n_threads);
+   std::atomic< size_t > next_chunk{0};
+   // guards the CSV stream and the first exception of any thread
+   std::mutex mutex;
+   std::exception_ptr error;
+   if(pit_config.csv_stream != nullptr) {
+      write_csv_header(*pit_config.csv_stream);
+   }
+
+   auto work = [&](size_t thread) {
+      // the stats are kept on the thread's own stack, since neighbouring entries of `thread_stats`
+      // share cache lines
+      StatTrack stats;
+      try {
+         for(size_t chunk = next_chunk++; chunk < n_chunks; chunk = next_chunk++) {
+            auto end = std::min(n_games, (chunk + 1) * chunk_size);
+            for(size_t i = chunk * chunk_size; i < end; i++) {
+               auto seed = pit_config.seed + i;
+               auto team = pit_config.alternate_teams and i % 2 == 1 ? Team::RED : Team::BLUE;
+               auto opponent_team = team == Team::BLUE ? Team::RED : Team::BLUE;
+               auto agent = first(team, static_cast< unsigned int >(2 * seed));
+               auto opponent = second(opponent_team, static_cast< unsigned int >(2 * seed + 1));
+               stratego::Game game{
+                  stratego::State{config, seed},
+                  team == Team::BLUE ? agent : opponent,
+                  team == Team::BLUE ? opponent : agent};
+               auto status = game.run(nullptr);
+               auto turns = game.state().turn_count();
+               games[i] = GameResult{i, seed, team, status, turns};
+               stats.add(status, team, turns);
+               if(pit_config.csv_stream != nullptr) {
+                  std::scoped_lock lock{mutex};
+                  write_csv_row(*pit_config.csv_stream, games[i]);
+               }
+            }
+         }
+      } catch(...) {
+         std::scoped_lock lock{mutex};
+         if(not error) {
+            error = std::current_exception();
+         }
+         next_chunk = n_chunks;
       }
-      SPDLOG_DEBUG("After game played: {}", game.state()->to_string(false, false));
-      if(sim % print_every_n_sim == 0) {
-         print_round_results(
-            sim, num_sims, *game.get_agent_0(), *game.get_agent_1(), stats0, stats1
-         );
+      thread_stats[thread] = stats;
+   };
+   {
+      std::vector< std::jthread > workers;
+      for(size_t t = 1; t < n_threads; t++) {
+         workers.emplace_back(work, t);
       }
+      work(0);
+   }
+   if(error) {
+      std::rethrow_exception(error);
+   }
+   PitResults results{{}, std::move(games)};
+   for(const auto &stats : thread_stats) {
+      results.stats.merge(stats);
+   }
+   return results;
+}
+
+/// writes the game results as CSV with a header row
+inline void write_csv(std::ostream &os, const std::vector< GameResult > &games)
+{
+   write_csv_header(os);
+   for(const auto &game : games) {
+      write_csv_row(os, game);
+   }
+}
+
+/// writes the statistics and game results as a JSON object
+inline void write_json(std::ostream &os, const PitResults &results)
+{
+   const auto &stats = results.stats;
+   os << "{\"stats\":{\"wins\":" << stats.wins << ",\"draws\":" << stats.draws
+      << ",\"losses\":" << stats.losses << ",\"mean_turns\":" << stats.mean_turns()
+      << ",\"min_turns\":" << (stats.n_games() == 0 ? 0 : stats.min_turns)
+      << ",\"max_turns\":" << stats.max_turns << "},\"games\":[";
+   for(size_t i = 0; i < results.games.size(); i++) {
+      const auto &game = results.games[i];
+      os << (i == 0 ? "" : ",") << "{\"game\":" << game.game << ",\"seed\":" << game.seed
+         << ",\"team\":\"" << common::to_string(game.team) << "\",\"status\":\""
+         << common::to_string(game.status) << "\",\"turns\":" << game.turns << "}";
    }
-   std::cout << std::endl;
-   return std::make_tuple(stats0, stats1);
+   os << "]}";
 }
 
 }  // namespace arena
@@ -3,12 +3,18 @@
 #define NOR_STRATEGO_HPP
 
 #include "Action.hpp"
+#include "Belief.hpp"
+#include "Bitboard.hpp"
 #include "Config.hpp"
 #include "Game.hpp"
+#include "ISMCTS.hpp"
 #include "Logic.hpp"
 #include "Piece.hpp"
+#include "Playout.hpp"
+#include "Setup.hpp"
 #include "State.hpp"
 #include "StrategoDefs.hpp"
 #include "Utils.hpp"
+#include "Zobrist.hpp"
 
 #endif  // NOR_STRATEGO_HPP
@@ -0,0 +1,653 @@
+#include "texas_holdem_poker/abstraction.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "texas_holdem_poker/evaluator.hpp"
+
+namespace texholdem {
+
+namespace {
+
+constexpr std::array< char, 8 > bucket_file_magic = {'N', 'O', 'R', 'B', 'U', 'C', 'K', 'T'};
+constexpr uint32_t bucket_file_version = 1;
+constexpr size_t max_buckets = size_t(std::numeric_limits< Bucket >::max()) + 1;
+
+struct BucketFileRound {
+   uint64_t size;
+   uint64_t n_buckets;
+};
+
+/// the bytes of padding that align the end of a round's buckets in the bucket file
+size_t padding_after(size_t n_round_buckets)
+{
+   auto n_bytes = n_round_buckets * sizeof(Bucket);
+   return (sizeof(uint64_t) - n_bytes % sizeof(uint64_t)) % sizeof(uint64_t);
+}
+
+size_t resolve_thread_count(size_t n_threads)
+{
+   if(n_threads != 0) {
+      return n_threads;
+   }
+   return std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+}
+
+/**
+ * Calls `func(chunk_index, begin, end)` for consecutive chunks of [0, n) of the given size. The
+ * chunks are handed out to the threads dynamically, but their boundaries only depend on `n` and
+ * `chunk_size`, so that per-chunk reductions are deterministic for any number of threads.
+ *
+ * The first exception thrown by `func` stops handing out chunks and is rethrown on the caller once
+ * all threads have finished.
+ */
+template < typename Func >
+void parallel_chunks(size_t n, size_t chunk_size, size_t n_threads, Func&& func)
+{
+   size_t n_chunks = (n + chunk_size - 1) / chunk_size;
+   std::atomic< size_t > next_chunk{0};
+   std::exception_ptr error;
+   std::mutex error_mutex;
+   auto work = [&] {
+      try {
+         for(size_t chunk = next_chunk++; chunk < n_chunks; chunk = next_chunk++) {
+            func(chunk, chunk * chunk_size, std::min(n, (chunk + 1) * chunk_size));
+         }
+      } catch(...) {
+         std::scoped_lock lock{error_mutex};
+         if(not error) {
+            error = std::current_exception();
+         }
+         next_chunk = n_chunks;
+      }
+   };
+   {
+      std::vector< std::jthread > workers;
+      n_threads = std::min(resolve_thread_count(n_threads), n_chunks);
+      for(size_t t = 1; t < n_threads; t++) {
+         workers.emplace_back(work);
+      }
+      work();
+   }
+   if(error) {
+      std::rethrow_exception(error);
+   }
+}
+
+uint64_t splitmix64(uint64_t x)
+{
+   x += 0x9e3779b97f4a7c15ull;
+   x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+   x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+   return x ^ (x >> 31);
+}
+
+/// the earth mover's distance of two histograms given as CDFs (in units of bins), abandoning the
+/// computation once it exceeds `bound`
+float emd(const float* cdf1, const float* cdf2, size_t n_bins, float bound)
+{
+   float distance = 0.f;
+   for(size_t b = 0; b < n_bins; b++) {
+      distance += std::fabs(cdf1[b] - cdf2[b]);
+      if(distance >= bound) {
+         return distance;
+      }
+   }
+   return distance;
+}
+
+/// turns consecutive histograms of n_bins values each into their CDFs in place
+void to_cdfs(std::span< float > histograms, size_t n_bins)
+{
+   for(size_t offset = 0; offset < histograms.size(); offset += n_bins) {
+      auto histogram = histograms.subspan(offset, n_bins);
+      std::partial_sum(histogram.begin(), histogram.end(), histogram.begin());
+   }
+}
+
+/// the closest of the centroid CDFs to the given CDF, starting the search from `guess`
+Bucket nearest_centroid(
+   const float* cdf,
+   const std::vector< float >& centroids,
+   size_t n_bins,
+   Bucket guess
+)
+{
+   const size_t n_clusters = centroids.size() / n_bins;
+   auto best = guess;
+   auto best_distance = emd(
+      cdf, centroids.data() + best * n_bins, n_bins, std::numeric_limits< float >::max()
+   );
+   for(size_t c = 0; c < n_clusters; c++) {
+      auto distance = emd(cdf, centroids.data() + c * n_bins, n_bins, best_distance);
+      if(distance < best_distance) {
+         best_distance = distance;
+         best = Bucket(c);
+      }
+   }
+   return best;
+}
+
+/// the label of each centroid histogram when the centroids are ordered by ascending mean equity
+std::vector< Bucket > labels_by_equity(std::span< const float > centroid_histograms, size_t n_bins)
+{
+   const size_t n_clusters = centroid_histograms.size() / n_bins;
+   std::vector< double > equities(n_clusters);
+   for(size_t c = 0; c < n_clusters; c++) {
+      equities[c] = mean_equity(centroid_histograms.subspan(c * n_bins, n_bins));
+   }
+   std::vector< size_t > order(n_clusters);
+   std::iota(order.begin(), order.end(), size_t(0));
+   std::stable_sort(order.begin(), order.end(), [&](size_t c1, size_t c2) {
+      return equities[c1] < equities[c2];
+   });
+   std::vector< Bucket > labels(n_clusters);
+   for(size_t rank = 0; rank < n_clusters; rank++) {
+      labels[order[rank]] = Bucket(rank);
+   }
+   return labels;
+}
+
+void validate_geometry(const HandIndexer& indexer)
+{
+   if(indexer.n_ranks() != n_ranks or indexer.n_suits() != n_suits) {
+      throw std::invalid_argument("Equities can only be computed for the standard 52-card deck.");
+   }
+   if(indexer.cards_until(indexer.n_rounds() - 1) > detail::max_eval_cards) {
+      throw std::invalid_argument("Equities can only be computed for hands of at most 7 cards.");
+   }
+}
+
+}  // namespace
+
+std::vector< float > equity_histogram(
+   const HandIndexer& indexer,
+   std::span< const uint8_t > card_ids,
+   const BucketingConfig& config
+)
+{
+   validate_geometry(indexer);
+   auto round = indexer.round_of(card_ids.size());
+   const auto& evaluator = HandEvaluator::instance();
+   const size_t n_hole_cards = indexer.cards_per_round()[0];
+   const size_t n_final_cards = indexer.cards_until(indexer.n_rounds() - 1);
+   const size_t n_missing = n_final_cards - card_ids.size();
+
+   CardMask hole_mask = 0;
+   CardMask known_mask = 0;
+   for(size_t i = 0; i < card_ids.size(); i++) {
+      (i < n_hole_cards ? hole_mask : known_mask) |= CardMask(1) << card_ids[i];
+   }
+   known_mask |= hole_mask;
+   std::array< uint8_t, n_cards > deck{};
+   size_t deck_size = 0;
+   for(uint8_t card = 0; card < n_cards; card++) {
+      if(not (known_mask & (CardMask(1) << card))) {
+         deck[deck_size++] = card;
+      }
+   }
+   // seeded by the hand itself, so that the histogram does not depend on the order of evaluation
+   std::mt19937_64 rng{splitmix64(config.seed ^ splitmix64(known_mask ^ (round << 56)))};
+
+   std::vector< float > histogram(config.n_histogram_bins, 0.f);
+   const size_t n_rollouts = n_missing == 0 ? 1 : config.n_rollouts;
+   for(size_t rollout = 0; rollout < n_rollouts; rollout++) {
+      // complete the board by a partial Fisher-Yates shuffle of the front of the deck
+      CardMask board_mask = known_mask & ~hole_mask;
+      for(size_t i = 0; i < n_missing; i++) {
+         std::uniform_int_distribution< size_t > pick{i, deck_size - 1};
+         std::swap(deck[i], deck[pick(rng)]);
+         board_mask |= CardMask(1) << deck[i];
+      }
+      auto own_rank = evaluator.evaluate(hole_mask | board_mask);
+      auto opponent_deck = std::span{deck}.subspan(n_missing, deck_size - n_missing);
+
+      double score = 0.;
+      size_t n_opponents = 0;
+      auto face_opponent = [&](uint8_t card1, uint8_t card2) {
+         auto opponent_rank = evaluator.evaluate(
+            (CardMask(1) << card1) | (CardMask(1) << card2) | board_mask
+         );
+         score += own_rank > opponent_rank ? 1. : own_rank == opponent_rank ? .5 : 0.;
+         n_opponents++;
+      };
+      if(config.n_opponent_samples == 0) {
+         for(size_t i = 0; i < opponent_deck.size(); i++) {
+            for(size_t j = i + 1; j < opponent_deck.size(); j++) {
+               face_opponent(opponent_deck[i], opponent_deck[j]);
+            }
+         }
+      } else {
+         std::uniform_int_distribution< size_t > pick{0, opponent_deck.size() - 1};
+         for(size_t s = 0; s < config.n_opponent_samples; s++) {
+            auto i = pick(rng);
+            auto j = pick(rng);
+            while(j == i) {
+               j = pick(rng);
+            }
+            face_opponent(opponent_deck[i], opponent_deck[j]);
+         }
+      }
+      auto equity = score / double(n_opponents);
+      auto bin = std::min(size_t(equity * double(histogram.size())), histogram.size() - 1);
+      histogram[bin] += 1.f / float(n_rollouts);
+   }
+   return histogram;
+}
+
+std::vector< float > equity_histograms(
+   const HandIndexer& indexer,
+   size_t round,
+   const BucketingConfig& config
+)
+{
+   validate_geometry(indexer);
+   const size_t n_bins = config.n_histogram_bins;
+   const size_t n_hands = indexer.round_size(round);
+   std::vector< float > histograms(n_hands * n_bins);
+   parallel_chunks(n_hands, 16, config.n_threads, [&](size_t, size_t begin, size_t end) {
+      for(size_t index = begin; index < end; index++) {
+         auto histogram = equity_histogram(indexer, indexer.unindex(round, index), config);
+         std::copy(histogram.begin(), histogram.end(), histograms.begin() + long(index * n_bins));
+      }
+   });
+   return histograms;
+}
+
+std::vector< float > equity_histograms(
+   const HandIndexer& indexer,
+   size_t round,
+   std::span< const HandIndexer::index_type > indices,
+   const BucketingConfig& config
+)
+{
+   validate_geometry(indexer);
+   const size_t n_bins = config.n_histogram_bins;
+   std::vector< float > histograms(indices.size() * n_bins);
+   parallel_chunks(indices.size(), 16, config.n_threads, [&](size_t, size_t begin, size_t end) {
+      for(size_t i = begin; i < end; i++) {
+         auto histogram = equity_histogram(indexer, indexer.unindex(round, indices[i]), config);
+         std::copy(histogram.begin(), histogram.end(), histograms.begin() + long(i * n_bins));
+      }
+   });
+   return histograms;
+}
+
+double mean_equity(std::span< const float > histogram)
+{
+   double mean = 0.;
+   for(size_t b = 0; b < histogram.size(); b++) {
+      mean += double(histogram[b]) * (double(b) + .5) / double(histogram.size());
+   }
+   return mean;
+}
+
+Clustering emd_kmeans(
+   std::span< const float > histograms,
+   size_t n_bins,
+   size_t n_clusters,
+   const BucketingConfig& config
+)
+{
+   if(n_bins == 0 or histograms.size() % n_bins != 0) {
+      throw std::invalid_argument("The histograms need to consist of n_bins values each.");
+   }
+   const size_t n_points = histograms.size() / n_bins;
+   n_clusters = std::min(n_clusters, n_points);
+   if(n_clusters == 0 or n_clusters > max_buckets) {
+      throw std::invalid_argument(
+         "The number of clusters has to be in [1, " + std::to_string(max_buckets) + "]."
+      );
+   }
+   constexpr size_t chunk_size = 1024;
+   const size_t n_chunks = (n_points + chunk_size - 1) / chunk_size;
+
+   std::vector< float > cdfs(histograms.begin(), histograms.end());
+   to_cdfs(cdfs, n_bins);
+   auto point = [&](size_t p) { return cdfs.data() + p * n_bins; };
+
+   // k-means++ seeding
+   std::mt19937_64 rng{config.seed};
+   std::vector< float > centroids(n_clusters * n_bins);
+   auto centroid = [&](size_t c) { return centroids.data() + c * n_bins; };
+   std::vector< float > min_distance(n_points, std::numeric_limits< float >::max());
+   std::vector< double > chunk_sums(n_chunks);
+   size_t chosen = std::uniform_int_distribution< size_t >{0, n_points - 1}(rng);
+   for(size_t c = 0; c < n_clusters; c++) {
+      std::copy_n(point(chosen), n_bins, centroid(c));
+      if(c + 1 == n_clusters) {
+         break;
+      }
+      auto update_distances = [&](size_t chunk, size_t begin, size_t end) {
+         double sum = 0.;
+         for(size_t p = begin; p < end; p++) {
+            min_distance[p] = std::min(
+               min_distance[p], emd(point(p), centroid(c), n_bins, min_distance[p])
+            );
+            sum += double(min_distance[p]);
+         }
+         chunk_sums[chunk] = sum;
+      };
+      parallel_chunks(n_points, chunk_size, config.n_threads, update_distances);
+      double total = std::accumulate(chunk_sums.begin(), chunk_sums.end(), 0.);
+      if(total <= 0.) {
+         // every point coincides with a centroid already
+         chosen = std::uniform_int_distribution< size_t >{0, n_points - 1}(rng);
+         continue;
+      }
+      double target = std::uniform_real_distribution< double >{0., total}(rng);
+      size_t chunk = 0;
+      while(chunk + 1 < n_chunks and target >= chunk_sums[chunk]) {
+         target -= chunk_sums[chunk++];
+      }
+      chosen = chunk * chunk_size;
+      for(size_t end = std::min(n_points, (chunk + 1) * chunk_size); chosen + 1 < end; chosen++) {
+         target -= double(min_distance[chosen]);
+         if(target < 0.) {
+            break;
+         }
+      }
+   }
+
+   // Lloyd iterations
+   Clustering clustering;
+   clustering.assignment.assign(n_points, 0);
+   std::vector< size_t > chunk_changes(n_chunks);
+   std::vector< size_t > members(n_points);
+   std::vector< size_t > cluster_begin(n_clusters + 1);
+   for(size_t iteration = 0; iteration < config.max_kmeans_iterations; iteration++) {
+      auto assign = [&](size_t chunk, size_t begin, size_t end) {
+         size_t changes = 0;
+         for(size_t p = begin; p < end; p++) {
+            auto best = nearest_centroid(point(p), centroids, n_bins, clustering.assignment[p]);
+            changes += best != clustering.assignment[p];
+            clustering.assignment[p] = best;
+         }
+         chunk_changes[chunk] = changes;
+      };
+      parallel_chunks(n_points, chunk_size, config.n_threads, assign);
+      clustering.n_iterations = iteration + 1;
+      auto n_changes = std::accumulate(chunk_changes.begin(), chunk_changes.end(), size_t(0));
+      if(iteration > 0 and n_changes == 0) {
+         break;
+      }
+      // group the points by cluster (in index order) and average each cluster independently
+      std::fill(cluster_begin.begin(), cluster_begin.end(), 0);
+      for(auto c : clustering.assignment) {
+         cluster_begin[c + 1]++;
+      }
+      std::partial_sum(cluster_begin.begin(), cluster_begin.end(), cluster_begin.begin());
+      auto fill_position = cluster_begin;
+      for(size_t p = 0; p < n_points; p++) {
+         members[fill_position[clustering.assignment[p]]++] = p;
+      }
+      parallel_chunks(n_clusters, 1, config.n_threads, [&](size_t c, size_t, size_t) {
+         auto n_members = cluster_begin[c + 1] - cluster_begin[c];
+         if(n_members == 0) {
+            return;
+         }
+         std::vector< double > sum(n_bins, 0.);
+         for(size_t m = cluster_begin[c]; m < cluster_begin[c + 1]; m++) {
+            const float* cdf = point(members[m]);
+            for(size_t b = 0; b < n_bins; b++) {
+               sum[b] += double(cdf[b]);
+            }
+         }
+         for(size_t b = 0; b < n_bins; b++) {
+            centroid(c)[b] = float(sum[b] / double(n_members));
+         }
+      });
+   }
+
+   // relabel the clusters by ascending mean equity and turn the centroids back into histograms
+   for(size_t c = 0; c < n_clusters; c++) {
+      std::adjacent_difference(centroid(c), centroid(c) + n_bins, centroid(c));
+   }
+   auto relabel = labels_by_equity(centroids, n_bins);
+   clustering.centroids.resize(centroids.size());
+   for(size_t c = 0; c < n_clusters; c++) {
+      std::copy_n(centroid(c), n_bins, clustering.centroids.begin() + long(relabel[c] * n_bins));
+   }
+   for(auto& c : clustering.assignment) {
+      c = relabel[c];
+   }
+   return clustering;
+}
+
+std::vector< Bucket > streamed_emd_kmeans(
+   const HandIndexer& indexer,
+   size_t round,
+   size_t n_clusters,
+   const BucketingConfig& config
+)
+{
+   validate_geometry(indexer);
+   const size_t n_bins = config.n_histogram_bins;
+   const auto n_hands = indexer.round_size(round);
+   if(n_hands == 0 or config.minibatch_size == 0 or config.n_minibatches == 0) {
+      throw std::invalid_argument("Streamed k-means needs hands and non-empty mini-batches.");
+   }
+   std::mt19937_64 rng{splitmix64(config.seed ^ round)};
+   std::uniform_int_distribution< HandIndexer::index_type > pick{0, n_hands - 1};
+   std::vector< HandIndexer::index_type > batch(std::min(config.minibatch_size, n_hands));
+   auto draw_batch = [&] {
+      for(auto& index : batch) {
+         index = pick(rng);
+      }
+      return equity_histograms(indexer, round, batch, config);
+   };
+
+   // the first mini-batch is clustered fully to seed the centroids
+   auto seeding = emd_kmeans(draw_batch(), n_bins, n_clusters, config);
+   auto centroids = std::move(seeding.centroids);
+   n_clusters = centroids.size() / n_bins;
+   to_cdfs(centroids, n_bins);
+   std::vector< size_t > counts(n_clusters, 0);
+   for(auto c : seeding.assignment) {
+      counts[c]++;
+   }
+
+   constexpr size_t chunk_size = 1024;
+   std::vector< Bucket > nearest(batch.size(), 0);
+   for(size_t minibatch = 1; minibatch < config.n_minibatches; minibatch++) {
+      auto cdfs = draw_batch();
+      to_cdfs(cdfs, n_bins);
+      auto assign = [&](size_t, size_t begin, size_t end) {
+         for(size_t p = begin; p < end; p++) {
+            nearest[p] = nearest_centroid(cdfs.data() + p * n_bins, centroids, n_bins, nearest[p]);
+         }
+      };
+      parallel_chunks(batch.size(), chunk_size, config.n_threads, assign);
+      // every point moves its centroid towards it at the centroid's decaying learning rate, in
+      // batch order so that the centroids do not depend on the number of threads
+      for(size_t p = 0; p < batch.size(); p++) {
+         auto* centroid = centroids.data() + nearest[p] * n_bins;
+         const auto* cdf = cdfs.data() + p * n_bins;
+         auto learning_rate = 1.f / float(++counts[nearest[p]]);
+         for(size_t b = 0; b < n_bins; b++) {
+            centroid[b] += learning_rate * (cdf[b] - centroid[b]);
+         }
+      }
+   }
+
+   std::vector< float > centroid_histograms = centroids;
+   for(size_t offset = 0; offset < centroid_histograms.size(); offset += n_bins) {
+      auto begin = centroid_histograms.begin() + long(offset);
+      std::adjacent_difference(begin, begin + long(n_bins), begin);
+   }
+   auto labels = labels_by_equity(centroid_histograms, n_bins);
+
+   // the assignment pass computes each hand's histogram right before it is assigned
+   std::vector< Bucket > assignment(n_hands);
+   parallel_chunks(n_hands, 16, config.n_threads, [&](size_t, size_t begin, size_t end) {
+      Bucket guess = 0;
+      for(size_t index = begin; index < end; index++) {
+         auto cdf = equity_histogram(indexer, indexer.unindex(round, index), config);
+         to_cdfs(cdf, n_bins);
+         guess = nearest_centroid(cdf.data(), centroids, n_bins, guess);
+         assignment[index] = labels[guess];
+      }
+   });
+   return assignment;
+}
+
+std::vector< std::vector< Bucket > >
+compute_buckets(const HandIndexer& indexer, const BucketingConfig& config)
+{
+   if(config.n_buckets.size() > indexer.n_rounds()) {
+      throw std::invalid_argument("More rounds to bucket than the indexer has rounds.");
+   }
+   std::vector< std::vector< Bucket > > buckets;
+   for(size_t round = 0; round < config.n_buckets.size(); round++) {
+      auto histogram_bytes = indexer.round_size(round) * config.n_histogram_bins * sizeof(float);
+      if(histogram_bytes > config.max_histogram_bytes) {
+         buckets.emplace_back(streamed_emd_kmeans(indexer, round, config.n_buckets[round], config));
+         continue;
+      }
+      auto histograms = equity_histograms(indexer, round, config);
+      auto clustering = emd_kmeans(
+         histograms, config.n_histogram_bins, config.n_buckets[round], config
+      );
+      buckets.emplace_back(std::move(clustering.assignment));
+   }
+   return buckets;
+}
+
+void write_bucket_file(
+   const std::filesystem::path& path,
+   const std::vector< std::vector< Bucket > >& buckets,
+   std::span< const size_t > n_buckets
+)
+{
+   if(buckets.size() != n_buckets.size()) {
+      throw std::invalid_argument("Every bucketed round needs its number of buckets.");
+   }
+   std::ofstream file(path, std::ios::binary | std::ios::trunc);
+   if(not file) {
+      throw std::invalid_argument("Could not open the bucket file " + path.string());
+   }
+   auto n_rounds = uint32_t(buckets.size());
+   file.write(bucket_file_magic.data(), bucket_file_magic.size());
+   file.write(reinterpret_cast< const char* >(&bucket_file_version), sizeof(bucket_file_version));
+   file.write(reinterpret_cast< const char* >(&n_rounds), sizeof(n_rounds));
+   for(size_t round = 0; round < buckets.size(); round++) {
+      BucketFileRound header{buckets[round].size(), n_buckets[round]};
+      file.write(reinterpret_cast< const char* >(&header), sizeof(header));
+   }
+   for(const auto& round_buckets : buckets) {
+      file.write(
+         reinterpret_cast< const char* >(round_buckets.data()),
+         std::streamsize(round_buckets.size() * sizeof(Bucket))
+      );
+      // keep the next round aligned
+      std::array< char, sizeof(uint64_t) > padding{};
+      file.write(padding.data(), std::streamsize(padding_after(round_buckets.size())));
+   }
+   if(not file) {
+      throw std::invalid_argument("Could not write the bucket file " + path.string());
+   }
+}
+
+BucketMap BucketMap::open(const std::filesystem::path& path)
+{
+   int fd = ::open(path.c_str(), O_RDONLY);
+   if(fd < 0) {
+      throw std::invalid_argument("Could not open the bucket file " + path.string());
+   }
+   struct stat file_stats {};
+   BucketMap map;
+   if(::fstat(fd, &file_stats) == 0 and file_stats.st_size > 0) {
+      map.m_size = size_t(file_stats.st_size);
+      map.m_data = ::mmap(nullptr, map.m_size, PROT_READ, MAP_SHARED, fd, 0);
+      if(map.m_data == MAP_FAILED) {
+         map.m_data = nullptr;
+      }
+   }
+   ::close(fd);
+   if(map.m_data == nullptr) {
+      throw std::invalid_argument("Could not map the bucket file " + path.string());
+   }
+
+   auto invalid = [&] { return std::invalid_argument("Invalid bucket file " + path.string()); };
+   const auto* bytes = static_cast< const char* >(map.m_data);
+   size_t offset = bucket_file_magic.size() + 2 * sizeof(uint32_t);
+   if(map.m_size < offset
+      or not std::equal(bucket_file_magic.begin(), bucket_file_magic.end(), bytes)) {
+      throw invalid();
+   }
+   uint32_t version = 0;
+   uint32_t n_rounds = 0;
+   std::memcpy(&version, bytes + bucket_file_magic.size(), sizeof(version));
+   std::memcpy(&n_rounds, bytes + bucket_file_magic.size() + sizeof(version), sizeof(n_rounds));
+   if(version != bucket_file_version or map.m_size < offset + n_rounds * sizeof(BucketFileRound)) {
+      throw invalid();
+   }
+   std::vector< BucketFileRound > headers(n_rounds);
+   std::memcpy(headers.data(), bytes + offset, n_rounds * sizeof(BucketFileRound));
+   offset += n_rounds * sizeof(BucketFileRound);
+   for(const auto& header : headers) {
+      if(header.n_buckets > max_buckets
+         or (map.m_size - offset) / sizeof(Bucket) < header.size) {
+         throw invalid();
+      }
+      map.m_rounds.emplace_back(
+         Round{reinterpret_cast< const Bucket* >(bytes + offset), header.size, header.n_buckets}
+      );
+      offset += header.size * sizeof(Bucket) + padding_after(header.size);
+      // a truncated file must not move the offset past its end, or the next size check wraps
+      if(offset > map.m_size) {
+         throw invalid();
+      }
+   }
+   return map;
+}
+
+BucketMap::BucketMap(BucketMap&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)),
+      m_size(std::exchange(other.m_size, 0)),
+      m_rounds(std::move(other.m_rounds))
+{
+}
+
+BucketMap& BucketMap::operator=(BucketMap&& other) noexcept
+{
+   if(this != &other) {
+      _unmap();
+      m_data = std::exchange(other.m_data, nullptr);
+      m_size = std::exchange(other.m_size, 0);
+      m_rounds = std::move(other.m_rounds);
+   }
+   return *this;
+}
+
+BucketMap::~BucketMap()
+{
+   _unmap();
+}
+
+void BucketMap::_unmap()
+{
+   if(m_data != nullptr) {
+      ::munmap(m_data, m_size);
+      m_data = nullptr;
+   }
+}
+
+}  // namespace texholdem
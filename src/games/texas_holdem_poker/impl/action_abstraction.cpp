@@ -0,0 +1,119 @@
+#include "texas_holdem_poker/action_abstraction.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace texholdem {
+
+namespace {
+
+constexpr float chip_eps = 1e-4f;
+
+bool is_raise(const Action& action)
+{
+   return action.action_type == ActionType::bet or action.action_type == ActionType::raise;
+}
+
+}  // namespace
+
+ActionTranslator::ActionTranslator(std::vector< double > sizes) : m_sizes(std::move(sizes))
+{
+   std::sort(m_sizes.begin(), m_sizes.end());
+   m_sizes.erase(std::unique(m_sizes.begin(), m_sizes.end()), m_sizes.end());
+   if(m_sizes.empty() or m_sizes.front() < 0.) {
+      throw std::invalid_argument("The translation grid needs at least one non-negative size.");
+   }
+}
+
+ActionAbstraction::ActionAbstraction(std::vector< double > pot_fractions, bool all_in)
+    : m_translator(std::move(pot_fractions)), m_all_in(all_in)
+{
+}
+
+double ActionAbstraction::pot_fraction(const State& state, float raise)
+{
+   return double(raise) / (state.pot() + state.to_call(state.active_player()));
+}
+
+Action ActionAbstraction::_raise(const State& state, ActionType raise_type, double fraction)
+{
+   auto [min_raise, max_raise] = state.raise_range();
+   auto pot_after_call = state.pot() + state.to_call(state.active_player());
+   return {raise_type, std::clamp(float(fraction * pot_after_call), min_raise, max_raise)};
+}
+
+Action ActionAbstraction::_grid_raise(const State& state, ActionType raise_type, size_t idx) const
+{
+   if(idx == pot_fractions().size()) {
+      return {raise_type, state.raise_range().second};
+   }
+   return _raise(state, raise_type, pot_fractions()[idx]);
+}
+
+std::vector< Action > ActionAbstraction::_raises(const State& state, ActionType raise_type) const
+{
+   std::vector< Action > raises;
+   raises.reserve(pot_fractions().size() + 1);
+   auto add_raise = [&](Action action) {
+      // clamping may map several fractions onto the same raise
+      if(raises.empty() or raises.back().bet + chip_eps < action.bet) {
+         raises.emplace_back(action);
+      }
+   };
+   for(size_t idx = 0; idx < pot_fractions().size() + (m_all_in ? 1 : 0); idx++) {
+      add_raise(_grid_raise(state, raise_type, idx));
+   }
+   return raises;
+}
+
+std::vector< Action > ActionAbstraction::actions(const State& state) const
+{
+   auto real_actions = state.actions();
+   std::vector< Action > abstract_actions;
+   abstract_actions.reserve(pot_fractions().size() + 3);
+   std::copy_if(
+      real_actions.begin(),
+      real_actions.end(),
+      std::back_inserter(abstract_actions),
+      [](const Action& action) { return not is_raise(action); }
+   );
+   auto raise = std::find_if(real_actions.begin(), real_actions.end(), is_raise);
+   if(raise == real_actions.end()) {
+      return abstract_actions;
+   }
+   auto raises = _raises(state, raise->action_type);
+   abstract_actions.insert(abstract_actions.end(), raises.begin(), raises.end());
+   return abstract_actions;
+}
+
+std::vector< std::pair< Action, double > >
+ActionAbstraction::translate(const State& state, const Action& action) const
+{
+   if(not is_raise(action)) {
+      return {{action, 1.}};
+   }
+   auto [min_raise, max_raise] = state.raise_range();
+   auto clamped_bet = std::clamp(action.bet, min_raise, max_raise);
+   if(not state.is_valid(Action{action.action_type, clamped_bet})) {
+      throw std::invalid_argument("The state does not allow raising.");
+   }
+   // the abstract raises are the sorted grid fractions clamped to the raise range (plus the
+   // all-in), which keeps them sorted, so the translator can binary search them as they are built
+   auto n_raises = pot_fractions().size() + (m_all_in ? 1 : 0);
+   auto [lower, upper, lower_probability] = ActionTranslator::translate(
+      n_raises,
+      [&](size_t idx) {
+         return pot_fraction(state, _grid_raise(state, action.action_type, idx).bet);
+      },
+      pot_fraction(state, action.bet)
+   );
+   auto lower_raise = _grid_raise(state, action.action_type, lower);
+   if(lower == upper) {
+      return {{lower_raise, 1.}};
+   }
+   return {
+      {lower_raise, lower_probability},
+      {_grid_raise(state, action.action_type, upper), 1. - lower_probability}};
+}
+
+}  // namespace texholdem
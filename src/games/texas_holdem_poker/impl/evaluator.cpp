@@ -0,0 +1,289 @@
+#include "texas_holdem_poker/evaluator.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace texholdem {
+
+namespace {
+
+constexpr size_t flush_table_size = size_t(1) << n_ranks;
+constexpr std::array< char, 8 > table_file_magic = {'N', 'O', 'R', 'H', 'E', 'V', 'A', 'L'};
+constexpr uint32_t table_file_version = 1;
+
+/// calls `func(counts)` for every rank multiset of `n_items` ranks (each rank at most 4 times)
+template < typename Func >
+void for_each_rank_multiset(
+   std::array< size_t, n_ranks >& counts,
+   size_t rank,
+   size_t n_items,
+   Func&& func
+)
+{
+   if(rank == n_ranks) {
+      if(n_items == 0) {
+         func(counts);
+      }
+      return;
+   }
+   for(size_t c = 0; c <= std::min(n_items, n_suits); c++) {
+      counts[rank] = c;
+      for_each_rank_multiset(counts, rank + 1, n_items - c, func);
+   }
+   counts[rank] = 0;
+}
+
+/// the lowest card of each rank, i.e. one bit per 4-bit rank field of a `CardMask`
+constexpr CardMask lowest_suit_cards = 0x1111111111111ull;
+/// a card of the highest rank, which stands in for the next card of exhausted hands
+constexpr CardMask sentinel_card = CardMask(1) << ((n_ranks - 1) * n_suits);
+
+/// The rank multiset counts for hashing hands in lockstep: the row of rank r holds
+/// `rank_multiset_counts[r][k]` in column `lockstep_offset + k` and 0 elsewhere. Step s of a hand
+/// of n cards reads column `lockstep_offset + n - s`, so that steps past its last card (which see
+/// the sentinel card and thus the last row at a column of at most `lockstep_offset`) add nothing.
+constexpr size_t lockstep_offset = detail::max_eval_cards + 1;
+constexpr size_t lockstep_stride = 2 * lockstep_offset;
+constexpr auto lockstep_counts = [] {
+   std::array< uint32_t, (n_ranks + 1) * lockstep_stride > counts{};
+   for(size_t rank = 0; rank < n_ranks; rank++) {
+      for(size_t k = 0; k <= detail::max_eval_cards; k++) {
+         counts[rank * lockstep_stride + lockstep_offset + k] = detail::rank_multiset_counts[rank][k];
+      }
+   }
+   // The row past the highest rank stays 0. Live cards only read its counts of one or more cards
+   // (which are 0 anyway), while exhausted hands would read its count of no cards (which is 1).
+   return counts;
+}();
+
+/// the number of cards of each suit of the hand, suit s in byte s
+inline uint32_t suit_counts(CardMask hand)
+{
+   uint32_t counts = 0;
+   for(size_t suit = 0; suit < n_suits; suit++) {
+      // sums the suit's bits of all ranks in the lowest 4-bit field (at most 13, so nothing carries)
+      auto bits = (hand >> suit) & lowest_suit_cards;
+      bits += bits >> 4;
+      bits += bits >> 8;
+      bits += bits >> 16;
+      bits += bits >> 32;
+      counts |= uint32_t(bits & 0xFu) << (8 * suit);
+   }
+   return counts;
+}
+
+/// the 13-bit rank mask of the flush suit (the lowest set bit of `flush_suits`)
+inline uint16_t flush_rank_mask(CardMask hand, uint8_t flush_suits)
+{
+   uint16_t rank_mask = 0;
+   for(auto rest = (hand >> std::countr_zero(flush_suits)) & lowest_suit_cards; rest != 0;
+       rest &= rest - 1) {
+      rank_mask |= uint16_t(1u << (size_t(std::countr_zero(rest)) / n_suits));
+   }
+   return rank_mask;
+}
+
+}  // namespace
+
+HandEvaluator::HandEvaluator(uninitialized_tag) {}
+
+HandEvaluator::HandEvaluator() : m_flush_table(flush_table_size, 0)
+{
+   std::vector< Card > cards;
+   cards.reserve(n_ranks);
+   for(size_t rank_mask = 0; rank_mask < flush_table_size; rank_mask++) {
+      if(std::popcount(rank_mask) < 5) {
+         continue;
+      }
+      cards.clear();
+      for(size_t r = 0; r < n_ranks; r++) {
+         if(rank_mask & (size_t(1) << r)) {
+            cards.emplace_back(Rank(r + 2), Suit::spades);
+         }
+      }
+      m_flush_table[rank_mask] = rank_hand(cards);
+   }
+
+   _init_rank_table_offsets();
+   m_rank_table.assign(m_rank_table_offsets.back(), 0);
+   std::array< size_t, n_ranks > counts{};
+   for(size_t n = 0; n <= detail::max_eval_cards; n++) {
+      for_each_rank_multiset(counts, 0, n, [&](const auto& rank_counts) {
+         // dealing the suits round-robin puts at most 2 of 7 cards into a suit, so that the
+         // representative hand never holds a flush
+         cards.clear();
+         for(size_t r = 0; r < n_ranks; r++) {
+            for(size_t c = 0; c < rank_counts[r]; c++) {
+               cards.emplace_back(Rank(r + 2), Suit(cards.size() % n_suits));
+            }
+         }
+         auto hash = detail::rank_multiset_hash(to_mask(cards));
+         m_rank_table[m_rank_table_offsets[n] + hash] = rank_hand(cards);
+      });
+   }
+}
+
+void HandEvaluator::_init_rank_table_offsets()
+{
+   for(size_t n = 0; n <= detail::max_eval_cards; n++) {
+      m_rank_table_offsets[n + 1] = m_rank_table_offsets[n] + detail::rank_multiset_counts[0][n];
+   }
+}
+
+const HandEvaluator& HandEvaluator::instance()
+{
+   static const HandEvaluator evaluator = [] {
+      const char* path = std::getenv("NOR_HOLDEM_EVALUATOR_TABLES");
+      if(path == nullptr) {
+         return HandEvaluator{};
+      }
+      if(auto loaded = load(path); loaded.has_value()) {
+         return std::move(*loaded);
+      }
+      HandEvaluator generated{};
+      generated.save(path);
+      return generated;
+   }();
+   return evaluator;
+}
+
+std::optional< HandEvaluator > HandEvaluator::load(const std::filesystem::path& path)
+{
+   std::ifstream file(path, std::ios::binary);
+   if(not file) {
+      return std::nullopt;
+   }
+   std::array< char, table_file_magic.size() > magic{};
+   uint32_t version = 0;
+   uint64_t flush_size = 0;
+   uint64_t rank_size = 0;
+   file.read(magic.data(), magic.size());
+   file.read(reinterpret_cast< char* >(&version), sizeof(version));
+   file.read(reinterpret_cast< char* >(&flush_size), sizeof(flush_size));
+   file.read(reinterpret_cast< char* >(&rank_size), sizeof(rank_size));
+   HandEvaluator evaluator{uninitialized_tag{}};
+   evaluator._init_rank_table_offsets();
+   if(not file or magic != table_file_magic or version != table_file_version
+      or flush_size != flush_table_size or rank_size != evaluator.m_rank_table_offsets.back()) {
+      return std::nullopt;
+   }
+   evaluator.m_flush_table.resize(flush_size);
+   evaluator.m_rank_table.resize(rank_size);
+   file.read(
+      reinterpret_cast< char* >(evaluator.m_flush_table.data()),
+      std::streamsize(flush_size * sizeof(HandRank))
+   );
+   file.read(
+      reinterpret_cast< char* >(evaluator.m_rank_table.data()),
+      std::streamsize(rank_size * sizeof(HandRank))
+   );
+   if(not file) {
+      return std::nullopt;
+   }
+   return evaluator;
+}
+
+bool HandEvaluator::save(const std::filesystem::path& path) const
+{
+   std::ofstream file(path, std::ios::binary | std::ios::trunc);
+   if(not file) {
+      return false;
+   }
+   uint64_t flush_size = m_flush_table.size();
+   uint64_t rank_size = m_rank_table.size();
+   file.write(table_file_magic.data(), table_file_magic.size());
+   file.write(reinterpret_cast< const char* >(&table_file_version), sizeof(table_file_version));
+   file.write(reinterpret_cast< const char* >(&flush_size), sizeof(flush_size));
+   file.write(reinterpret_cast< const char* >(&rank_size), sizeof(rank_size));
+   file.write(
+      reinterpret_cast< const char* >(m_flush_table.data()),
+      std::streamsize(flush_size * sizeof(HandRank))
+   );
+   file.write(
+      reinterpret_cast< const char* >(m_rank_table.data()),
+      std::streamsize(rank_size * sizeof(HandRank))
+   );
+   return bool(file);
+}
+
+void HandEvaluator::_throw_too_many_cards(size_t hand_size)
+{
+   throw std::invalid_argument(
+      "The evaluator ranks at most 7 cards. Given: " + std::to_string(hand_size)
+   );
+}
+
+HandRank HandEvaluator::evaluate(std::span< const Card > cards) const
+{
+   if(cards.size() > detail::max_eval_cards) {
+      _throw_too_many_cards(cards.size());
+   }
+   return evaluate(to_mask(cards));
+}
+
+void HandEvaluator::evaluate(std::span< const CardMask > hands, std::span< HandRank > ranks) const
+{
+   if(hands.size() != ranks.size()) {
+      throw std::invalid_argument("The batch of hands and ranks need to be of equal size.");
+   }
+   constexpr size_t block_size = 64;
+   // the hands hashed in lockstep, few enough for their state to stay in registers
+   constexpr size_t n_lanes = 8;
+   std::array< uint32_t, block_size > hash{};
+   std::array< uint32_t, block_size > column{};
+   std::array< uint8_t, block_size > flush_suits{};
+
+   for(size_t block_start = 0; block_start < hands.size(); block_start += block_size) {
+      size_t block_len = std::min(block_size, hands.size() - block_start);
+      auto block = hands.subspan(block_start, block_len);
+      // counting pass: the suit counts of every hand as bit-parallel sums, which yield the hand
+      // size and the flush suits without a loop over the cards
+      for(size_t i = 0; i < block_len; i++) {
+         auto counts = suit_counts(block[i]);
+         auto hand_size = size_t((counts * 0x01010101u) >> 24);
+         if(hand_size > detail::max_eval_cards) {
+            _throw_too_many_cards(hand_size);
+         }
+         // the high bit of a suit's byte is set iff the suit holds at least 5 cards, and the
+         // multiplication gathers these bits into the top 4 bits
+         auto flush_bits = (counts + 0x7B7B7B7Bu) & 0x80808080u;
+         flush_suits[i] = uint8_t((flush_bits * 0x00204081u) >> 28);
+         hash[i] = m_rank_table_offsets[hand_size];
+         column[i] = uint32_t(lockstep_offset + hand_size);
+      }
+      // hashing pass: the rank multiset hashes of a group of hands advance by one card per step
+      // in lockstep, so that their dependency chains interleave
+      for(size_t lane_start = 0; lane_start < block_len; lane_start += n_lanes) {
+         size_t n_active = std::min(n_lanes, block_len - lane_start);
+         std::array< CardMask, n_lanes > rest{};
+         std::array< uint32_t, n_lanes > lane_hash{};
+         std::array< uint32_t, n_lanes > lane_column{};
+         lane_column.fill(uint32_t(lockstep_offset));
+         for(size_t lane = 0; lane < n_active; lane++) {
+            rest[lane] = block[lane_start + lane];
+            lane_hash[lane] = hash[lane_start + lane];
+            lane_column[lane] = column[lane_start + lane];
+         }
+         for(size_t step = 0; step < detail::max_eval_cards; step++) {
+            for(size_t lane = 0; lane < n_lanes; lane++) {
+               auto rank_idx = size_t(std::countr_zero(rest[lane] | sentinel_card)) / n_suits;
+               lane_hash[lane] += lockstep_counts
+                  [(rank_idx + 1) * lockstep_stride + lane_column[lane] - step];
+               rest[lane] &= rest[lane] - 1;
+            }
+         }
+         std::copy_n(lane_hash.begin(), n_active, hash.begin() + long(lane_start));
+      }
+      // lookup pass
+      for(size_t i = 0; i < block_len; i++) {
+         ranks[block_start + i] = flush_suits[i] != 0
+                                     ? m_flush_table[flush_rank_mask(block[i], flush_suits[i])]
+                                     : m_rank_table[hash[i]];
+      }
+   }
+}
+
+}  // namespace texholdem
@@ -0,0 +1,383 @@
+#include "texas_holdem_poker/hand_indexer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace texholdem {
+
+namespace {
+
+using index_type = HandIndexer::index_type;
+
+index_type binomial(index_type n, index_type k)
+{
+   if(k > n) {
+      return 0;
+   }
+   k = std::min(k, n - k);
+   index_type result = 1;
+   for(index_type i = 0; i < k; i++) {
+      result = result * (n - i) / (i + 1);
+   }
+   return result;
+}
+
+/// the binomial coefficients of the rank set sizes (n choose k for n, k <= max_ranks)
+constexpr auto rank_binomials = [] {
+   std::array< std::array< index_type, HandIndexer::max_ranks + 2 >, HandIndexer::max_ranks + 2 >
+      table{};
+   for(size_t n = 0; n < table.size(); n++) {
+      table[n][0] = 1;
+      for(size_t k = 1; k <= n; k++) {
+         table[n][k] = table[n - 1][k - 1] + table[n - 1][k];
+      }
+   }
+   return table;
+}();
+
+/// the colexicographic index of a set of ranks among all sets of equal size
+index_type colex_index(uint16_t rank_set)
+{
+   index_type index = 0;
+   for(size_t j = 1; rank_set != 0; rank_set &= uint16_t(rank_set - 1), j++) {
+      index += rank_binomials[size_t(std::countr_zero(rank_set))][j];
+   }
+   return index;
+}
+
+uint16_t colex_unindex(index_type index, size_t set_size)
+{
+   uint16_t rank_set = 0;
+   for(size_t j = set_size; j > 0; j--) {
+      size_t rank = j - 1;
+      while(rank_binomials[rank + 1][j] <= index) {
+         rank++;
+      }
+      index -= rank_binomials[rank][j];
+      rank_set |= uint16_t(1u << rank);
+   }
+   return rank_set;
+}
+
+/// renumbers the ranks of `rank_set` to their position among the ranks not in `used`
+uint16_t compress(uint16_t rank_set, uint16_t used)
+{
+   uint16_t compressed = 0;
+   for(; rank_set != 0; rank_set &= uint16_t(rank_set - 1)) {
+      auto rank = std::countr_zero(rank_set);
+      compressed |= uint16_t(1u << (rank - std::popcount(uint16_t(used & ((1u << rank) - 1u)))));
+   }
+   return compressed;
+}
+
+/// the inverse of `compress`
+uint16_t expand(uint16_t compressed, uint16_t used)
+{
+   uint16_t rank_set = 0;
+   for(size_t rank = 0; compressed != 0; rank++) {
+      if(used & (1u << rank)) {
+         continue;
+      }
+      if(compressed & 1u) {
+         rank_set |= uint16_t(1u << rank);
+      }
+      compressed >>= 1;
+   }
+   return rank_set;
+}
+
+}  // namespace
+
+HandIndexer::HandIndexer(
+   std::vector< size_t > cards_per_round,
+   size_t rank_count,
+   size_t suit_count
+)
+    : m_cards_per_round(std::move(cards_per_round)), m_n_ranks(rank_count), m_n_suits(suit_count)
+{
+   if(m_cards_per_round.empty() or m_cards_per_round.size() > max_rounds) {
+      throw std::invalid_argument(
+         "The hand indexer needs between 1 and " + std::to_string(max_rounds) + " rounds."
+      );
+   }
+   if(m_n_ranks == 0 or m_n_ranks > max_ranks or m_n_suits == 0 or m_n_suits > max_suits) {
+      throw std::invalid_argument(
+         "The hand indexer supports up to " + std::to_string(max_ranks) + " ranks and "
+         + std::to_string(max_suits) + " suits."
+      );
+   }
+   m_cards_until.resize(n_rounds() + 1, 0);
+   std::partial_sum(
+      m_cards_per_round.begin(), m_cards_per_round.end(), std::next(m_cards_until.begin())
+   );
+   if(m_cards_until.back() > m_n_ranks * m_n_suits) {
+      throw std::invalid_argument("The rounds deal more cards than the deck holds.");
+   }
+   m_configurations.resize(n_rounds());
+   m_round_sizes.resize(n_rounds());
+   for(size_t round = 0; round < n_rounds(); round++) {
+      _enumerate_configurations(round);
+   }
+}
+
+const HandIndexer& HandIndexer::holdem()
+{
+   static const HandIndexer indexer{{2, 3, 1, 1}};
+   return indexer;
+}
+
+size_t HandIndexer::round_of(size_t hand_size) const
+{
+   auto found = std::find(std::next(m_cards_until.begin()), m_cards_until.end(), hand_size);
+   if(found == m_cards_until.end()) {
+      throw std::invalid_argument(
+         "No round of the hand indexer ends with " + std::to_string(hand_size) + " cards."
+      );
+   }
+   return size_t(std::distance(m_cards_until.begin(), found)) - 1;
+}
+
+HandIndexer::index_type HandIndexer::_suit_size(const suit_counts& counts, size_t round) const
+{
+   index_type size = 1;
+   size_t used = 0;
+   for(size_t r = 0; r <= round; r++) {
+      size *= binomial(m_n_ranks - used, counts[r]);
+      used += counts[r];
+   }
+   return size;
+}
+
+void HandIndexer::_enumerate_configurations(size_t round)
+{
+   auto& configurations = m_configurations[round];
+   std::array< suit_counts, max_suits > counts{};
+   std::array< size_t, max_suits > used{};
+
+   auto add_if_canonical = [&] {
+      for(size_t s = 1; s < m_n_suits; s++) {
+         if(counts[s - 1] < counts[s]) {
+            return;
+         }
+      }
+      Configuration config{
+         .counts = counts, .group_sizes = {}, .suit_sizes = {}, .offset = 0, .size = 1};
+      for(size_t s = 0; s < m_n_suits; s++) {
+         config.suit_sizes[s] = _suit_size(counts[s], round);
+      }
+      for(size_t s = 0; s < m_n_suits;) {
+         size_t group_end = s + 1;
+         while(group_end < m_n_suits and counts[group_end] == counts[s]) {
+            group_end++;
+         }
+         auto group_size = group_end - s;
+         config.group_sizes[s] = uint8_t(group_size);
+         config.size *= binomial(config.suit_sizes[s] + group_size - 1, group_size);
+         s = group_end;
+      }
+      configurations.emplace_back(config);
+   };
+   // distributes the cards of every round onto the suits (suit by suit)
+   auto distribute = [&](auto& self, size_t r, size_t s, size_t cards_left) -> void {
+      if(r > round) {
+         add_if_canonical();
+         return;
+      }
+      if(s == m_n_suits - 1) {
+         if(cards_left <= m_n_ranks - used[s]) {
+            counts[s][r] = uint8_t(cards_left);
+            used[s] += cards_left;
+            self(self, r + 1, 0, r + 1 <= round ? m_cards_per_round[r + 1] : 0);
+            used[s] -= cards_left;
+            counts[s][r] = 0;
+         }
+         return;
+      }
+      for(size_t c = 0; c <= std::min(cards_left, m_n_ranks - used[s]); c++) {
+         counts[s][r] = uint8_t(c);
+         used[s] += c;
+         self(self, r, s + 1, cards_left - c);
+         used[s] -= c;
+      }
+      counts[s][r] = 0;
+   };
+   distribute(distribute, 0, 0, m_cards_per_round[0]);
+
+   std::sort(configurations.begin(), configurations.end(), [](const auto& c1, const auto& c2) {
+      return c1.counts < c2.counts;
+   });
+   index_type offset = 0;
+   for(auto& config : configurations) {
+      config.offset = offset;
+      offset += config.size;
+   }
+   m_round_sizes[round] = offset;
+}
+
+HandIndexer::index_type HandIndexer::index(std::span< const Card > cards) const
+{
+   std::array< uint8_t, 64 > card_ids{};
+   if(cards.size() > card_ids.size()) {
+      throw std::invalid_argument("Too many cards to index: " + std::to_string(cards.size()));
+   }
+   std::transform(cards.begin(), cards.end(), card_ids.begin(), [](const Card& card) {
+      return card.index();
+   });
+   return index(std::span{card_ids}.first(cards.size()));
+}
+
+HandIndexer::index_type HandIndexer::index(std::span< const uint8_t > card_ids) const
+{
+   auto round = round_of(card_ids.size());
+
+   std::array< std::array< uint16_t, max_rounds >, max_suits > rank_sets{};
+   uint64_t seen = 0;
+   for(size_t r = 0; r <= round; r++) {
+      for(size_t i = m_cards_until[r]; i < m_cards_until[r + 1]; i++) {
+         auto id = card_ids[i];
+         if(id >= m_n_ranks * m_n_suits or (seen & (uint64_t(1) << id))) {
+            throw std::invalid_argument(
+               "Invalid or duplicate card id in the hand: " + std::to_string(id)
+            );
+         }
+         seen |= uint64_t(1) << id;
+         rank_sets[id % m_n_suits][r] |= uint16_t(1u << (id / m_n_suits));
+      }
+   }
+   // the per-round counts and the index among all rank sets of equal counts of each suit
+   std::array< suit_counts, max_suits > counts{};
+   std::array< index_type, max_suits > suit_indices{};
+   for(size_t s = 0; s < m_n_suits; s++) {
+      uint16_t used = 0;
+      index_type multiplier = 1;
+      for(size_t r = 0; r <= round; r++) {
+         auto rank_set = rank_sets[s][r];
+         auto n_in_round = size_t(std::popcount(rank_set));
+         counts[s][r] = uint8_t(n_in_round);
+         suit_indices[s] += multiplier * colex_index(compress(rank_set, used));
+         multiplier *= rank_binomials[m_n_ranks - size_t(std::popcount(used))][n_in_round];
+         used |= rank_set;
+      }
+   }
+   // the canonical order of the suits (an insertion sort, as there are at most 4 of them)
+   auto precedes = [&](size_t s1, size_t s2) {
+      if(counts[s1] != counts[s2]) {
+         return counts[s1] > counts[s2];
+      }
+      return suit_indices[s1] > suit_indices[s2];
+   };
+   std::array< size_t, max_suits > order{};
+   for(size_t s = 0; s < m_n_suits; s++) {
+      size_t position = s;
+      for(; position > 0 and precedes(s, order[position - 1]); position--) {
+         order[position] = order[position - 1];
+      }
+      order[position] = s;
+   }
+   std::array< suit_counts, max_suits > sorted_counts{};
+   std::array< index_type, max_suits > sorted_indices{};
+   for(size_t s = 0; s < m_n_suits; s++) {
+      sorted_counts[s] = counts[order[s]];
+      sorted_indices[s] = suit_indices[order[s]];
+   }
+
+   const auto& configurations = m_configurations[round];
+   const auto& config = *std::lower_bound(
+      configurations.begin(),
+      configurations.end(),
+      sorted_counts,
+      [](const Configuration& candidate, const auto& key) { return candidate.counts < key; }
+   );
+   index_type index = 0;
+   index_type multiplier = 1;
+   for(size_t s = 0; s < m_n_suits; s++) {
+      size_t group_size = config.group_sizes[s];
+      if(group_size == 0) {
+         continue;
+      }
+      // the suit indices of a group are a multiset, which is indexed as the strictly decreasing
+      // sequence obtained by adding the distance to the group's end
+      index_type group_index = 0;
+      for(size_t j = 0; j < group_size; j++) {
+         group_index += binomial(sorted_indices[s + j] + group_size - 1 - j, group_size - j);
+      }
+      index += multiplier * group_index;
+      multiplier *= binomial(config.suit_sizes[s] + group_size - 1, group_size);
+   }
+   return config.offset + index;
+}
+
+std::vector< uint8_t > HandIndexer::unindex(size_t round, index_type index) const
+{
+   if(round >= n_rounds() or index >= m_round_sizes[round]) {
+      throw std::invalid_argument(
+         "Index " + std::to_string(index) + " is out of range for round " + std::to_string(round)
+      );
+   }
+   const auto& configurations = m_configurations[round];
+   const auto& config = *std::prev(std::upper_bound(
+      configurations.begin(),
+      configurations.end(),
+      index,
+      [](index_type idx, const Configuration& candidate) { return idx < candidate.offset; }
+   ));
+
+   std::array< index_type, max_suits > suit_indices{};
+   index_type remainder = index - config.offset;
+   for(size_t s = 0; s < m_n_suits; s++) {
+      size_t group_size = config.group_sizes[s];
+      if(group_size == 0) {
+         continue;
+      }
+      auto n_values = config.suit_sizes[s];
+      auto group_count = binomial(n_values + group_size - 1, group_size);
+      auto group_index = remainder % group_count;
+      remainder /= group_count;
+      for(size_t j = 0; j < group_size; j++) {
+         index_type k = group_size - j;
+         // the largest value whose binomial coefficient does not exceed the remaining index
+         index_type low = k - 1;
+         index_type high = n_values + group_size - 1 - j;
+         while(high - low > 1) {
+            auto mid = low + (high - low) / 2;
+            if(binomial(mid, k) <= group_index) {
+               low = mid;
+            } else {
+               high = mid;
+            }
+         }
+         group_index -= binomial(low, k);
+         suit_indices[s + j] = low - (group_size - 1 - j);
+      }
+   }
+
+   std::array< std::array< uint16_t, max_rounds >, max_suits > rank_sets{};
+   for(size_t s = 0; s < m_n_suits; s++) {
+      uint16_t used = 0;
+      auto suit_index = suit_indices[s];
+      for(size_t r = 0; r <= round; r++) {
+         size_t n_in_round = config.counts[s][r];
+         auto n_sets = rank_binomials[m_n_ranks - size_t(std::popcount(used))][n_in_round];
+         rank_sets[s][r] = expand(colex_unindex(suit_index % n_sets, n_in_round), used);
+         suit_index /= n_sets;
+         used |= rank_sets[s][r];
+      }
+   }
+   std::vector< uint8_t > card_ids;
+   card_ids.reserve(cards_until(round));
+   for(size_t r = 0; r <= round; r++) {
+      for(size_t rank = 0; rank < m_n_ranks; rank++) {
+         for(size_t s = 0; s < m_n_suits; s++) {
+            if(rank_sets[s][r] & (1u << rank)) {
+               card_ids.emplace_back(uint8_t(rank * m_n_suits + s));
+            }
+         }
+      }
+   }
+   return card_ids;
+}
+
+}  // namespace texholdem
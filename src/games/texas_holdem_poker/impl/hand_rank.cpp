@@ -0,0 +1,144 @@
+#include "texas_holdem_poker/hand_rank.hpp"
+
+#include <array>
+#include <bit>
+#include <optional>
+
+namespace texholdem {
+
+namespace {
+
+/// the rank index of the highest card of a straight within the rank mask or -1 if there is none
+int straight_high(uint16_t rank_mask)
+{
+   for(int high = 12; high >= 4; --high) {
+      auto window = uint16_t(0x1F << (high - 4));
+      if((rank_mask & window) == window) {
+         return high;
+      }
+   }
+   // the wheel (ace, two, three, four, five) counts the ace as the lowest card
+   constexpr uint16_t wheel = 0x100F;
+   if((rank_mask & wheel) == wheel) {
+      return 3;
+   }
+   return -1;
+}
+
+class RankBuilder {
+  public:
+   explicit RankBuilder(HandCategory cat) : m_rank(HandRank(cat) << 20) {}
+
+   RankBuilder& push(int rank_idx)
+   {
+      m_rank |= HandRank(rank_idx) << m_shift;
+      m_shift -= 4;
+      return *this;
+   }
+   /// pushes the highest ranks of the mask as kickers
+   RankBuilder& push_top(uint16_t rank_mask, int count)
+   {
+      for(; count > 0 and rank_mask != 0; --count) {
+         int top = std::bit_width(rank_mask) - 1;
+         push(top);
+         rank_mask &= uint16_t(~(1u << top));
+      }
+      return *this;
+   }
+   [[nodiscard]] HandRank get() const { return m_rank; }
+
+  private:
+   HandRank m_rank;
+   int m_shift = 16;
+};
+
+}  // namespace
+
+HandRank rank_hand(std::span< const Card > cards)
+{
+   std::array< uint16_t, n_suits > suit_masks{};
+   std::array< uint8_t, n_ranks > counts{};
+   uint16_t rank_mask = 0;
+   for(const auto& card : cards) {
+      auto rank_idx = uint8_t(card.rank) - 2;
+      suit_masks[size_t(card.suit)] |= uint16_t(1u << rank_idx);
+      rank_mask |= uint16_t(1u << rank_idx);
+      counts[size_t(rank_idx)]++;
+   }
+
+   std::optional< uint16_t > flush_mask;
+   for(auto mask : suit_masks) {
+      if(std::popcount(mask) >= 5) {
+         flush_mask = mask;
+      }
+   }
+   if(flush_mask.has_value()) {
+      if(int high = straight_high(*flush_mask); high >= 0) {
+         return RankBuilder{HandCategory::straight_flush}.push(high).get();
+      }
+   }
+
+   uint16_t quads = 0, trips = 0, pairs = 0;
+   for(size_t r = 0; r < n_ranks; r++) {
+      auto bit = uint16_t(1u << r);
+      if(counts[r] == 4) {
+         quads |= bit;
+      } else if(counts[r] == 3) {
+         trips |= bit;
+      } else if(counts[r] == 2) {
+         pairs |= bit;
+      }
+   }
+
+   if(quads != 0) {
+      int quad = std::bit_width(quads) - 1;
+      return RankBuilder{HandCategory::four_of_a_kind}
+         .push(quad)
+         .push_top(uint16_t(rank_mask & ~(1u << quad)), 1)
+         .get();
+   }
+   if(trips != 0) {
+      int trip = std::bit_width(trips) - 1;
+      // a second set of trips also serves as the pair of a full house
+      auto pair_candidates = uint16_t((pairs | trips) & ~(1u << trip));
+      if(pair_candidates != 0) {
+         return RankBuilder{HandCategory::full_house}
+            .push(trip)
+            .push(std::bit_width(pair_candidates) - 1)
+            .get();
+      }
+   }
+   if(flush_mask.has_value()) {
+      return RankBuilder{HandCategory::flush}.push_top(*flush_mask, 5).get();
+   }
+   if(int high = straight_high(rank_mask); high >= 0) {
+      return RankBuilder{HandCategory::straight}.push(high).get();
+   }
+   if(trips != 0) {
+      int trip = std::bit_width(trips) - 1;
+      return RankBuilder{HandCategory::three_of_a_kind}
+         .push(trip)
+         .push_top(uint16_t(rank_mask & ~(1u << trip)), 2)
+         .get();
+   }
+   if(std::popcount(pairs) >= 2) {
+      int high_pair = std::bit_width(pairs) - 1;
+      auto remaining_pairs = uint16_t(pairs & ~(1u << high_pair));
+      int low_pair = std::bit_width(remaining_pairs) - 1;
+      return RankBuilder{HandCategory::two_pair}
+         .push(high_pair)
+         .push(low_pair)
+         .push_top(uint16_t(rank_mask & ~(1u << high_pair) & ~(1u << low_pair)), 1)
+         .get();
+   }
+   if(pairs != 0) {
+      int pair = std::bit_width(pairs) - 1;
+      return RankBuilder{HandCategory::pair}
+         .push(pair)
+         .push_top(uint16_t(rank_mask & ~(1u << pair)), 3)
+         .get();
+   }
+   return RankBuilder{HandCategory::high_card}.push_top(rank_mask, 5).get();
+}
+
+}  // namespace texholdem
@@ -1,174 +1,448 @@
-
 #include "texas_holdem_poker/state.hpp"
 
-#include <iostream>
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <stdexcept>
+#include <string>
 
 namespace texholdem {
 
-inline int16_t sign(bool x)
+namespace {
+
+/// the tolerance below which chip amounts are considered equal
+constexpr float chip_eps = 1e-4f;
+
+}  // namespace
+
+State::State(sptr< const PokerConfig > config) : m_config(std::move(config))
 {
-   return 2 * x - 1;
+   const auto& cfg = *m_config;
+   if(cfg.n_players < 2 or cfg.n_players > max_players) {
+      throw std::invalid_argument(
+         "Hold'em needs between 2 and " + std::to_string(max_players) + " players. Given: "
+         + std::to_string(cfg.n_players)
+      );
+   }
+   if(cfg.boardcards_per_round.size() != cfg.n_rounds) {
+      throw std::invalid_argument("The number of board card rounds does not match `n_rounds`.");
+   }
+   if(cfg.bet_size_limits.size() != cfg.n_betting_rounds()
+      or cfg.bet_nr_limits.size() != cfg.n_betting_rounds()) {
+      throw std::invalid_argument(
+         "The betting limits need an entry for each of the "
+         + std::to_string(cfg.n_betting_rounds()) + " betting rounds (preflop included)."
+      );
+   }
+   auto n_board_cards = _board_cards_until(cfg.n_rounds + 1);
+   if(n_board_cards > max_board_cards) {
+      throw std::invalid_argument(
+         "At most " + std::to_string(max_board_cards) + " board cards are supported. Given: "
+         + std::to_string(n_board_cards)
+      );
+   }
+   if(cfg.deck.size() < cfg.n_players * hole_cards_per_player + n_board_cards) {
+      throw std::invalid_argument("The deck does not hold enough cards for the configured game.");
+   }
+   if(not cfg.stacks.empty() and cfg.stacks.size() != cfg.n_players) {
+      throw std::invalid_argument("There needs to be a starting stack for every player.");
+   }
+   if(as_int(cfg.dealer) >= cfg.n_players) {
+      throw std::invalid_argument("The dealer needs to be one of the players.");
+   }
+
+   for(size_t p = 0; p < cfg.n_players; p++) {
+      m_stacks[p] = cfg.stacks.empty() ? 100.f * cfg.big_blind : cfg.stacks[p];
+   }
+   auto small_blind = _small_blind_player();
+   auto big_blind = _big_blind_player();
+   _commit(small_blind, std::min(cfg.small_blind, m_stacks[as_int(small_blind)]));
+   _commit(big_blind, std::min(cfg.big_blind, m_stacks[as_int(big_blind)]));
+   m_last_raise = cfg.big_blind;
 }
 
-bool State::_has_higher_card(Player player) const
+Player State::_next_in(uint16_t mask, Player after) const
 {
-   return static_cast< int8_t >(m_player_cards[static_cast< size_t >(player)].value().rank)
-          > static_cast< int8_t >(m_player_cards[1 - static_cast< size_t >(player)].value().rank);
+   auto n = n_players();
+   for(size_t offset = 1; offset <= n; offset++) {
+      auto seat = Player((as_int(after) + offset) % n);
+      if(mask & _bit(seat)) {
+         return seat;
+      }
+   }
+   throw std::logic_error("No player found in the given seat mask.");
 }
 
-inline Player State::_next_active_player()
+Player State::_small_blind_player() const
 {
-   m_active_player = static_cast< Player >(not static_cast< bool >(m_active_player));
+   // heads-up the button posts the small blind
+   return n_players() == 2 ? config().dealer : Player((as_int(config().dealer) + 1) % n_players());
 }
 
-void State::apply_action(Action action)
+Player State::_big_blind_player() const
 {
-   m_history.sequence.emplace_back(action);
-   if(m_history.sequence.back().action_type == ActionType::check) {
-      // rend + 2 is the penultimate action, rend + 1 is the last action in the history
-      if((m_history.sequence.rend() + 2)->action_type == ActionType::check) {
-         // we are now either after the first betting round or after the second (then terminal). It
-         // doesnt matter which, we set the active player now to the chance player
-         m_active_player = Player::chance;
-      }
+   return Player((as_int(_small_blind_player()) + 1) % n_players());
+}
 
-   } else {
-      // the last action was a bet
-      // rend + 2 is the penultimate action, rend + 1 is the last action in the history
-      if((m_history.sequence.rend() + 2)->action_type == ActionType::bet) {
-         // we are now either after the first betting round or after the second (then terminal). It
-         // doesnt matter which, we set the active player now to the chance player
-         m_active_player = Player::chance;
-      }
-   }
+size_t State::_board_cards_until(size_t round) const
+{
+   const auto& per_round = config().boardcards_per_round;
+   return std::accumulate(
+      per_round.begin(),
+      per_round.begin() + long(std::min(round, per_round.size())),
+      size_t(0)
+   );
 }
-void State::apply_action(ChanceOutcome action)
+
+float State::_fixed_raise_size() const
 {
-   if(m_player_cards[static_cast< unsigned int >(action.player)].has_value()) {
-      throw std::logic_error("Card has already been assigned.");
-   }
-   m_player_cards[static_cast< unsigned int >(action.player)] = action.card;
-   if(_all_cards_engaged()) {
-      m_active_player = static_cast< Player >(1 - static_cast< int >(action.player));
-   }
+   return std::visit(
+      [&]< typename T >(const T& limit) {
+         if constexpr(std::is_same_v< T, float >) {
+            return limit;
+         } else {
+            // the standard limit structure doubles the bet size from the turn onwards
+            return m_round < 2 ? config().big_blind : 2.f * config().big_blind;
+         }
+      },
+      config().bet_size_limits[m_round]
+   );
+}
+
+bool State::_can_raise(Player player) const
+{
+   return m_bets_this_round < config().bet_nr_limits[m_round] and (m_may_raise & _bit(player))
+          and m_stacks[as_int(player)] > _to_call(player) + chip_eps
+          and (_can_act_mask() & ~_bit(player)) != 0;
 }
-bool State::is_terminal() const
+
+ActionType State::_raise_type() const
 {
-   const auto& terminal_seqs = _all_terminal_histories();
-   return std::find(terminal_seqs.begin(), terminal_seqs.end(), m_history) != terminal_seqs.end();
+   return (m_round == 0 or m_bets_this_round > 0) ? ActionType::raise : ActionType::bet;
 }
 
-int16_t State::payoff(Player player) const
+void State::_commit(Player player, float amount)
 {
-   if(player == Player::chance) {
-      throw std::invalid_argument("Can't provide payoff for chance player.");
+   auto p = as_int(player);
+   m_stakes[p] += amount;
+   m_stacks[p] -= amount;
+   if(m_stacks[p] <= chip_eps) {
+      m_stacks[p] = 0.f;
+      m_all_in |= _bit(player);
    }
-   if(not is_terminal()) {
-      return 0;
+   m_highest_stake = std::max(m_highest_stake, m_stakes[p]);
+}
+
+double State::pot() const
+{
+   return std::accumulate(m_stakes.begin(), m_stakes.begin() + long(n_players()), 0.);
+}
+
+std::vector< Player > State::remaining_players() const
+{
+   std::vector< Player > players;
+   for(size_t p = 0; p < n_players(); p++) {
+      if(not has_folded(Player(p))) {
+         players.emplace_back(Player(p));
+      }
    }
-   bool p1_has_bet = m_history.sequence.size() < 3 ? m_history.sequence[0] == Action::bet
-                                                   : m_history.sequence[2] == Action::bet;
-   bool p2_has_bet = m_history.sequence[1] == Action::bet;
+   return players;
+}
 
-   // 2 * x - 1 is a faster computation than std::pow((-1), x)
-   for(auto [this_player, has_bet, other_has_bet] : std::array{
-          std::tuple{Player::one, p1_has_bet, p2_has_bet},
-          std::tuple{Player::two, p2_has_bet, p1_has_bet}}) {
-      if(has_bet) {
-         if(not other_has_bet) {
-            auto value = sign(player == this_player);
-            return sign(player == this_player);
-         } else {
-            auto value = sign(_has_higher_card(this_player)) * sign(player == this_player) * 2;
-            return sign(_has_higher_card(this_player)) * sign(player == this_player) * 2;
+void State::_start_betting_round()
+{
+   m_bets_this_round = 0;
+   m_last_raise = config().big_blind;
+   auto can_act = _can_act_mask();
+   m_to_act = can_act;
+   m_may_raise = can_act;
+   if(std::popcount(can_act) <= 1) {
+      // nobody is left to bet against, only an outstanding call may still be made
+      m_to_act = 0;
+      for(size_t p = 0; p < n_players(); p++) {
+         if((can_act & _bit(Player(p))) and m_stakes[p] + chip_eps < m_highest_stake) {
+            m_to_act |= _bit(Player(p));
          }
       }
    }
-   return sign(_has_higher_card(Player::one)) * sign(player == Player::one);
+   if(m_to_act == 0) {
+      _end_betting_round();
+      return;
+   }
+   m_active_player = _next_in(
+      m_to_act, m_round == 0 ? _big_blind_player() : config().dealer
+   );
 }
 
-const std::vector< History >& State::_all_terminal_histories()
+void State::_end_betting_round()
 {
-   static const std::vector< History > terminal_sequences = {
-      {{Action::check, Action::check}},
-      {{Action::check, Action::bet, Action::check}},
-      {{Action::check, Action::bet, Action::bet}},
-      {{Action::bet, Action::bet}},
-      {{Action::bet, Action::check}}};
-   return terminal_sequences;
+   if(size_t(m_round) + 1 >= config().n_betting_rounds()) {
+      // the last betting round has concluded --> showdown
+      m_is_terminal = true;
+      m_active_player = Player::chance;
+      return;
+   }
+   m_round++;
+   m_active_player = Player::chance;
+   if(m_n_board == _board_cards_until(m_round)) {
+      // this round reveals no cards so we can move on to the betting right away
+      _start_betting_round();
+   }
 }
-bool State::is_valid(Action) const
+
+void State::apply_action(Action action)
 {
-   return _all_cards_engaged();
+   auto player = m_active_player;
+   switch(action.action_type) {
+      case ActionType::fold: {
+         m_folded |= _bit(player);
+         break;
+      }
+      case ActionType::check: {
+         break;
+      }
+      case ActionType::call: {
+         _commit(player, _to_call(player));
+         break;
+      }
+      case ActionType::bet:
+      case ActionType::raise: {
+         auto previous_high = m_highest_stake;
+         auto target = previous_high + action.bet;
+         _commit(player, std::min(target - m_stakes[as_int(player)], m_stacks[as_int(player)]));
+         auto raised_by = m_highest_stake - previous_high;
+         if(action.action_type == ActionType::raise and raised_by + chip_eps < m_last_raise) {
+            // an all-in short of a full raise: those who have acted since the last full raise
+            // need to respond to it, but may not raise again
+            m_may_raise &= m_to_act;
+         } else {
+            // only a full raise sets the minimum size of the next raise and reopens the betting
+            m_last_raise = std::max(m_last_raise, raised_by);
+            m_may_raise = _can_act_mask();
+         }
+         m_bets_this_round++;
+         // with a fresh bet everyone else who can still bet needs to respond anew
+         m_to_act = _can_act_mask();
+         break;
+      }
+   }
+   m_to_act &= uint16_t(~_bit(player));
+
+   if(std::popcount(uint16_t(_seated_mask() & ~m_folded)) == 1) {
+      // everyone but one player folded
+      m_is_terminal = true;
+      m_active_player = Player::chance;
+      return;
+   }
+   if(m_to_act == 0) {
+      _end_betting_round();
+   } else {
+      m_active_player = _next_in(m_to_act, player);
+   }
 }
-bool State::is_valid(ChanceOutcome outcome) const
+
+void State::apply_action(Card outcome)
 {
-   if(m_player_cards[static_cast< unsigned int >(outcome.player)].has_value()) {
-      return false;
+   m_dealt |= uint64_t(1) << outcome.index();
+   if(m_n_hole_dealt < n_players() * hole_cards_per_player) {
+      m_hole_cards[m_n_hole_dealt++] = outcome;
+      if(m_n_hole_dealt == n_players() * hole_cards_per_player) {
+         _start_betting_round();
+      }
+   } else {
+      m_board[m_n_board++] = outcome;
+      if(m_n_board == _board_cards_until(m_round)) {
+         _start_betting_round();
+      }
    }
-   auto all_outcomes = chance_actions();
-   return std::find_if(
-             all_outcomes.begin(),
-             all_outcomes.end(),
-             [&](const auto& this_outcome) { return this_outcome == outcome; }
-          )
-          != all_outcomes.end();
 }
-bool State::_all_cards_engaged() const
+
+std::pair< float, float > State::raise_range() const
 {
-   return std::all_of(m_player_cards.begin(), m_player_cards.end(), [](const auto& opt_card) {
-      return opt_card.has_value();
-   });
+   auto p = as_int(m_active_player);
+   auto call_amount = _to_call(m_active_player);
+   float all_in = m_stacks[p] - call_amount;
+   return std::visit(
+      [&]< typename T >(const T& limit) {
+         if constexpr(std::is_same_v< T, float >) {
+            auto size = std::min(limit, all_in);
+            return std::pair{size, size};
+         } else {
+            if(limit == BetLimit::limit) {
+               auto size = std::min(_fixed_raise_size(), all_in);
+               return std::pair{size, size};
+            }
+            float max_raise = all_in;
+            if(limit == BetLimit::pot_limit) {
+               // the raise may be as large as the pot after calling
+               max_raise = std::min(float(pot()) + call_amount, all_in);
+            }
+            return std::pair{std::min(m_last_raise, max_raise), max_raise};
+         }
+      },
+      config().bet_size_limits[m_round]
+   );
 }
 
-std::vector< ChanceOutcome > State::chance_actions() const
+std::vector< Action > State::actions() const
 {
-   if(not m_history.sequence.empty() or _all_cards_engaged()) {
+   if(m_is_terminal or m_active_player == Player::chance) {
       return {};
    }
-   Player player = m_player_cards[0].has_value() ? (Player::two) : (Player::one);
-   auto card_pool = m_card_pool;
-   if(m_player_cards[0].has_value()) {
-      card_pool.erase(
-         std::remove(card_pool.begin(), card_pool.end(), m_player_cards[0].value()), card_pool.end()
-      );
+   auto player = m_active_player;
+   auto call_amount = _to_call(player);
+   std::vector< Action > actions;
+   actions.reserve(5);
+   if(call_amount > chip_eps) {
+      actions.emplace_back(ActionType::fold);
+      actions.emplace_back(ActionType::call);
+   } else {
+      actions.emplace_back(ActionType::check);
    }
-   auto to_chance_action = [](const auto& player_card) {
-      return ChanceOutcome{std::get< 0 >(player_card), std::get< 1 >(player_card)};
+   if(not _can_raise(player)) {
+      return actions;
+   }
+   auto raise_type = _raise_type();
+   auto [min_raise, max_raise] = raise_range();
+   auto add_raise = [&](float amount) {
+      if(actions.back().action_type != raise_type or actions.back().bet + chip_eps < amount) {
+         actions.emplace_back(raise_type, amount);
+      }
    };
-   return ranges::to< std::vector< ChanceOutcome > >(
-      ranges::views::zip(ranges::views::repeat(player), card_pool)
-      | ranges::views::transform(to_chance_action)
-   );
+   add_raise(min_raise);
+   if(std::holds_alternative< BetLimit >(config().bet_size_limits[m_round])
+      and std::get< BetLimit >(config().bet_size_limits[m_round]) == BetLimit::no_limit) {
+      add_raise(std::min(float(pot()) + call_amount, max_raise));
+   }
+   add_raise(max_raise);
+   return actions;
 }
-std::vector< Action > State::actions() const
+
+bool State::is_valid(Action action) const
 {
-   if(not is_valid(Action::check)) {
-      return {};
+   if(m_is_terminal or m_active_player == Player::chance) {
+      return false;
    }
-   return std::vector< Action >{Action::check, Action::bet};
+   auto player = m_active_player;
+   bool facing_bet = _to_call(player) > chip_eps;
+   switch(action.action_type) {
+      case ActionType::fold:
+      case ActionType::call: {
+         return facing_bet;
+      }
+      case ActionType::check: {
+         return not facing_bet;
+      }
+      case ActionType::bet:
+      case ActionType::raise: {
+         if(action.action_type != _raise_type() or not _can_raise(player)) {
+            return false;
+         }
+         auto [min_raise, max_raise] = raise_range();
+         return action.bet >= min_raise - chip_eps and action.bet <= max_raise + chip_eps;
+      }
+   }
+   return false;
+}
+
+bool State::is_valid(Card outcome) const
+{
+   if(m_is_terminal or m_active_player != Player::chance) {
+      return false;
+   }
+   if(m_dealt & (uint64_t(1) << outcome.index())) {
+      return false;
+   }
+   return std::find(config().deck.begin(), config().deck.end(), outcome) != config().deck.end();
 }
-double State::chance_probability(ChanceOutcome) const
+
+std::vector< Card > State::chance_actions() const
 {
-   if(m_player_cards[0].has_value()) {
-      if(m_player_cards[1].has_value()) {
-         return 0.;
-      } else {
-         return 0.5;
+   if(m_is_terminal or m_active_player != Player::chance) {
+      return {};
+   }
+   std::vector< Card > outcomes;
+   outcomes.reserve(config().deck.size());
+   for(const auto& card : config().deck) {
+      if(not (m_dealt & (uint64_t(1) << card.index()))) {
+         outcomes.emplace_back(card);
       }
    }
-   return 1. / 3.;
+   return outcomes;
+}
+
+double State::chance_probability(Card) const
+{
+   return 1. / double(config().deck.size() - size_t(std::popcount(m_dealt)));
 }
 
-State::State(sptr< LeducConfig > config)
-    : m_remaining_players(), m_player_cards(), m_config(std::move(config))
+std::vector< double > State::payoff() const
 {
-   m_remaining_players.reserve(config->n_players);
-   m_player_cards.reserve(config->n_players);
-   for(size_t p = 0; p < config->n_players; p++) {
-      m_remaining_players.emplace_back(Player(p));
-      m_player_cards.emplace_back(std::nullopt);
+   auto n = n_players();
+   std::vector< double > payoffs(n, 0.);
+   if(not m_is_terminal) {
+      return payoffs;
+   }
+   // every player has lost their stake at first and then wins their share of the (side) pots
+   for(size_t p = 0; p < n; p++) {
+      payoffs[p] = -double(m_stakes[p]);
+   }
+   auto contenders = remaining_players();
+   if(contenders.size() == 1) {
+      payoffs[as_int(contenders[0])] += pot();
+      return payoffs;
+   }
+
+   const auto& evaluator = HandEvaluator::instance();
+   std::array< HandRank, max_players > hand_ranks{};
+   auto board_mask = to_mask(board());
+   for(auto player : contenders) {
+      hand_ranks[as_int(player)] = evaluator.evaluate(board_mask | to_mask(hole_cards(player)));
+   }
+
+   // the pot is split into layers at each distinct stake of the contenders. Each layer goes to the
+   // best hands among the contenders who paid into it in full.
+   std::vector< float > levels;
+   levels.reserve(contenders.size());
+   for(auto player : contenders) {
+      levels.emplace_back(m_stakes[as_int(player)]);
+   }
+   std::sort(levels.begin(), levels.end());
+   levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+
+   float previous_level = 0.f;
+   std::vector< Player > winners;
+   winners.reserve(contenders.size());
+   for(size_t i = 0; i < levels.size(); i++) {
+      auto level = levels[i];
+      bool last_layer = i + 1 == levels.size();
+      double layer_pot = 0.;
+      for(size_t p = 0; p < n; p++) {
+         // the last layer also collects whatever dead money lies above the highest contender
+         auto upper = last_layer ? std::max(level, m_stakes[p]) : level;
+         layer_pot += double(std::clamp(m_stakes[p], previous_level, upper) - previous_level);
+      }
+      winners.clear();
+      HandRank best = 0;
+      for(auto player : contenders) {
+         if(m_stakes[as_int(player)] + chip_eps < level) {
+            continue;
+         }
+         auto hand = hand_ranks[as_int(player)];
+         if(winners.empty() or hand > best) {
+            winners.clear();
+            best = hand;
+         }
+         if(hand == best) {
+            winners.emplace_back(player);
+         }
+      }
+      for(auto winner : winners) {
+         payoffs[as_int(winner)] += layer_pot / double(winners.size());
+      }
+      previous_level = level;
    }
+   return payoffs;
 }
 
 }  // namespace texholdem
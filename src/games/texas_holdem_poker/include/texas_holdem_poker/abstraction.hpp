@@ -0,0 +1,181 @@
+
+#ifndef NOR_TEXAS_HOLDEM_POKER_ABSTRACTION_HPP
+#define NOR_TEXAS_HOLDEM_POKER_ABSTRACTION_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "texas_holdem_poker/hand_indexer.hpp"
+
+namespace texholdem {
+
+/// a bucket id of the card abstraction
+using Bucket = uint16_t;
+
+/**
+ * @brief The settings of the offline card abstraction pipeline.
+ *
+ * Every hand (suit-isomorphism class) of a round is described by the histogram of its equity
+ * against a uniformly random opponent hand over sampled completions of the board. Hands are then
+ * clustered by k-means under the earth mover's distance of these histograms.
+ *
+ * Rounds whose histograms would take more than `max_histogram_bytes` (e.g. the turn and river of
+ * full hold'em) are never held in memory at once. Their centroids are fitted by mini-batch k-means
+ * on randomly drawn hands instead, and every hand is assigned in a final streaming pass.
+ */
+struct BucketingConfig {
+   /// the number of buckets of each round. Rounds beyond its size are not bucketed.
+   std::vector< size_t > n_buckets = {};
+   size_t n_histogram_bins = 50;
+   /// the sampled completions of the board per hand (the final round always has exactly one)
+   size_t n_rollouts = 64;
+   /// the sampled opponent hands per equity estimate (0 enumerates all of them)
+   size_t n_opponent_samples = 0;
+   size_t max_kmeans_iterations = 100;
+   /// the memory the histograms of a round may take before the round is clustered from streamed
+   /// mini-batches instead
+   size_t max_histogram_bytes = size_t(1) << 30;
+   /// the hands drawn per mini-batch of a streamed round
+   size_t minibatch_size = size_t(1) << 16;
+   /// the mini-batches fitted per streamed round (the first one seeds the centroids)
+   size_t n_minibatches = 50;
+   /// the number of worker threads (0 uses all hardware threads)
+   size_t n_threads = 0;
+   uint64_t seed = 0;
+};
+
+/// the equity histograms of all hands of a round (`n_histogram_bins` consecutive values per hand),
+/// computed on `config.n_threads` threads
+std::vector< float > equity_histograms(
+   const HandIndexer& indexer,
+   size_t round,
+   const BucketingConfig& config
+);
+
+/// the equity histograms of the hands of the given indices of a round
+std::vector< float > equity_histograms(
+   const HandIndexer& indexer,
+   size_t round,
+   std::span< const HandIndexer::index_type > indices,
+   const BucketingConfig& config
+);
+
+/// the equity histogram of a single hand (given as card ids in round order)
+std::vector< float > equity_histogram(
+   const HandIndexer& indexer,
+   std::span< const uint8_t > card_ids,
+   const BucketingConfig& config
+);
+
+/// the expected equity of a histogram
+double mean_equity(std::span< const float > histogram);
+
+struct Clustering {
+   /// the cluster of each point, clusters are ordered by the mean equity of their centroid
+   std::vector< Bucket > assignment;
+   /// the centroid histograms (`n_bins` consecutive values per cluster)
+   std::vector< float > centroids;
+   size_t n_iterations = 0;
+};
+
+/**
+ * @brief Clusters histograms by k-means under the earth mover's distance.
+ *
+ * In one dimension the earth mover's distance is the L1 distance of the cumulative distributions,
+ * so the points are clustered by their CDFs, with k-means++ seeding. Seeding, assignment and update
+ * steps are all split across `config.n_threads` threads. Every reduction runs over fixed chunks of
+ * the points, so the clustering does not depend on the number of threads.
+ */
+Clustering emd_kmeans(
+   std::span< const float > histograms,
+   size_t n_bins,
+   size_t n_clusters,
+   const BucketingConfig& config
+);
+
+/**
+ * @brief Clusters all hands of a round without holding their histograms in memory.
+ *
+ * The centroids are seeded by clustering one mini-batch of randomly drawn hands and refined by the
+ * mini-batch k-means updates (with per-centroid learning rates) of the following ones. Every hand
+ * is then assigned to its nearest centroid while its histogram is computed. The result depends on
+ * the seed only, not on the number of threads.
+ *
+ * @return the bucket of every hand index, ordered by the mean equity of their centroids
+ */
+std::vector< Bucket > streamed_emd_kmeans(
+   const HandIndexer& indexer,
+   size_t round,
+   size_t n_clusters,
+   const BucketingConfig& config
+);
+
+/// runs the full pipeline and returns the bucket of every hand index of each bucketed round
+std::vector< std::vector< Bucket > >
+compute_buckets(const HandIndexer& indexer, const BucketingConfig& config);
+
+/// writes the buckets of each round to a file that `BucketMap` can map into memory
+void write_bucket_file(
+   const std::filesystem::path& path,
+   const std::vector< std::vector< Bucket > >& buckets,
+   std::span< const size_t > n_buckets
+);
+
+/**
+ * @brief A read-only memory mapping of a bucket file.
+ *
+ * The buckets are looked up directly in the mapped file, so that only the pages of the hands that
+ * are actually visited are ever loaded.
+ */
+class BucketMap {
+  public:
+   /// maps the file into memory (throws if it is missing or not a valid bucket file)
+   static BucketMap open(const std::filesystem::path& path);
+
+   BucketMap(const BucketMap&) = delete;
+   BucketMap& operator=(const BucketMap&) = delete;
+   BucketMap(BucketMap&& other) noexcept;
+   BucketMap& operator=(BucketMap&& other) noexcept;
+   ~BucketMap();
+
+   [[nodiscard]] size_t n_rounds() const { return m_rounds.size(); }
+   [[nodiscard]] size_t n_buckets(size_t round) const { return m_rounds[round].n_buckets; }
+   [[nodiscard]] HandIndexer::index_type round_size(size_t round) const
+   {
+      return m_rounds[round].size;
+   }
+   /// the bucket of the hand index in the round (throws if either is out of range)
+   [[nodiscard]] Bucket bucket(size_t round, HandIndexer::index_type index) const
+   {
+      const auto& mapped_round = m_rounds.at(round);
+      if(index >= mapped_round.size) {
+         throw std::out_of_range(
+            "Hand index " + std::to_string(index) + " is out of range for round "
+            + std::to_string(round)
+         );
+      }
+      return mapped_round.buckets[index];
+   }
+
+  private:
+   struct Round {
+      const Bucket* buckets;
+      HandIndexer::index_type size;
+      size_t n_buckets;
+   };
+
+   void* m_data = nullptr;
+   size_t m_size = 0;
+   std::vector< Round > m_rounds;
+
+   BucketMap() = default;
+   void _unmap();
+};
+
+}  // namespace texholdem
+
+#endif  // NOR_TEXAS_HOLDEM_POKER_ABSTRACTION_HPP
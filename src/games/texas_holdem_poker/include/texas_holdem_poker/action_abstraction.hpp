@@ -0,0 +1,140 @@
+
+#ifndef NOR_TEXAS_HOLDEM_POKER_ACTION_ABSTRACTION_HPP
+#define NOR_TEXAS_HOLDEM_POKER_ACTION_ABSTRACTION_HPP
+
+#include <algorithm>
+#include <random>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "texas_holdem_poker/state.hpp"
+
+namespace texholdem {
+
+/**
+ * @brief Maps arbitrary bet sizes onto a sorted grid of bet sizes by the pseudo-harmonic mapping.
+ *
+ * A size x between the neighbouring grid sizes A < x < B (all as fractions of the pot) is mapped to
+ * A with probability
+ *
+ *    f(x) = (B - x) (1 + A) / ((B - A) (1 + x))
+ *
+ * and to B otherwise, which is the mapping least exploitable by bets in between the grid (Ganzfried
+ * and Sandholm, 2013). Sizes outside of the grid map to its closest end. The neighbours are found by
+ * binary search, so translating takes O(log k) for k grid sizes.
+ */
+class ActionTranslator {
+  public:
+   struct Translation {
+      /// the grid indices of the neighbouring sizes (equal if the size is matched exactly)
+      size_t lower;
+      size_t upper;
+      /// the probability of translating to the lower size
+      double lower_probability;
+   };
+
+   explicit ActionTranslator(std::vector< double > sizes);
+
+   /// the probability with which x is mapped to A (rather than B) for the grid neighbours A < B
+   static double pseudo_harmonic(double lower, double upper, double x)
+   {
+      return (upper - x) * (1. + lower) / ((upper - lower) * (1. + x));
+   }
+
+   [[nodiscard]] Translation translate(double size) const { return translate(m_sizes, size); }
+   /// translates onto the given sorted grid of sizes
+   [[nodiscard]] static Translation translate(std::span< const double > sizes, double size)
+   {
+      return translate(sizes.size(), [&](size_t idx) { return sizes[idx]; }, size);
+   }
+   /// translates onto a non-decreasing grid of `n_sizes` sizes, of which only the O(log n) probed
+   /// ones are computed by `size_at(idx)`. Equal grid sizes are translated to the last of them.
+   template < typename SizeAt >
+   [[nodiscard]] static Translation translate(size_t n_sizes, SizeAt&& size_at, double size)
+   {
+      auto upper = *std::ranges::partition_point(
+         std::views::iota(size_t(0), n_sizes), [&](size_t idx) { return size_at(idx) <= size; }
+      );
+      if(upper == 0) {
+         return {0, 0, 1.};
+      }
+      auto lower = upper - 1;
+      auto lower_size = size_at(lower);
+      if(upper == n_sizes or lower_size == size) {
+         return {lower, lower, 1.};
+      }
+      return {lower, upper, pseudo_harmonic(lower_size, size_at(upper), size)};
+   }
+
+   /// samples the grid index that the size is translated to
+   template < typename RNG >
+   [[nodiscard]] size_t sample(double size, RNG& rng) const
+   {
+      auto [lower, upper, lower_probability] = translate(size);
+      return std::bernoulli_distribution{lower_probability}(rng) ? lower : upper;
+   }
+
+   [[nodiscard]] const auto& sizes() const { return m_sizes; }
+
+  private:
+   std::vector< double > m_sizes;
+};
+
+/**
+ * @brief The bet-size abstraction of no-limit (and pot-limit) Hold'em.
+ *
+ * The abstract game only allows raises by the given fractions of the pot after calling (clamped to
+ * the legal raise range) and, optionally, the all-in. Fixed-limit rounds are unaffected since they
+ * offer a single raise size anyway. At play time, `translate` maps the real actions of opponents
+ * onto the abstract actions of the same state.
+ */
+class ActionAbstraction {
+  public:
+   explicit ActionAbstraction(std::vector< double > pot_fractions = {.5, 1.}, bool all_in = true);
+
+   /// the abstract legal actions of the active player
+   [[nodiscard]] std::vector< Action > actions(const State& state) const;
+
+   /// The abstract actions a real action of the active player translates to, with their
+   /// probabilities. Actions that are part of the abstraction translate to themselves. Raises are
+   /// translated by an `ActionTranslator` on the pot fractions of the state's abstract raises, of
+   /// which only the O(log k) probed ones are built.
+   [[nodiscard]] std::vector< std::pair< Action, double > >
+   translate(const State& state, const Action& action) const;
+
+   /// samples the abstract action that a real action of the active player translates to
+   template < typename RNG >
+   [[nodiscard]] Action translate(const State& state, const Action& action, RNG& rng) const
+   {
+      auto translation = translate(state, action);
+      if(translation.size() == 1) {
+         return translation.front().first;
+      }
+      return std::bernoulli_distribution{translation.front().second}(rng)
+                ? translation.front().first
+                : translation.back().first;
+   }
+
+   /// the size of a raise as a fraction of the pot after calling
+   [[nodiscard]] static double pot_fraction(const State& state, float raise);
+
+   [[nodiscard]] const auto& pot_fractions() const { return m_translator.sizes(); }
+   [[nodiscard]] bool all_in() const { return m_all_in; }
+
+  private:
+   ActionTranslator m_translator;
+   bool m_all_in;
+
+   /// the raise by the given pot fraction in this state (clamped to the legal raise range)
+   [[nodiscard]] static Action _raise(const State& state, ActionType raise_type, double fraction);
+   /// the abstract raise of the given index on the grid of pot fractions (the all-in after them)
+   [[nodiscard]] Action _grid_raise(const State& state, ActionType raise_type, size_t idx) const;
+   /// the distinct abstract raises in this state in ascending order
+   [[nodiscard]] std::vector< Action > _raises(const State& state, ActionType raise_type) const;
+};
+
+}  // namespace texholdem
+
+#endif  // NOR_TEXAS_HOLDEM_POKER_ACTION_ABSTRACTION_HPP
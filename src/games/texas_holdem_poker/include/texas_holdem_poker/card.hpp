@@ -0,0 +1,66 @@
+
+#ifndef NOR_TEXAS_HOLDEM_POKER_CARD_HPP
+#define NOR_TEXAS_HOLDEM_POKER_CARD_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace texholdem {
+
+enum class Rank : uint8_t {
+   two = 2,
+   three = 3,
+   four = 4,
+   five = 5,
+   six = 6,
+   seven = 7,
+   eight = 8,
+   nine = 9,
+   ten = 10,
+   jack = 11,
+   queen = 12,
+   king = 13,
+   ace = 14
+};
+
+enum class Suit : uint8_t { diamonds = 0, clubs = 1, hearts = 2, spades = 3 };
+
+inline constexpr size_t n_ranks = 13;
+inline constexpr size_t n_suits = 4;
+inline constexpr size_t n_cards = n_ranks * n_suits;
+
+struct Card {
+   Rank rank;
+   Suit suit;
+
+   /// the dense index of the card in [0, 52): rank-major, suit-minor
+   [[nodiscard]] constexpr uint8_t index() const
+   {
+      return uint8_t((uint8_t(rank) - 2) * n_suits + uint8_t(suit));
+   }
+
+   static constexpr Card from_index(size_t index)
+   {
+      return {Rank(index / n_suits + 2), Suit(index % n_suits)};
+   }
+};
+
+inline constexpr bool operator==(const Card& card1, const Card& card2)
+{
+   return card1.rank == card2.rank and card1.suit == card2.suit;
+}
+
+/// the standard 52-card deck ordered by card index
+inline std::vector< Card > full_deck()
+{
+   std::vector< Card > deck;
+   deck.reserve(n_cards);
+   for(size_t i = 0; i < n_cards; i++) {
+      deck.emplace_back(Card::from_index(i));
+   }
+   return deck;
+}
+
+}  // namespace texholdem
+
+#endif  // NOR_TEXAS_HOLDEM_POKER_CARD_HPP
@@ -0,0 +1,143 @@
+
+#ifndef NOR_TEXAS_HOLDEM_POKER_EVALUATOR_HPP
+#define NOR_TEXAS_HOLDEM_POKER_EVALUATOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "texas_holdem_poker/card.hpp"
+#include "texas_holdem_poker/hand_rank.hpp"
+
+namespace texholdem {
+
+/// a set of cards as a bitmask over the card indices (see `Card::index`)
+using CardMask = uint64_t;
+
+inline CardMask to_mask(std::span< const Card > cards)
+{
+   CardMask mask = 0;
+   for(const auto& card : cards) {
+      mask |= CardMask(1) << card.index();
+   }
+   return mask;
+}
+
+namespace detail {
+
+inline constexpr size_t max_eval_cards = 7;
+
+/// `rank_multiset_counts[r][k]` is the number of multisets of k ranks drawn from the ranks [r, 13)
+/// with each rank taken at most 4 times.
+inline constexpr auto rank_multiset_counts = [] {
+   std::array< std::array< uint32_t, max_eval_cards + 1 >, n_ranks + 1 > counts{};
+   for(auto& row : counts) {
+      row[0] = 1;
+   }
+   for(size_t r = n_ranks; r-- > 0;) {
+      for(size_t k = 1; k <= max_eval_cards; k++) {
+         counts[r][k] = 0;
+         for(size_t c = 0; c <= std::min(k, n_suits); c++) {
+            counts[r][k] += counts[r + 1][k - c];
+         }
+      }
+   }
+   return counts;
+}();
+
+/// The perfect hash of the rank multiset of a hand into [0, rank_multiset_counts[0][n]) for n
+/// cards. Visiting the cards in ascending rank order, each card adds the number of multisets of
+/// the cards left (itself included) that only use higher ranks.
+inline uint32_t rank_multiset_hash(uint64_t hand)
+{
+   uint32_t hash = 0;
+   auto cards_left = size_t(std::popcount(hand));
+   for(; hand != 0; hand &= hand - 1) {
+      auto rank_idx = size_t(std::countr_zero(hand)) / n_suits;
+      hash += rank_multiset_counts[rank_idx + 1][cards_left--];
+   }
+   return hash;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Table-driven evaluator of hands with up to 7 cards.
+ *
+ * Hands containing a flush are looked up by the 13-bit rank mask of the flush suit (with at most 7
+ * cards no other hand can beat a flush except a straight flush, which the flush table already
+ * resolves). All other hands only depend on the multiset of their ranks, which is perfectly hashed
+ * into a dense table per card count. The ranks agree exactly with `rank_hand`, which generates the
+ * tables.
+ */
+class HandEvaluator {
+  public:
+   /// Generates all tables.
+   HandEvaluator();
+
+   /// The process-wide evaluator. Its tables are generated on first use, or loaded from the file
+   /// named by the environment variable NOR_HOLDEM_EVALUATOR_TABLES if set (and written there if
+   /// the file does not hold valid tables yet).
+   static const HandEvaluator& instance();
+
+   /// loads tables previously written by `save`. Returns nothing if the file is missing or invalid.
+   static std::optional< HandEvaluator > load(const std::filesystem::path& path);
+   /// writes the tables to disk. Returns whether this succeeded.
+   bool save(const std::filesystem::path& path) const;
+
+   /// ranks a hand of at most 7 cards (throws for larger hands)
+   [[nodiscard]] HandRank evaluate(CardMask hand) const
+   {
+      std::array< uint16_t, n_suits > suit_masks{};
+      auto hand_size = size_t(std::popcount(hand));
+      if(hand_size > detail::max_eval_cards) {
+         _throw_too_many_cards(hand_size);
+      }
+      auto cards_left = hand_size;
+      uint32_t hash = 0;
+      for(auto rest = hand; rest != 0; rest &= rest - 1) {
+         auto card_idx = size_t(std::countr_zero(rest));
+         auto rank_idx = card_idx / n_suits;
+         hash += detail::rank_multiset_counts[rank_idx + 1][cards_left--];
+         suit_masks[card_idx % n_suits] |= uint16_t(1u << rank_idx);
+      }
+      for(auto suit_mask : suit_masks) {
+         if(std::popcount(suit_mask) >= 5) {
+            return m_flush_table[suit_mask];
+         }
+      }
+      return m_rank_table[m_rank_table_offsets[hand_size] + hash];
+   }
+
+   /// ranks a hand of at most 7 cards (throws for larger hands)
+   [[nodiscard]] HandRank evaluate(std::span< const Card > cards) const;
+
+   /// Ranks a batch of hands (each of at most 7 cards, throws otherwise) into `ranks`. The hands
+   /// are processed in blocks, pass by pass over the structure-of-arrays state of the block: the
+   /// suit counts (and thus flushes) come from bit-parallel sums instead of a loop over the cards,
+   /// the rank hashes of all hands advance one card per step in lockstep so that their dependency
+   /// chains interleave, and the table lookups come last.
+   void evaluate(std::span< const CardMask > hands, std::span< HandRank > ranks) const;
+
+  private:
+   /// indexed by the 13-bit rank mask of the flush suit
+   std::vector< HandRank > m_flush_table;
+   /// indexed by the rank multiset hash, offset by the card count
+   std::vector< HandRank > m_rank_table;
+   std::array< uint32_t, detail::max_eval_cards + 2 > m_rank_table_offsets{};
+
+   struct uninitialized_tag {};
+   explicit HandEvaluator(uninitialized_tag);
+
+   void _init_rank_table_offsets();
+   [[noreturn]] static void _throw_too_many_cards(size_t hand_size);
+};
+
+}  // namespace texholdem
+
+#endif  // NOR_TEXAS_HOLDEM_POKER_EVALUATOR_HPP
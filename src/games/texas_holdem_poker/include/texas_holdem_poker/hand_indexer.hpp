@@ -0,0 +1,99 @@
+
+#ifndef NOR_TEXAS_HOLDEM_POKER_HAND_INDEXER_HPP
+#define NOR_TEXAS_HOLDEM_POKER_HAND_INDEXER_HPP
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "texas_holdem_poker/card.hpp"
+
+namespace texholdem {
+
+/**
+ * @brief Maps the cards a player holds in a round to a dense index under suit isomorphism.
+ *
+ * Two hands are isomorphic if a permutation of the suits maps one onto the other (with the cards
+ * of each round kept apart, i.e. a hole card and an identical board card are not interchangeable).
+ * Isomorphic hands are strategically identical, so keying information sets on the index instead of
+ * the cards shrinks them by up to the number of suit permutations (e.g. 1326 preflop hands to 169).
+ *
+ * A hand is given as the card ids of all rounds up to the current one in round order, where a card
+ * id is `rank * n_suits + suit` (the `Card::index` of the standard deck). Indexing sorts the suits
+ * into a canonical order by their per-round card counts, looks up the resulting suit configuration
+ * and combines the colex indices of each suit's rank sets into a mixed-radix number. All steps are
+ * bounded by the (constant) numbers of cards, suits and configurations. `unindex` inverts this and
+ * yields the canonical representative of the isomorphism class.
+ *
+ * The geometry of the deck is configurable so that smaller poker variants (e.g. Leduc) can use the
+ * same indexer.
+ */
+class HandIndexer {
+  public:
+   using index_type = uint64_t;
+
+   static constexpr size_t max_suits = 4;
+   static constexpr size_t max_ranks = 16;
+   static constexpr size_t max_rounds = 8;
+
+   /// @param cards_per_round the number of cards the player receives in each round (e.g. {2, 3, 1,
+   /// 1} for hole cards, flop, turn and river)
+   explicit HandIndexer(
+      std::vector< size_t > cards_per_round,
+      size_t rank_count = texholdem::n_ranks,
+      size_t suit_count = texholdem::n_suits
+   );
+
+   /// the indexer of standard hold'em (hole cards, flop, turn, river)
+   static const HandIndexer& holdem();
+
+   [[nodiscard]] size_t n_rounds() const { return m_cards_per_round.size(); }
+   [[nodiscard]] size_t n_ranks() const { return m_n_ranks; }
+   [[nodiscard]] size_t n_suits() const { return m_n_suits; }
+   [[nodiscard]] const auto& cards_per_round() const { return m_cards_per_round; }
+   /// the number of cards held in total after the given round
+   [[nodiscard]] size_t cards_until(size_t round) const { return m_cards_until[round + 1]; }
+   /// the round after which a player holds the given number of cards (throws if there is none)
+   [[nodiscard]] size_t round_of(size_t hand_size) const;
+   /// the number of isomorphism classes of hands in the given round
+   [[nodiscard]] index_type round_size(size_t round) const { return m_round_sizes.at(round); }
+
+   /// The index of a hand given by the card ids of all rounds so far. The round is deduced from the
+   /// number of cards, which has to match `cards_until(round)` for some round.
+   [[nodiscard]] index_type index(std::span< const uint8_t > card_ids) const;
+   [[nodiscard]] index_type index(std::span< const Card > cards) const;
+
+   /// the card ids of the canonical hand with the given index in the given round (in round order)
+   [[nodiscard]] std::vector< uint8_t > unindex(size_t round, index_type index) const;
+
+  private:
+   using suit_counts = std::array< uint8_t, max_rounds >;
+
+   struct Configuration {
+      /// the per-round card counts of each suit, sorted in descending order
+      std::array< suit_counts, max_suits > counts;
+      /// the number of suits sharing the counts of the suit at the start of each group (0 for the
+      /// other suits of a group)
+      std::array< uint8_t, max_suits > group_sizes;
+      /// the number of distinct rank sets of a suit with these counts
+      std::array< index_type, max_suits > suit_sizes;
+      index_type offset;
+      index_type size;
+   };
+
+   std::vector< size_t > m_cards_per_round;
+   std::vector< size_t > m_cards_until;
+   size_t m_n_ranks;
+   size_t m_n_suits;
+   /// the configurations of each round, ordered by their counts
+   std::vector< std::vector< Configuration > > m_configurations;
+   std::vector< index_type > m_round_sizes;
+
+   [[nodiscard]] index_type _suit_size(const suit_counts& counts, size_t round) const;
+   void _enumerate_configurations(size_t round);
+};
+
+}  // namespace texholdem
+
+#endif  // NOR_TEXAS_HOLDEM_POKER_HAND_INDEXER_HPP
@@ -0,0 +1,44 @@
+
+#ifndef NOR_TEXAS_HOLDEM_POKER_HAND_RANK_HPP
+#define NOR_TEXAS_HOLDEM_POKER_HAND_RANK_HPP
+
+#include <cstdint>
+#include <span>
+
+#include "texas_holdem_poker/card.hpp"
+
+namespace texholdem {
+
+enum class HandCategory : uint8_t {
+   high_card = 0,
+   pair = 1,
+   two_pair = 2,
+   three_of_a_kind = 3,
+   straight = 4,
+   flush = 5,
+   full_house = 6,
+   four_of_a_kind = 7,
+   straight_flush = 8
+};
+
+/**
+ * @brief The strength of the best 5-card hand that can be formed from a set of cards.
+ *
+ * Higher values are stronger hands and equal values are exact ties. The category occupies the bits
+ * from 20 upwards, followed by up to five 4-bit rank indices (2 -> 0, ..., ace -> 12) which break
+ * ties within the category in order of significance.
+ */
+using HandRank = uint32_t;
+
+inline HandCategory category(HandRank rank)
+{
+   return HandCategory(rank >> 20);
+}
+
+/// Ranks the best 5-card hand within the given cards (any number of cards up to 7 and beyond).
+/// Hands with fewer than 5 cards are ranked on the cards available.
+HandRank rank_hand(std::span< const Card > cards);
+
+}  // namespace texholdem
+
+#endif  // NOR_TEXAS_HOLDEM_POKER_HAND_RANK_HPP
@@ -3,13 +3,17 @@
 #define NOR_TEXAS_HOLDEM_POKER_STATE_HPP
 
 #include <array>
-#include <optional>
-#include <range/v3/all.hpp>
-#include <sstream>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <span>
 #include <variant>
 #include <vector>
 
 #include "common/common.hpp"
+#include "texas_holdem_poker/card.hpp"
+#include "texas_holdem_poker/evaluator.hpp"
+#include "texas_holdem_poker/hand_rank.hpp"
 
 namespace texholdem {
 
@@ -27,226 +31,228 @@ enum class Player {
    ten = 9
 };
 
-enum class Rank {
-   two = 2,
-   three = 3,
-   four = 4,
-   five = 5,
-   six = 6,
-   seven = 7,
-   eight = 8,
-   nine = 9,
-   ten = 10,
-   jack = 11,
-   queen = 12,
-   king = 13,
-   ace = 14
+template < std::integral To = size_t, typename T >
+inline To as_int(T p)
+{
+   // we let things silently fail in the call site if Player::chance is passed in here for example
+   return static_cast< To >(p);
 };
 
-enum class Suit { diamonds = 0, clubs = 1, hearts = 2, spades = 3 };
+inline constexpr size_t max_players = 10;
+inline constexpr size_t hole_cards_per_player = 2;
+inline constexpr size_t max_board_cards = 5;
 
-struct Card {
-   Rank rank;
-   Suit suit;
+enum class ActionType : uint8_t {
+   check = 0,
+   call = 1,
+   bet = 2,  // the first bet of a betting round
+   raise = 3,  // any bet on top of an existing bet (the blinds count as the bet of the preflop)
+   fold = 4
 };
 
-inline bool operator==(const Card& card1, const Card& card2)
-{
-   return card1.rank == card2.rank and card1.suit == card2.suit;
-}
-
-enum class ActionType { check = 0, call = 1, bet = 2, raise = 3 };
-
 struct Action {
    ActionType action_type;
-   float bet;
+   /// the amount by which a bet/raise increases the highest stake at the table. Calls, checks and
+   /// folds carry no amount, the call amount follows from the state.
+   float bet = 0.f;
 };
 
 inline bool operator==(const Action& action1, const Action& action2)
 {
-   // we are never expecting large floating point values here so the absolute comparison should
-   // suffice for the use case at hand
-   return action1.action_type == action2.action_type
-          and std::fabs(action1.bet - action2.bet) <= std::numeric_limits< float >::epsilon();
-}
-
-struct ChanceOutcome {
-   Player player;
-   Card card;
-};
-
-inline bool operator==(const ChanceOutcome& outcome1, const ChanceOutcome& outcome2)
-{
-   return outcome1.player == outcome2.player and outcome1.card == outcome2.card;
+   // the amounts are compared exactly to stay consistent with std::hash< Action >. The state
+   // offers every amount exactly as it validates it, so no tolerance is needed here.
+   return action1.action_type == action2.action_type and action1.bet == action2.bet;
 }
 
+/// The betting structure of a round. Limit rounds raise by a fixed amount (the big blind in the
+/// first two betting rounds and twice the big blind afterwards, unless the size is given as a
+/// float). Pot-limit rounds raise by at most the pot after calling, no-limit rounds by any amount
+/// up to the player's remaining stack.
 enum class BetLimit { limit = 1, no_limit = 0, pot_limit = 2 };
 
-enum class PokerToken { dealer = 0, small_blind = 1, big_blind = 2 };
-
-template < typename T, std::integral To = size_t >
-inline auto as_int(T p)
-{
-   // we let things silently fail in the call site if an incorrect value is passed in here
-   return static_cast< To >(p);
-};
-
+/**
+ * @brief The rules of a Hold'em variant.
+ *
+ * The game consists of a preflop betting round followed by `n_rounds` rounds which each reveal
+ * `boardcards_per_round[i]` public cards and are followed by another betting round. The per-round
+ * betting settings `bet_size_limits` and `bet_nr_limits` thus need `n_rounds + 1` entries, with
+ * index 0 being the preflop.
+ */
 struct PokerConfig {
-   size_t n_players;
-   // how many rounds should the game last? 3 rounds is standard (flop-turn-river)
+   size_t n_players = 2;
+   // how many board rounds should the game last? 3 rounds is standard (flop-turn-river)
    size_t n_rounds = 3;
    // how many boardcards are going to be drawn on each round (index i is #cards of round i)
    std::vector< size_t > boardcards_per_round = {3, 1, 1};
-   // the starting amount the big blind will need to pay.
-   float small_blind = 0.f;
    // the starting amount the small blind will need to pay.
-   float big_blind = 0.f;
-   // what holdem variant is to be played in each round? Limit/No-Limit/Pot-Limit
-   std::vector< std::variant< BetLimit, float > > bet_size_limits;
-   // how often can players raise the bet in each round
+   float small_blind = 1.f;
+   // the starting amount the big blind will need to pay.
+   float big_blind = 2.f;
+   // the starting stack of each player. Defaults to 100 big blinds for everyone if left empty.
+   std::vector< float > stacks = {};
+   // the player on the button. Heads-up the button posts the small blind, otherwise the two
+   // players after the button post the blinds.
+   Player dealer = Player::one;
+   // what holdem variant is to be played in each betting round? Limit/No-Limit/Pot-Limit or a
+   // fixed limit raise size
+   std::vector< std::variant< BetLimit, float > > bet_size_limits = {
+      BetLimit::no_limit,
+      BetLimit::no_limit,
+      BetLimit::no_limit,
+      BetLimit::no_limit};
+   // how often can players bet/raise in each betting round
    std::vector< size_t > bet_nr_limits = {
+      std::dynamic_extent,
       std::dynamic_extent,
       std::dynamic_extent,
       std::dynamic_extent};
    // the starting deck to play with
-   std::vector< Card > deck = {
-      {Rank::two, Suit::diamonds},   {Rank::two, Suit::clubs},
-      {Rank::two, Suit::hearts},     {Rank::two, Suit::spades},
-
-      {Rank::three, Suit::diamonds}, {Rank::three, Suit::clubs},
-      {Rank::three, Suit::hearts},   {Rank::three, Suit::spades},
-
-      {Rank::four, Suit::diamonds},  {Rank::four, Suit::clubs},
-      {Rank::four, Suit::hearts},    {Rank::four, Suit::spades},
+   std::vector< Card > deck = full_deck();
 
-      {Rank::five, Suit::diamonds},  {Rank::five, Suit::clubs},
-      {Rank::five, Suit::hearts},    {Rank::five, Suit::spades},
-
-      {Rank::six, Suit::diamonds},   {Rank::six, Suit::clubs},
-      {Rank::six, Suit::hearts},     {Rank::six, Suit::spades},
-
-      {Rank::seven, Suit::diamonds}, {Rank::seven, Suit::clubs},
-      {Rank::seven, Suit::hearts},   {Rank::seven, Suit::spades},
-
-      {Rank::eight, Suit::diamonds}, {Rank::eight, Suit::clubs},
-      {Rank::eight, Suit::hearts},   {Rank::eight, Suit::spades},
-
-      {Rank::nine, Suit::diamonds},  {Rank::nine, Suit::clubs},
-      {Rank::nine, Suit::hearts},    {Rank::nine, Suit::spades},
-
-      {Rank::ten, Suit::diamonds},   {Rank::ten, Suit::clubs},
-      {Rank::ten, Suit::hearts},     {Rank::ten, Suit::spades},
-
-      {Rank::jack, Suit::diamonds},  {Rank::jack, Suit::clubs},
-      {Rank::jack, Suit::hearts},    {Rank::jack, Suit::spades},
-
-      {Rank::queen, Suit::diamonds}, {Rank::queen, Suit::clubs},
-      {Rank::queen, Suit::hearts},   {Rank::queen, Suit::spades},
+   /// heads-up (or n-player) fixed limit hold'em with the usual cap of 4 bets per round
+   static PokerConfig limit(size_t n_players = 2)
+   {
+      return PokerConfig{
+         .n_players = n_players,
+         .bet_size_limits = {BetLimit::limit, BetLimit::limit, BetLimit::limit, BetLimit::limit},
+         // the big blind counts as the first bet of the preflop
+         .bet_nr_limits = {3, 4, 4, 4}};
+   }
 
-      {Rank::king, Suit::diamonds},  {Rank::king, Suit::clubs},
-      {Rank::king, Suit::hearts},    {Rank::king, Suit::spades},
+   /// no-limit hold'em with the given stacks in big blinds
+   static PokerConfig no_limit(size_t n_players = 2, float stack_in_big_blinds = 100.f)
+   {
+      PokerConfig config{.n_players = n_players};
+      config.stacks.assign(n_players, stack_in_big_blinds * config.big_blind);
+      return config;
+   }
 
-      {Rank::ace, Suit::diamonds},   {Rank::ace, Suit::clubs},
-      {Rank::ace, Suit::hearts},     {Rank::ace, Suit::spades},
-   };
+   [[nodiscard]] size_t n_betting_rounds() const { return n_rounds + 1; }
 };
 
 /**
- * @brief stores the currently commited action sequence
+ * @brief The world state of a Hold'em game.
  *
- * It's a simple wrapper for the action sequence to allow for std::hash specialization and
- * operator== overloading.
- */
-struct History {
-   std::vector< Action > sequence{};
-};
-
-inline bool operator==(const History& left, const History& right)
-{
-   if(left.sequence.size() != right.sequence.size()) {
-      return false;
-   }
-   return ranges::all_of(
-      ranges::views::zip(left.sequence, right.sequence),
-      [](const auto& paired_actions) {
-         const auto& [left_action, right_action] = paired_actions;
-         return left_action == right_action;
-      }
-   );
-}
-
-/**
- * @brief stores the currently commited action sequence
+ * The state is of fixed size for up to `max_players` players, so that copying it (as the solvers
+ * do at every node) is a flat memcpy and a reference count increment of the shared config. Cards
+ * are dealt by the chance player one at a time: first both hole cards of each player in seat
+ * order, then the board cards of each round.
  */
-class HistorySinceBet {
+class State {
   public:
-   HistorySinceBet(std::vector< std::optional< Action > > cont) : m_container(std::move(cont)) {}
-
-   auto& operator[](Player player) { return m_container[as_int(player)]; }
-
-   auto& operator[](Player player) const { return m_container[as_int(player)]; }
-
-   void reset()
+   State(sptr< const PokerConfig > config);
+   State(PokerConfig config = {}) : State(std::make_shared< const PokerConfig >(std::move(config)))
    {
-      ranges::for_each(m_container, [](auto& action_opt) { action_opt.reset(); });
    }
 
-   bool all_acted(const std::vector< Player >& remaining_players)
+   template < typename... Args >
+   auto apply_action(Args... args)
    {
-      return ranges::all_of(remaining_players, [&](Player player) {
-         return m_container[as_int(player)].has_value();
-      });
+      return apply_action({std::forward< Args >(args)...});
    }
-
-   auto& container() { return m_container; }
-   [[nodiscard]] auto& container() const { return m_container; }
-
-  private:
-   std::vector< std::optional< Action > > m_container{};
-};
-
-class State {
-  public:
-   State(sptr< PokerConfig > config);
-
    void apply_action(Action action);
-   void apply_action(ChanceOutcome action);
+   void apply_action(Card outcome);
+
+   template < typename... Args >
+   [[nodiscard]] auto is_valid(Args... args) const
+   {
+      return is_valid({std::forward< Args >(args)...});
+   }
    [[nodiscard]] bool is_valid(Action action) const;
-   [[nodiscard]] bool is_valid(ChanceOutcome outcome) const;
-   [[nodiscard]] bool is_terminal() const;
+   [[nodiscard]] bool is_valid(Card outcome) const;
+   [[nodiscard]] bool is_terminal() const { return m_is_terminal; }
+   /// the legal actions of the active player. For limit rounds this is exhaustive. In pot-limit
+   /// rounds only the minimum and the maximum (pot-sized) raise are offered, in no-limit rounds the
+   /// minimum raise, a pot-sized raise and the all-in. In both every raise amount between the
+   /// offered minimum and maximum is valid.
    [[nodiscard]] std::vector< Action > actions() const;
-   [[nodiscard]] std::vector< ChanceOutcome > chance_actions() const;
-   [[nodiscard]] double chance_probability(ChanceOutcome action) const;
-   [[nodiscard]] int16_t payoff(Player player) const;
+   [[nodiscard]] std::vector< Card > chance_actions() const;
+   [[nodiscard]] double chance_probability(Card outcome) const;
+   /// the net winnings of every player (zero for non-terminal states)
+   [[nodiscard]] std::vector< double > payoff() const;
+   [[nodiscard]] double payoff(Player player) const { return payoff()[as_int(player)]; }
 
    [[nodiscard]] auto active_player() const { return m_active_player; }
-   [[nodiscard]] auto card(Player player) const
+   [[nodiscard]] size_t n_players() const { return m_config->n_players; }
+   [[nodiscard]] const auto& config() const { return *m_config; }
+   [[nodiscard]] const auto& config_ptr() const { return m_config; }
+   /// the current betting round (0 is the preflop)
+   [[nodiscard]] size_t round_nr() const { return m_round; }
+   [[nodiscard]] std::span< const Card > hole_cards(Player player) const
+   {
+      auto offset = as_int(player) * hole_cards_per_player;
+      auto n_dealt = std::min(
+         hole_cards_per_player, size_t(m_n_hole_dealt) - std::min(size_t(m_n_hole_dealt), offset)
+      );
+      return std::span{m_hole_cards}.subspan(offset, n_dealt);
+   }
+   [[nodiscard]] std::span< const Card > board() const
    {
-      return m_player_cards[static_cast< uint8_t >(player)];
+      return std::span{m_board}.first(m_n_board);
    }
-   [[nodiscard]] auto& history() const { return m_history; }
-   [[nodiscard]] auto& cards() const { return m_player_cards; }
+   [[nodiscard]] size_t n_hole_cards_dealt() const { return m_n_hole_dealt; }
+   [[nodiscard]] uint64_t dealt_cards_mask() const { return m_dealt; }
+   [[nodiscard]] double stake(Player player) const { return m_stakes[as_int(player)]; }
+   [[nodiscard]] double stack(Player player) const { return m_stacks[as_int(player)]; }
+   [[nodiscard]] double pot() const;
+   [[nodiscard]] double highest_stake() const { return m_highest_stake; }
+   [[nodiscard]] double to_call(Player player) const { return _to_call(player); }
+   [[nodiscard]] bool has_folded(Player player) const { return m_folded & _bit(player); }
+   [[nodiscard]] bool is_all_in(Player player) const { return m_all_in & _bit(player); }
+   [[nodiscard]] size_t bets_this_round() const { return m_bets_this_round; }
+   /// the players who have not folded yet
+   [[nodiscard]] std::vector< Player > remaining_players() const;
+   /// the smallest and largest amount the active player may currently raise by
+   [[nodiscard]] std::pair< float, float > raise_range() const;
 
   private:
+   sptr< const PokerConfig > m_config;
+   std::array< Card, max_players * hole_cards_per_player > m_hole_cards{};
+   std::array< Card, max_board_cards > m_board{};
+   std::array< float, max_players > m_stakes{};
+   std::array< float, max_players > m_stacks{};
+   float m_highest_stake = 0.f;
+   /// the size of the last full raise, which the next raise needs to at least match
+   float m_last_raise = 0.f;
+   /// bitmask of the dealt card indices
+   uint64_t m_dealt = 0;
    Player m_active_player = Player::chance;
-   size_t m_round = 0;
-   std::vector< Player > m_remaining_players;
-   std::vector< std::optional< Card > > m_player_cards;
-   std::vector< std::optional< Card > > m_public_cards;
-   History m_action_history{};
-   History m_history_since_last_bet{};
-   std::vector< double > m_stakes;
-   unsigned int m_bets_this_round = 0;
+   /// bitmasks over the seats
+   uint16_t m_folded = 0;
+   uint16_t m_all_in = 0;
+   uint16_t m_to_act = 0;
+   /// the players whom the betting is open to. An all-in raise short of a full raise does not
+   /// reopen the betting to those who had already acted, they may only call or fold.
+   uint16_t m_may_raise = 0;
+   uint8_t m_n_hole_dealt = 0;
+   uint8_t m_n_board = 0;
+   uint8_t m_round = 0;
+   uint8_t m_bets_this_round = 0;
    bool m_is_terminal = false;
-   bool m_terminal_checked = false;
-   sptr< PokerConfig > m_config;
 
-   static const std::vector< History >& _all_terminal_histories();
-   [[nodiscard]] bool _all_cards_engaged() const;
-   [[nodiscard]] bool _has_higher_card(Player player) const;
-   void _flip_active_player();
+   static uint16_t _bit(Player player) { return uint16_t(1u << as_int(player)); }
+   [[nodiscard]] uint16_t _seated_mask() const { return uint16_t((1u << n_players()) - 1u); }
+   /// the players who are still in the hand and have chips left to bet
+   [[nodiscard]] uint16_t _can_act_mask() const
+   {
+      return uint16_t(_seated_mask() & ~m_folded & ~m_all_in);
+   }
+   [[nodiscard]] Player _next_in(uint16_t mask, Player after) const;
+   [[nodiscard]] Player _small_blind_player() const;
+   [[nodiscard]] Player _big_blind_player() const;
+   [[nodiscard]] float _fixed_raise_size() const;
+   [[nodiscard]] ActionType _raise_type() const;
+   [[nodiscard]] size_t _board_cards_until(size_t round) const;
+   [[nodiscard]] float _to_call(Player player) const
+   {
+      return std::min(m_highest_stake - m_stakes[as_int(player)], m_stacks[as_int(player)]);
+   }
+   [[nodiscard]] bool _can_raise(Player player) const;
+   void _commit(Player player, float amount);
+   void _start_betting_round();
+   void _end_betting_round();
 };
 
 }  // namespace texholdem
 
-#endif  // NOR_STATE_HPP
+#endif  // NOR_TEXAS_HOLDEM_POKER_STATE_HPP
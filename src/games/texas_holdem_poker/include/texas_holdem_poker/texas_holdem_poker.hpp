@@ -1,8 +1,13 @@
 
-
 #ifndef NOR_TEXAS_HOLDEM_POKER_HPP
 #define NOR_TEXAS_HOLDEM_POKER_HPP
 
+#include "texas_holdem_poker/abstraction.hpp"
+#include "texas_holdem_poker/action_abstraction.hpp"
+#include "texas_holdem_poker/card.hpp"
+#include "texas_holdem_poker/evaluator.hpp"
+#include "texas_holdem_poker/hand_indexer.hpp"
+#include "texas_holdem_poker/hand_rank.hpp"
 #include "texas_holdem_poker/state.hpp"
 #include "texas_holdem_poker/utils.hpp"
 
@@ -7,106 +7,138 @@
 #include "common/common.hpp"
 #include "state.hpp"
 
-namespace kuhn {
-
-constexpr common::CEBijection< Rank, std::string_view, 3 > card_name_bij = {
-   std::pair{Rank::jack, "jack"},
-   std::pair{Rank::queen, "queen"},
-   std::pair{Rank::king, "king"}};
-
-constexpr common::CEBijection< Action, std::string_view, 2 > action_name_bij = {
-   std::pair{Action::check, "check"},
-   std::pair{Action::bet, "bet"}};
-
-constexpr common::CEBijection< Player, std::string_view, 2 > player_name_bij = {
+namespace texholdem {
+
+constexpr common::CEBijection< Rank, std::string_view, 13 > rank_name_bij = {
+   std::pair{Rank::two, "2"},
+   std::pair{Rank::three, "3"},
+   std::pair{Rank::four, "4"},
+   std::pair{Rank::five, "5"},
+   std::pair{Rank::six, "6"},
+   std::pair{Rank::seven, "7"},
+   std::pair{Rank::eight, "8"},
+   std::pair{Rank::nine, "9"},
+   std::pair{Rank::ten, "T"},
+   std::pair{Rank::jack, "J"},
+   std::pair{Rank::queen, "Q"},
+   std::pair{Rank::king, "K"},
+   std::pair{Rank::ace, "A"}};
+
+constexpr common::CEBijection< Suit, std::string_view, 4 > suit_name_bij = {
+   std::pair{Suit::diamonds, "d"},
+   std::pair{Suit::clubs, "c"},
+   std::pair{Suit::hearts, "h"},
+   std::pair{Suit::spades, "s"}};
+
+constexpr common::CEBijection< ActionType, std::string_view, 5 > actiontype_name_bij = {
+   std::pair{ActionType::check, "check"},
+   std::pair{ActionType::call, "call"},
+   std::pair{ActionType::bet, "bet"},
+   std::pair{ActionType::raise, "raise"},
+   std::pair{ActionType::fold, "fold"}};
+
+constexpr common::CEBijection< Player, std::string_view, 11 > player_name_bij = {
+   std::pair{Player::chance, "chance"},
    std::pair{Player::one, "one"},
-   std::pair{Player::two, "two"}};
-
-}  // namespace kuhn
+   std::pair{Player::two, "two"},
+   std::pair{Player::three, "three"},
+   std::pair{Player::four, "four"},
+   std::pair{Player::five, "five"},
+   std::pair{Player::six, "six"},
+   std::pair{Player::seven, "seven"},
+   std::pair{Player::eight, "eight"},
+   std::pair{Player::nine, "nine"},
+   std::pair{Player::ten, "ten"}};
+
+constexpr common::CEBijection< HandCategory, std::string_view, 9 > hand_category_name_bij = {
+   std::pair{HandCategory::high_card, "high_card"},
+   std::pair{HandCategory::pair, "pair"},
+   std::pair{HandCategory::two_pair, "two_pair"},
+   std::pair{HandCategory::three_of_a_kind, "three_of_a_kind"},
+   std::pair{HandCategory::straight, "straight"},
+   std::pair{HandCategory::flush, "flush"},
+   std::pair{HandCategory::full_house, "full_house"},
+   std::pair{HandCategory::four_of_a_kind, "four_of_a_kind"},
+   std::pair{HandCategory::straight_flush, "straight_flush"}};
+
+}  // namespace texholdem
 
 namespace common {
 
 template <>
-inline std::string to_string(const kuhn::Rank &value)
+inline std::string to_string(const texholdem::Rank &value)
 {
-   return std::string(kuhn::card_name_bij.at(value));
+   return std::string(texholdem::rank_name_bij.at(value));
 }
 
 template <>
-inline std::string to_string(const kuhn::Action &value)
+inline std::string to_string(const texholdem::Suit &value)
 {
-   return std::string(kuhn::action_name_bij.at(value));
+   return std::string(texholdem::suit_name_bij.at(value));
 }
 
 template <>
-inline std::string to_string(const kuhn::Player &value)
+inline std::string to_string(const texholdem::ActionType &value)
 {
-   return std::string(kuhn::player_name_bij.at(value));
+   return std::string(texholdem::actiontype_name_bij.at(value));
 }
 
 template <>
-inline std::string to_string(const kuhn::ChanceOutcome &value)
+inline std::string to_string(const texholdem::Player &value)
 {
-   return std::string(kuhn::card_name_bij.at(value.card));
+   return std::string(texholdem::player_name_bij.at(value));
 }
 
-}  // namespace common
-
-// these operator<< definitions are specifically made for gtest which cannot handle the lookup in
-// global namespace without throwing multiple template matching errors.
-namespace kuhn {
-
-inline auto &operator<<(std::ostream &os, Player e)
-{
-   return os << common::to_string(e);
-}
-inline auto &operator<<(std::ostream &os, Rank e)
+template <>
+inline std::string to_string(const texholdem::HandCategory &value)
 {
-   return os << common::to_string(e);
+   return std::string(texholdem::hand_category_name_bij.at(value));
 }
-inline auto &operator<<(std::ostream &os, ChanceOutcome e)
+
+template <>
+inline std::string to_string(const texholdem::Card &value)
 {
-   return os << common::to_string(e.card);
+   return to_string(value.rank) + to_string(value.suit);
 }
-inline auto &operator<<(std::ostream &os, Action e)
+
+template <>
+inline std::string to_string(const texholdem::Action &value)
 {
-   return os << common::to_string(e);
+   using texholdem::ActionType;
+   bool is_bet = value.action_type == ActionType::bet or value.action_type == ActionType::raise;
+   return fmt::format(
+      "{}{}",
+      common::to_string(value.action_type),
+      is_bet ? fmt::format("-->{:.2f}", value.bet) : ""
+   );
 }
 
-}  // namespace kuhn
+}  // namespace common
 
-namespace std {
+COMMON_ENABLE_PRINT(texholdem, Rank);
+COMMON_ENABLE_PRINT(texholdem, Suit);
+COMMON_ENABLE_PRINT(texholdem, Action);
+COMMON_ENABLE_PRINT(texholdem, ActionType);
+COMMON_ENABLE_PRINT(texholdem, Player);
+COMMON_ENABLE_PRINT(texholdem, HandCategory);
+COMMON_ENABLE_PRINT(texholdem, Card);
 
-template <>
-struct hash< kuhn::History > {
-   size_t operator()(const kuhn::History &history) const
-   {
-      std::stringstream ss;
-      for(auto action : history.sequence) {
-         ss << std::to_string(static_cast< int >(action));
-      }
-      return std::hash< std::string >{}(ss.str());
-   }
-};
+namespace std {
 
 template <>
-struct hash< kuhn::ChanceOutcome > {
-   size_t operator()(const kuhn::ChanceOutcome &chance_outcome) const
+struct hash< texholdem::Action > {
+   size_t operator()(const texholdem::Action &action) const noexcept
    {
-      std::stringstream ss;
-      ss << chance_outcome.player << chance_outcome.card;
-      return std::hash< std::string >{}(ss.str());
+      size_t seed{0};
+      common::hash_combine(seed, std::hash< texholdem::ActionType >{}(action.action_type));
+      common::hash_combine(seed, std::hash< float >{}(action.bet));
+      return seed;
    }
 };
 
 template <>
 struct hash< texholdem::Card > {
-   size_t operator()(const texholdem::Card &card) const
-   {
-      size_t hash = std::hash< texholdem::Rank >{}(card.rank);
-      common::hash_combine(hash, std::hash< texholdem::Suit >{}(card.suit));
-      return hash;
-   }
+   size_t operator()(const texholdem::Card &card) const noexcept { return card.index(); }
 };
 
 }  // namespace std
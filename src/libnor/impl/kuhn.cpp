@@ -58,17 +58,19 @@ Environment::observation_type Environment::public_observation(
 Environment::observation_type Environment::tiny_repr(const world_state_type& wstate) const
 {
    std::stringstream ss;
-   for(auto [idx, card] : ranges::views::enumerate(wstate.cards())) {
+   auto cards = wstate.cards();
+   auto history = wstate.history();
+   for(auto [idx, card] : ranges::views::enumerate(cards)) {
       if(card.has_value()) {
          ss << card.value();
-         if((idx == 0 and wstate.cards()[1].has_value()) or not wstate.history().empty()) {
+         if((idx == 0 and cards[1].has_value()) or not history.empty()) {
             ss << "-";
          }
       }
    }
-   for(auto [idx, action] : ranges::views::enumerate(wstate.history())) {
+   for(auto [idx, action] : ranges::views::enumerate(history)) {
       ss << action;
-      if(idx != wstate.history().size() - 1) {
+      if(idx != history.size() - 1) {
          ss << "-";
       }
    }
@@ -80,8 +82,9 @@ Environment::private_history(Player player, const world_state_type& wstate) cons
 {
    std::vector< PlayerInformedType< std::optional< action_variant_type > > > out;
    auto action_history = wstate.history();
+   auto cards = wstate.cards();
    out.reserve(action_history.size() + 2);
-   for(auto&& [i, outcome_opt] : ranges::views::enumerate(wstate.cards())) {
+   for(auto&& [i, outcome_opt] : ranges::views::enumerate(cards)) {
       if(not outcome_opt.has_value()) {
          // the card has not been set yet, so we just return, as there is no further history
          break;
@@ -128,3 +131,12 @@ Environment::public_history(const world_state_type& wstate) const
    }
    return hist;
 }
+
+std::vector< nor::Player > GeneralEnvironment::players(const world_state_type& wstate)
+{
+   std::vector< nor::Player > players{nor::Player::chance};
+   for(size_t p = 0; p < wstate.config().n_players; p++) {
+      players.emplace_back(nor::Player(p));
+   }
+   return players;
+}
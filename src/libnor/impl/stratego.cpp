@@ -1,6 +1,8 @@
 
 #include "nor/env/stratego.hpp"
 
+#include <string_view>
+
 #include "common/common.hpp"
 #include "nor/utils/player_informed_type.hpp"
 #include "stratego/stratego.hpp"
@@ -54,9 +56,8 @@ std::vector< PlayerInformedType< Environment::action_variant_type > > Environmen
    std::vector< PlayerInformedType< action_variant_type > > out;
    const auto& history = wstate.history();
    out.reserve(history.size());
-   for(auto turn : history.turns()) {
-      auto [team, action, _] = history[turn];
-      out.emplace_back(action, to_player(team));
+   for(const auto& record : history) {
+      out.emplace_back(record.action, to_player(record.team));
    }
    return out;
 }
@@ -67,9 +68,8 @@ Environment::private_history(Player, const Environment::world_state_type& wstate
    std::vector< PlayerInformedType< std::optional< action_variant_type > > > out;
    const auto& history = wstate.history();
    out.reserve(history.size());
-   for(auto turn : history.turns()) {
-      auto [team, action, _] = history[turn];
-      out.emplace_back(action, to_player(team));
+   for(const auto& record : history) {
+      out.emplace_back(record.action, to_player(record.team));
    }
    return out;
 }
@@ -80,9 +80,8 @@ Environment::public_history(const world_state_type& wstate) const
    std::vector< PlayerInformedType< std::optional< action_variant_type > > > out;
    const auto& history = wstate.history();
    out.reserve(history.size());
-   for(auto turn : history.turns()) {
-      auto [team, action, _] = history[turn];
-      out.emplace_back(action, to_player(team));
+   for(const auto& record : history) {
+      out.emplace_back(record.action, to_player(record.team));
    }
    return out;
 }
@@ -149,51 +148,53 @@ Environment::public_history(const world_state_type& wstate) const
 //    return m_logic->valid_actions(State());
 // }
 
-std::string observation(const State& state, std::optional< Player > observing_player)
+uint8_t Observation::pack(const Piece& piece, std::optional< Team > observer)
 {
-   const std::string delimiter = "|";
-   std::stringstream ss;
-   // start the infostate with the active player at the state followed by the turn count
-   ss << "Active team:" << state.active_team() << "\n";
-   ss << "Turn count:" << state.turn_count() << "\n";
-   ss << "Board dims:" << (state.config().game_dims | ranges::views::all) << "\n";
-
-   for(auto team : std::set{Team::BLUE, Team::RED}) {
-      ss << "Graveyard " << common::to_string(team) << ":"
-         << (state.graveyard(team) | ranges::views::keys) << "|"
-         << (state.graveyard(team) | ranges::views::values) << "\n";
+   if(piece.token() == Token::hole) {
+      return hole;
    }
-   ss << "Action History:[";
-   for(const auto& [_, action, __] : state.history().elements_map() | ranges::views::values) {
-      ss << common::to_string(action) << ", ";
+   bool known = not piece.flag_hidden()
+                or (observer.has_value() and piece.team() == observer.value());
+   auto token_slot = known ? static_cast< uint8_t >(piece.token()) : unknown_token;
+   return static_cast< uint8_t >(
+      (1 + token_slot) | static_cast< uint8_t >(piece.team()) << 4
+      | static_cast< uint8_t >(not piece.flag_hidden()) << 5
+   );
+}
+
+size_t Observation::hash() const
+{
+   // the fixed-size fields fit into a single word
+   uint64_t header = uint64_t(kind) | uint64_t(from) << 8 | uint64_t(to) << 24
+                     | uint64_t(revealed[0]) << 40 | uint64_t(revealed[1]) << 48;
+   size_t hash_value = std::hash< uint64_t >{}(header);
+   if(not board.empty()) {
+      common::hash_combine(
+         hash_value,
+         std::string_view(reinterpret_cast< const char* >(board.data()), board.size())
+      );
    }
-   ss << "]\n";
+   return hash_value;
+}
+
+Observation observation(const State& state, std::optional< Player > observing_player)
+{
+   std::optional< Team > observer = std::nullopt;
+   if(observing_player.has_value()) {
+      observer = to_team(observing_player.value());
+   }
+   const auto& [n_rows, n_cols] = state.config().game_dims();
+   Observation obs{.kind = Observation::Kind::board};
+   obs.board.assign(n_rows * n_cols, Observation::empty);
    for(const auto& piece_opt : state.board()) {
-      if(not piece_opt.has_value()) {
-         continue;
-      }
-      // put information in string rows of the form:
-      // (0,1)|BLUE|!|scout\n
-      // (1,3)|BLUE|?|spy\n
-      // (3,3)|RED|!|spy\n
-      // (2,1)|RED|?|-\n
-      // with ! indicating an uncovered piece and ? indicating a hidden piece
-      const auto& piece = piece_opt.value();
-      const bool hidden = piece.flag_hidden();
-      const Team team = piece.team();
-      ss << piece.position() << delimiter << team << delimiter << (hidden ? "?" : "!") << delimiter;
-      if(hidden and (
-            not observing_player.has_value()  // this is the case for a public obs
-            or to_player(team) != observing_player.value() // this is the case for a private obs
-         )
-      ) {
-         ss << "-";
-      } else {
-         ss << piece.token();
+      if(piece_opt.has_value()) {
+         const auto& pos = piece_opt->position();
+         obs.board[size_t(pos[0]) * n_cols + size_t(pos[1])] = Observation::pack(
+            *piece_opt, observer
+         );
       }
-      ss << "\n";
    }
-   return ss.str();
+   return obs;
 }
 
 nor::games::stratego::Environment::observation_type
@@ -209,7 +210,7 @@ nor::games::stratego::Environment::private_observation(
       // observation of the board to the player
       return observation(wstate, observer);
    }
-   return "";
+   return {};
 }
 
 nor::games::stratego::Environment::observation_type
@@ -219,28 +220,30 @@ nor::games::stratego::Environment::public_observation(
    const world_state_type& next_wstate
 ) const
 {
-   std::stringstream ss;
-   ss << common::to_string(action);
-   auto last_iter = next_wstate.history().view_last();
-   if(last_iter == next_wstate.history().end()) {
-      return ss.str();
+   auto n_cols = next_wstate.config().game_dims()[1];
+   auto square = [&](const Position2D& pos) {
+      return static_cast< uint16_t >(size_t(pos[0]) * n_cols + size_t(pos[1]));
+   };
+   Observation obs{
+      .kind = Observation::Kind::move, .from = square(action[0]), .to = square(action[1])};
+   if(next_wstate.history().empty()) {
+      return obs;
    }
-   const auto& [team, _, pieces] = last_iter->second;
-   if(pieces.second.has_value()) {
-      // there was a fight between two pieces, so we include the revelation of the pieces here if
-      // they were hidden.
-      const auto& [att_piece, def_piece_opt] = pieces;
-      const auto& def_piece = def_piece_opt.value();
-      if(att_piece.flag_hidden()) {
-         ss << "attacker revelead:Team-" << common::to_string(att_piece.team()) << ";Token-"
-            << common::to_string(att_piece.token());
+   const auto& record = next_wstate.history().last();
+   if(record.defender.has_value()) {
+      // there was a fight between two pieces, which reveals them if they were hidden
+      auto reveal = [](Piece piece) {
+         piece.flag_hidden(false);
+         return Observation::pack(piece, std::nullopt);
+      };
+      if(record.attacker.flag_hidden()) {
+         obs.revealed[0] = reveal(record.attacker);
       }
-      if(def_piece.flag_hidden()) {
-         ss << "defender revelead:Team-" << common::to_string(def_piece.team()) << ";Token-"
-            << common::to_string(def_piece.token());
+      if(record.defender->flag_hidden()) {
+         obs.revealed[1] = reveal(*record.defender);
       }
    }
-   return ss.str();
+   return obs;
 }
 
 }  // namespace nor::games::stratego
@@ -0,0 +1,161 @@
+
+#include "nor/env/texholdem.hpp"
+
+#include <stdexcept>
+
+using namespace nor;
+using namespace nor::games::texholdem;
+
+namespace {
+
+/// whether the next chance outcome on this state deals a hole card (or else a board card)
+bool deals_hole_card(const State& wstate)
+{
+   return wstate.n_hole_cards_dealt() < wstate.n_players() * hole_cards_per_player;
+}
+
+/// the seat the next hole card on this state is dealt to
+texholdem::Player hole_card_receiver(const State& wstate)
+{
+   return texholdem::Player(wstate.n_hole_cards_dealt() / hole_cards_per_player);
+}
+
+/// whether the state holds all board cards of its latest round
+bool board_round_complete(const State& wstate)
+{
+   size_t n_board_cards = 0;
+   for(auto n_round_cards : wstate.config().boardcards_per_round) {
+      n_board_cards += n_round_cards;
+      if(n_board_cards == wstate.board().size()) {
+         return true;
+      }
+   }
+   return false;
+}
+
+}  // namespace
+
+std::vector< Player > Environment::players(const world_state_type& wstate)
+{
+   std::vector< Player > players;
+   players.reserve(wstate.n_players() + 1);
+   players.emplace_back(Player::chance);
+   for(size_t p = 0; p < wstate.n_players(); p++) {
+      players.emplace_back(Player(p));
+   }
+   return players;
+}
+
+Environment::observation_type Environment::
+   private_observation(Player, const world_state_type&, const action_type&, const world_state_type&)
+      const
+{
+   return "-";
+}
+
+Environment::observation_type Environment::public_observation(
+   const world_state_type& wstate,
+   const action_type& action,
+   const world_state_type&
+) const
+{
+   return common::to_string(to_nor_player(wstate.active_player())) + ":"
+          + common::to_string(action);
+}
+
+Environment::observation_type Environment::private_observation(
+   Player observer,
+   const world_state_type& wstate,
+   const chance_outcome_type& outcome,
+   const world_state_type& next_wstate
+) const
+{
+   if(m_indexer != nullptr) {
+      if(observer == Player::chance) {
+         return "-";
+      }
+      auto player = to_texholdem_player(observer);
+      bool hand_complete = board_round_complete(next_wstate);
+      if(deals_hole_card(wstate)) {
+         hand_complete = hole_card_receiver(wstate) == player
+                         and next_wstate.hole_cards(player).size() == hole_cards_per_player;
+      }
+      return hand_complete ? _hand_observation(observer, next_wstate) : "-";
+   }
+   if(deals_hole_card(wstate) and to_nor_player(hole_card_receiver(wstate)) == observer) {
+      return common::to_string(outcome);
+   }
+   return "-";
+}
+
+Environment::observation_type Environment::public_observation(
+   const world_state_type& wstate,
+   const chance_outcome_type& outcome,
+   const world_state_type& /*next_wstate*/
+) const
+{
+   if(deals_hole_card(wstate)) {
+      return common::to_string(to_nor_player(hole_card_receiver(wstate))) + ":?";
+   }
+   if(m_indexer != nullptr) {
+      return "board:?";
+   }
+   return "board:" + common::to_string(outcome);
+}
+
+HandIndexer::index_type Environment::hand_index(Player player, const world_state_type& wstate) const
+{
+   if(m_indexer == nullptr) {
+      throw std::logic_error("The environment has not been given a hand indexer.");
+   }
+   std::array< uint8_t, hole_cards_per_player + max_board_cards > card_ids{};
+   size_t n_cards = 0;
+   for(const auto& card : wstate.hole_cards(to_texholdem_player(player))) {
+      card_ids[n_cards++] = card.index();
+   }
+   for(const auto& card : wstate.board()) {
+      card_ids[n_cards++] = card.index();
+   }
+   return m_indexer->index(std::span{card_ids}.first(n_cards));
+}
+
+Bucket Environment::hand_bucket(Player player, const world_state_type& wstate) const
+{
+   auto index = hand_index(player, wstate);
+   auto round = m_indexer->round_of(
+      wstate.hole_cards(to_texholdem_player(player)).size() + wstate.board().size()
+   );
+   if(m_buckets == nullptr or round >= m_buckets->n_rounds()) {
+      throw std::logic_error(
+         "The environment has no card abstraction for round " + std::to_string(round)
+      );
+   }
+   return m_buckets->bucket(round, index);
+}
+
+Environment::observation_type Environment::_hand_observation(
+   Player player,
+   const world_state_type& wstate
+) const
+{
+   auto n_cards = wstate.hole_cards(to_texholdem_player(player)).size() + wstate.board().size();
+   if(m_buckets != nullptr and m_indexer->round_of(n_cards) < m_buckets->n_rounds()) {
+      return "bucket:" + std::to_string(hand_bucket(player, wstate));
+   }
+   return "hand:" + std::to_string(hand_index(player, wstate));
+}
+
+Environment::observation_type Environment::tiny_repr(const world_state_type& wstate) const
+{
+   std::string repr;
+   for(size_t p = 0; p < wstate.n_players(); p++) {
+      for(const auto& card : wstate.hole_cards(texholdem::Player(p))) {
+         repr += common::to_string(card);
+      }
+      repr += "|";
+   }
+   for(const auto& card : wstate.board()) {
+      repr += common::to_string(card);
+   }
+   return repr + "|pot:" + std::to_string(wstate.pot());
+}
@@ -452,6 +452,19 @@ concept stochastic_fosg =
    && stochastic_env< Env >;
 // clang-format on
 
+template <
+   typename Env,
+   typename Action = auto_action_type< Env >,
+   typename Observation = auto_observation_type< Env >,
+   typename Worldstate = auto_world_state_type< Env > >
+// clang-format off
+concept batched_fosg =
+/**/  fosg< Env >
+   && has::method::actions_batch< Env, Worldstate, Action >
+   && has::method::transition_batch< Env, Worldstate, Action >
+   && has::method::observations_batch< Env, Worldstate, Action, Observation >;
+// clang-format on
+
 template <
    typename Env,
    typename Policy,
@@ -3,6 +3,7 @@
 #define NOR_HAS_HPP
 
 #include <optional>
+#include <span>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -294,6 +295,54 @@ concept public_observation = requires(
    } -> std::convertible_to< Observation >;
 };
 
+template <
+   typename T,
+   typename Worldstate = typename T::world_state_type,
+   typename Action = typename T::action_type >
+concept actions_batch = requires(
+   T const t,
+   std::span< const Player > players,
+   std::span< const Worldstate > worldstates
+) {
+   // the legal actions of players[i] in worldstates[i] for every i
+   {
+      t.actions_batch(players, worldstates)
+   } -> std::convertible_to< std::vector< std::vector< Action > > >;
+};
+
+template <
+   typename T,
+   typename Worldstate = typename T::world_state_type,
+   typename Action = typename T::action_type >
+concept transition_batch = requires(
+   T t,
+   std::span< Worldstate > worldstates,
+   std::span< const Action > actions
+) {
+   // apply actions[i] on worldstates[i] inplace for every i
+   {
+      t.transition_batch(worldstates, actions)
+   } -> std::same_as< void >;
+};
+
+template <
+   typename T,
+   typename Worldstate = typename T::world_state_type,
+   typename Action = typename T::action_type,
+   typename Observation = typename T::observation_type >
+concept observations_batch = requires(
+   T t,
+   std::span< const Player > observers,
+   std::span< const Worldstate > worldstates,
+   std::span< const Action > actions,
+   std::span< const Worldstate > next_worldstates
+) {
+   // the public and the private observation of observers[i] of every transition i
+   {
+      t.observations_batch(observers, worldstates, actions, next_worldstates)
+   } -> std::convertible_to< std::vector< std::pair< Observation, Observation > > >;
+};
+
 template <
    typename T,
    typename Worldstate = typename T::world_state_type,
@@ -7,5 +7,6 @@
 // #include "nor/env/polymorphic.hpp"
 #include "nor/env/rps.hpp"
 #include "nor/env/stratego.hpp"
+#include "nor/env/texholdem.hpp"
 
 #endif  // NOR_ENV_HPP
@@ -2,6 +2,8 @@
 #ifndef NOR_ENV_KUHN_HPP
 #define NOR_ENV_KUHN_HPP
 
+#include <cstdint>
+#include <optional>
 #include <range/v3/all.hpp>
 #include <string>
 #include <vector>
@@ -130,6 +132,208 @@ class Environment {
    observation_type tiny_repr(const world_state_type& wstate) const;
 };
 
+/**
+ * @brief The integer observation of generalised Kuhn poker.
+ *
+ * Publicly, an action is observed as its value and the deal to a seat as `deal_offset` + seat.
+ * Privately, only the owner of a card observes it, as `deal_offset` + card, and everything else is
+ * observed as `nothing`.
+ */
+using GeneralObservation = uint32_t;
+
+class GeneralPublicstate: public DefaultPublicstate< GeneralPublicstate, GeneralObservation > {
+   using base = DefaultPublicstate< GeneralPublicstate, GeneralObservation >;
+   using base::base;
+
+  public:
+   /// the hash of the previous observations combined with the latest one
+   [[nodiscard]] size_t _hash_impl() const
+   {
+      auto hash_value = hash();
+      common::hash_combine(hash_value, latest());
+      return hash_value;
+   }
+};
+
+/**
+ * @brief The infostate of a player of generalised Kuhn poker.
+ *
+ * Next to the observation history it keeps the player's card and the betting sequence observed so
+ * far, which determine the history. It therefore hashes and compares in O(1) and its `index()` is
+ * the closed-form `general::State::infostate_index()` of the states at which the player acts.
+ */
+class GeneralInfostate: public nor::DefaultInfostate< GeneralInfostate, GeneralObservation > {
+   using base = DefaultInfostate< GeneralInfostate, GeneralObservation >;
+
+  public:
+   static constexpr GeneralObservation nothing = 0;
+   static constexpr GeneralObservation deal_offset = 2;
+
+   using base::base;
+
+   void update(const observation_type& public_obs, const observation_type& private_obs)
+   {
+      if(public_obs >= deal_offset) {
+         m_n_dealt++;
+         if(private_obs != nothing) {
+            m_card = general::Card(private_obs - deal_offset);
+         }
+      } else if(m_has_bet) {
+         m_calls |= uint16_t(public_obs << m_n_responses);
+         m_n_responses++;
+      } else if(public_obs == GeneralObservation(Action::bet)) {
+         m_has_bet = true;
+      } else {
+         m_n_checks++;
+      }
+      base::update(public_obs, private_obs);
+   }
+
+   /// the player's card, if dealt already
+   [[nodiscard]] std::optional< general::Card > card() const
+   {
+      return m_n_dealt > static_cast< size_t >(player()) ? std::optional{m_card} : std::nullopt;
+   }
+   /// the index of the betting sequence as in `general::State::history_index()`
+   [[nodiscard]] size_t history_index() const
+   {
+      return m_has_bet ? (size_t(1) << m_n_responses) + m_calls : 0;
+   }
+   /// the index among the player's infostates, defined once all cards are dealt
+   [[nodiscard]] size_t index() const
+   {
+      return size_t(m_card) * (size_t(1) << (m_n_dealt - 1)) + history_index();
+   }
+
+   [[nodiscard]] size_t _hash_impl() const
+   {
+      auto hash_value = std::hash< int >{}(static_cast< int >(player()));
+      common::hash_combine(hash_value, _key());
+      return hash_value;
+   }
+
+   bool operator==(const GeneralInfostate& other) const
+   {
+      return player() == other.player() and _key() == other._key();
+   }
+   bool operator!=(const GeneralInfostate& other) const { return not (*this == other); }
+
+  private:
+   general::Card m_card = 0;
+   /// the bits of the responses to the bet (in order of play), set for a call
+   uint16_t m_calls = 0;
+   uint8_t m_n_dealt = 0;
+   uint8_t m_n_checks = 0;
+   uint8_t m_n_responses = 0;
+   bool m_has_bet = false;
+
+   /// the packed card and betting sequence, which tell the player's observation history apart
+   [[nodiscard]] uint64_t _key() const
+   {
+      return uint64_t(m_card) | uint64_t(m_calls) << 16 | uint64_t(m_n_dealt) << 32
+             | uint64_t(m_n_checks) << 40 | uint64_t(m_n_responses) << 48
+             | uint64_t(m_has_bet) << 56;
+   }
+};
+
+/**
+ * @brief The FOSG adapter of generalised Kuhn poker with any number of players and cards.
+ *
+ * Cards are observed privately by their owner only, every action is public. The observations are
+ * integers, so that stepping through the game builds no strings.
+ */
+class GeneralEnvironment {
+  public:
+   // nor fosg typedefs
+   using world_state_type = general::State;
+   using info_state_type = GeneralInfostate;
+   using public_state_type = GeneralPublicstate;
+   using action_type = Action;
+   using chance_outcome_type = general::ChanceOutcome;
+   using observation_type = GeneralObservation;
+   using action_variant_type = action_variant_type_generator_t< action_type, chance_outcome_type >;
+   // nor fosg traits
+   static constexpr size_t max_player_count() { return general::max_players; }
+   static constexpr size_t player_count() { return std::dynamic_extent; }
+   static constexpr bool serialized() { return true; }
+   static constexpr bool unrolled() { return true; }
+   static constexpr Stochasticity stochasticity() { return Stochasticity::choice; }
+
+   GeneralEnvironment() = default;
+
+   std::vector< action_type > actions(Player, const world_state_type& wstate) const
+   {
+      return wstate.actions();
+   }
+   inline std::vector< chance_outcome_type > chance_actions(const world_state_type& wstate) const
+   {
+      return wstate.chance_actions();
+   }
+   inline double
+   chance_probability(const world_state_type& wstate, const chance_outcome_type& outcome) const
+   {
+      return wstate.chance_probability(outcome);
+   }
+
+   static std::vector< Player > players(const world_state_type& wstate);
+   [[nodiscard]] Player active_player(const world_state_type& wstate) const
+   {
+      return to_nor_player(wstate.active_player());
+   }
+   static bool is_terminal(const world_state_type& wstate) { return wstate.is_terminal(); }
+   static constexpr bool is_partaking(const world_state_type&, Player) { return true; }
+   static double reward(Player player, const world_state_type& wstate)
+   {
+      return wstate.payoff(to_kuhn_player(player));
+   }
+
+   template < typename ActionT >
+      requires common::is_any_v< ActionT, action_type, chance_outcome_type >
+   void transition(world_state_type& worldstate, const ActionT& action) const
+   {
+      worldstate.apply_action(action);
+   }
+
+   observation_type private_observation(
+      Player,
+      const world_state_type&,
+      const action_type&,
+      const world_state_type&
+   ) const
+   {
+      return info_state_type::nothing;
+   }
+
+   observation_type private_observation(
+      Player observer,
+      const world_state_type&,
+      const chance_outcome_type& outcome,
+      const world_state_type&
+   ) const
+   {
+      if(outcome.player != to_kuhn_player(observer)) {
+         return info_state_type::nothing;
+      }
+      return info_state_type::deal_offset + outcome.card;
+   }
+
+   observation_type
+   public_observation(const world_state_type&, const action_type& action, const world_state_type&)
+      const
+   {
+      return observation_type(action);
+   }
+
+   observation_type public_observation(
+      const world_state_type&,
+      const chance_outcome_type& outcome,
+      const world_state_type&
+   ) const
+   {
+      return info_state_type::deal_offset + static_cast< observation_type >(outcome.player);
+   }
+};
+
 }  // namespace nor::games::kuhn
 
 namespace nor {
@@ -149,12 +353,31 @@ struct fosg_traits< games::kuhn::Environment > {
    using observation_type = nor::games::kuhn::Observation;
 };
 
+template <>
+struct fosg_traits< games::kuhn::GeneralInfostate > {
+   using observation_type = nor::games::kuhn::GeneralObservation;
+};
+
+template <>
+struct fosg_traits< games::kuhn::GeneralEnvironment > {
+   using world_state_type = nor::games::kuhn::general::State;
+   using info_state_type = nor::games::kuhn::GeneralInfostate;
+   using public_state_type = nor::games::kuhn::GeneralPublicstate;
+   using action_type = nor::games::kuhn::Action;
+   using chance_outcome_type = nor::games::kuhn::general::ChanceOutcome;
+   using observation_type = nor::games::kuhn::GeneralObservation;
+};
+
 }  // namespace nor
 
 namespace std {
 template < typename StateType >
-   requires common::
-      is_any_v< StateType, nor::games::kuhn::Publicstate, nor::games::kuhn::Infostate >
+   requires common::is_any_v<
+      StateType,
+      nor::games::kuhn::Publicstate,
+      nor::games::kuhn::Infostate,
+      nor::games::kuhn::GeneralPublicstate,
+      nor::games::kuhn::GeneralInfostate >
    struct hash< StateType > {
    size_t operator()(const StateType& state) const noexcept { return state.hash(); }
 };
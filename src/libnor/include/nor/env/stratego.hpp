@@ -2,8 +2,11 @@
 #ifndef NOR_ENV_STRATEGO_HPP
 #define NOR_ENV_STRATEGO_HPP
 
+#include <array>
+#include <cstdint>
 #include <range/v3/all.hpp>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "nor/fosg_states.hpp"
@@ -24,18 +27,92 @@ inline auto to_player(const Team& team)
    return Player(static_cast< size_t >(team));
 }
 
-using Observation = std::string;
+/**
+ * @brief The binary observation of the Stratego env.
+ *
+ * It is either empty, a move (its from and to squares and the pieces that a fight revealed) or the
+ * initial board as seen by its observer, packed into one byte per square. Move observations are
+ * trivially sized, so that observing a move allocates nothing, and all of them hash and compare as
+ * flat bytes.
+ */
+struct Observation {
+   enum class Kind : uint8_t { none = 0, move = 1, board = 2 };
+
+   Kind kind = Kind::none;
+   /// the squares (row * n_cols + column) of a move
+   uint16_t from = 0;
+   uint16_t to = 0;
+   /// the packed attacker and defender of a fight if the fight revealed them, 0 otherwise
+   std::array< uint8_t, 2 > revealed{};
+   /// the packed pieces of the board of a board observation, row by row
+   std::vector< uint8_t > board{};
+
+   /// the code of an empty square
+   static constexpr uint8_t empty = 0;
+   /// the code of a hole
+   static constexpr uint8_t hole = 0xff;
+   /// the token slot of a piece whose token the observer does not know
+   static constexpr uint8_t unknown_token = n_tokens;
+
+   /**
+    * @brief Packs a piece into a byte as (1 + token slot) | team << 4 | revealed << 5.
+    *
+    * The token of a hidden piece of another team than the observer's is packed as unknown (and so
+    * is every hidden token for observers without a team, i.e. for public observations).
+    */
+   static uint8_t pack(const Piece& piece, std::optional< Team > observer);
+
+   [[nodiscard]] size_t hash() const;
+
+   bool operator==(const Observation& other) const = default;
+};
 
-std::string
+/// the board of the state as seen by the observing player (or as public information if none)
+Observation
 observation(const State& state, std::optional< Player > observing_player = std::nullopt);
 
+}  // namespace nor::games::stratego
+
+namespace std {
+
+template <>
+struct hash< nor::games::stratego::Observation > {
+   size_t operator()(const nor::games::stratego::Observation& obs) const noexcept
+   {
+      return obs.hash();
+   }
+};
+
+}  // namespace std
+
+namespace nor::games::stratego {
+
 class Publicstate: public DefaultPublicstate< Publicstate, Observation > {
    using base = DefaultPublicstate< Publicstate, Observation >;
    using base::base;
+
+  public:
+   /// the hash of the previous observations combined with the latest one's
+   [[nodiscard]] size_t _hash_impl() const
+   {
+      auto hash_value = hash();
+      common::hash_combine(hash_value, latest().hash());
+      return hash_value;
+   }
 };
 class Infostate: public nor::DefaultInfostate< Infostate, Observation > {
    using base = DefaultInfostate< Infostate, Observation >;
    using base::base;
+
+  public:
+   /// the hash of the previous observations combined with the latest ones'
+   [[nodiscard]] size_t _hash_impl() const
+   {
+      auto hash_value = hash();
+      const auto& [public_obs, private_obs] = latest();
+      common::hash_combine(hash_value, public_obs.hash(), private_obs.hash());
+      return hash_value;
+   }
 };
 
 class Environment {
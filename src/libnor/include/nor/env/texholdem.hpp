@@ -0,0 +1,229 @@
+
+#ifndef NOR_ENV_TEXHOLDEM_HPP
+#define NOR_ENV_TEXHOLDEM_HPP
+
+#include <string>
+#include <vector>
+
+#include "common/common.hpp"
+#include "nor/fosg_states.hpp"
+#include "nor/fosg_traits.hpp"
+#include "nor/game_defs.hpp"
+#include "texas_holdem_poker/texas_holdem_poker.hpp"
+
+namespace nor::games::texholdem {
+
+using namespace ::texholdem;
+
+inline auto to_texholdem_player(const nor::Player& player)
+{
+   return static_cast< texholdem::Player >(player);
+}
+inline auto to_nor_player(const texholdem::Player& player)
+{
+   return static_cast< nor::Player >(player);
+}
+
+using Observation = std::string;
+
+class Publicstate: public DefaultPublicstate< Publicstate, Observation > {
+   using base = DefaultPublicstate< Publicstate, Observation >;
+   using base::base;
+};
+class Infostate: public nor::DefaultInfostate< Infostate, Observation > {
+   using base = DefaultInfostate< Infostate, Observation >;
+   using base::base;
+};
+
+/**
+ * @brief The FOSG adapter of the Hold'em world state.
+ *
+ * Every bet and board card is public, hole cards are observed privately by their owner only.
+ *
+ * If constructed with a hand indexer, the cards are not observed individually. Instead, each player
+ * privately observes the suit-isomorphic index of their hole cards and the board once the cards of
+ * a round are complete, while the public observations only tell that cards were dealt. Infostates
+ * (and thus tabular policies keyed on them) of isomorphic hands then coincide. With a bucket map of
+ * an offline card abstraction on top, the player observes the bucket of that index instead.
+ */
+class Environment {
+  public:
+   // nor fosg typedefs
+   using world_state_type = State;
+   using info_state_type = Infostate;
+   using public_state_type = Publicstate;
+   using action_type = Action;
+   using chance_outcome_type = Card;
+   using observation_type = Observation;
+   using action_variant_type = action_variant_type_generator_t< action_type, chance_outcome_type >;
+   // nor fosg traits
+   static constexpr size_t max_player_count() { return max_players; }
+   static constexpr size_t player_count() { return std::dynamic_extent; }
+   static constexpr bool serialized() { return true; }
+   static constexpr bool unrolled() { return true; }
+   static constexpr Stochasticity stochasticity() { return Stochasticity::choice; }
+
+   Environment() = default;
+   /// Observe cards by their isomorphism index, or by their bucket in the card abstraction for the
+   /// rounds that the bucket map covers. The rounds of the indexer have to be the hole cards
+   /// followed by the board cards of each round of the played config.
+   explicit Environment(
+      sptr< const HandIndexer > indexer,
+      sptr< const BucketMap > buckets = nullptr
+   )
+       : m_indexer(std::move(indexer)), m_buckets(std::move(buckets))
+   {
+   }
+
+   std::vector< action_type > actions(Player, const world_state_type& wstate) const
+   {
+      return wstate.actions();
+   }
+   inline std::vector< chance_outcome_type > chance_actions(const world_state_type& wstate) const
+   {
+      return wstate.chance_actions();
+   }
+   inline double
+   chance_probability(const world_state_type& wstate, const chance_outcome_type& outcome) const
+   {
+      return wstate.chance_probability(outcome);
+   }
+
+   static std::vector< Player > players(const world_state_type& wstate);
+   [[nodiscard]] Player active_player(const world_state_type& wstate) const
+   {
+      return to_nor_player(wstate.active_player());
+   }
+   static bool is_terminal(const world_state_type& wstate) { return wstate.is_terminal(); }
+   static bool is_partaking(const world_state_type& wstate, Player player)
+   {
+      return player == Player::chance or not wstate.has_folded(to_texholdem_player(player));
+   }
+   static double reward(Player player, const world_state_type& wstate)
+   {
+      return wstate.payoff(to_texholdem_player(player));
+   }
+
+   template < typename ActionT >
+      requires common::is_any_v< ActionT, action_type, chance_outcome_type >
+   void transition(world_state_type& worldstate, const ActionT& action) const
+   {
+      worldstate.apply_action(action);
+   }
+
+   observation_type private_observation(
+      Player observer,
+      const world_state_type& wstate,
+      const action_type& action,
+      const world_state_type& next_wstate
+   ) const;
+
+   observation_type private_observation(
+      Player observer,
+      const world_state_type& wstate,
+      const chance_outcome_type& outcome,
+      const world_state_type& next_wstate
+   ) const;
+
+   observation_type public_observation(
+      const world_state_type& wstate,
+      const action_type& action,
+      const world_state_type& next_wstate
+   ) const;
+
+   observation_type public_observation(
+      const world_state_type& wstate,
+      const chance_outcome_type& outcome,
+      const world_state_type& next_wstate
+   ) const;
+
+   /// the isomorphism index of the player's hole cards and the board (requires an indexer and the
+   /// cards of the current round to be complete)
+   [[nodiscard]] HandIndexer::index_type hand_index(Player player, const world_state_type& wstate)
+      const;
+   /// the bucket of the player's hand index in the card abstraction (requires a bucket map that
+   /// covers the current round)
+   [[nodiscard]] Bucket hand_bucket(Player player, const world_state_type& wstate) const;
+
+   /// debug purposes
+   observation_type tiny_repr(const world_state_type& wstate) const;
+
+  private:
+   sptr< const HandIndexer > m_indexer = nullptr;
+   sptr< const BucketMap > m_buckets = nullptr;
+
+   [[nodiscard]] observation_type _hand_observation(Player player, const world_state_type& wstate)
+      const;
+};
+
+/**
+ * @brief The Hold'em environment restricted to a bet-size abstraction.
+ *
+ * Players may only choose the abstract actions of the state. Real actions of opponents outside of
+ * the abstraction have to be translated (`translate`) before they are applied to the abstract game.
+ */
+class AbstractedEnvironment: public Environment {
+  public:
+   explicit AbstractedEnvironment(
+      ActionAbstraction abstraction = ActionAbstraction{},
+      sptr< const HandIndexer > indexer = nullptr,
+      sptr< const BucketMap > buckets = nullptr
+   )
+       : Environment(std::move(indexer), std::move(buckets)), m_abstraction(std::move(abstraction))
+   {
+   }
+
+   std::vector< action_type > actions(Player, const world_state_type& wstate) const
+   {
+      return m_abstraction.actions(wstate);
+   }
+
+   /// samples the abstract action that a real action of the active player translates to
+   template < typename RNG >
+   action_type translate(const world_state_type& wstate, const action_type& action, RNG& rng) const
+   {
+      return m_abstraction.translate(wstate, action, rng);
+   }
+
+   [[nodiscard]] const auto& abstraction() const { return m_abstraction; }
+
+  private:
+   ActionAbstraction m_abstraction;
+};
+
+}  // namespace nor::games::texholdem
+
+namespace nor {
+
+template <>
+struct fosg_traits< games::texholdem::Infostate > {
+   using observation_type = nor::games::texholdem::Observation;
+};
+
+template <>
+struct fosg_traits< games::texholdem::Environment > {
+   using world_state_type = nor::games::texholdem::State;
+   using info_state_type = nor::games::texholdem::Infostate;
+   using public_state_type = nor::games::texholdem::Publicstate;
+   using action_type = nor::games::texholdem::Action;
+   using chance_outcome_type = nor::games::texholdem::Card;
+   using observation_type = nor::games::texholdem::Observation;
+};
+
+template <>
+struct fosg_traits< games::texholdem::AbstractedEnvironment >
+    : fosg_traits< games::texholdem::Environment > {};
+
+}  // namespace nor
+
+namespace std {
+template < typename StateType >
+   requires common::
+      is_any_v< StateType, nor::games::texholdem::Publicstate, nor::games::texholdem::Infostate >
+   struct hash< StateType > {
+   size_t operator()(const StateType& state) const noexcept { return state.hash(); }
+};
+
+}  // namespace std
+
+#endif  // NOR_ENV_TEXHOLDEM_HPP
@@ -23,7 +23,8 @@ double nash_conv(
    Env&& env,
    const auto_world_state_type< std::remove_cvref_t< Env > >& root_state,
    const player_hashmap< Policy >& player_policies,
-   bool constant_sum = false
+   bool constant_sum = false,
+   bool parallelize_chance = false
 )
 {
    using env_type = std::remove_cvref_t< Env >;
@@ -52,7 +53,8 @@ double nash_conv(
                                           }
                                        }
                                        return policy_map;
-                                    }))
+                                    }),
+                                    parallelize_chance)
                       .get()
                       .at(best_responder);
    }
@@ -60,7 +62,9 @@ double nash_conv(
       // if we are not in a constant sum case (or we simply want to include the constant value in
       // our output value for better referencing), then we have to compute the policy profile's
       // value for each player and subtract that from the current nash conv sum
-      auto policy_value_map = rm::policy_value(env, root_state, player_policies);
+      auto policy_value_map = rm::policy_value(
+         env, root_state, player_policies, parallelize_chance
+      );
       value_out += ranges::accumulate(
          policy_value_map.get() | ranges::views::values, double(0.), std::minus{}
       );
@@ -73,13 +77,16 @@ double exploitability(
    Env&& env,
    const auto_world_state_type< std::remove_cvref_t< Env > >& root_state,
    const player_hashmap< Policy >& player_policies,
-   bool constant_sum = false
+   bool constant_sum = false,
+   bool parallelize_chance = false
 )
 {
    auto players = env.players(root_state);
    // the chance player is not an active participant, thus exploitability does not include for it
    std::erase(players, Player::chance);
-   return nash_conv(std::forward< Env >(env), root_state, player_policies, constant_sum)
+   return nash_conv(
+             std::forward< Env >(env), root_state, player_policies, constant_sum, parallelize_chance
+          )
           / double(players.size());
 }
 
@@ -0,0 +1,239 @@
+#ifndef NOR_FOSG_BATCH_HPP
+#define NOR_FOSG_BATCH_HPP
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "common/common.hpp"
+#include "nor/concepts.hpp"
+#include "nor/fosg_traits.hpp"
+#include "nor/game_defs.hpp"
+
+namespace nor {
+
+/**
+ * The batched extension of the fosg interface.
+ *
+ * Each function below steps a whole batch of world states (the i-th entries of all spans belong
+ * together). Envs that implement the matching method (`actions_batch`, `transition_batch`,
+ * `observations_batch`, see concepts::has::method) receive the batch in a single call, which lets
+ * them amortise their dispatch overhead (e.g. crossing into Python) or process the states
+ * data-parallel. For all other envs the functions fall back to the scalar calls per state.
+ */
+
+namespace detail {
+
+inline void check_batch_sizes(std::initializer_list< size_t > sizes)
+{
+   if(std::ranges::adjacent_find(sizes, std::not_equal_to{}) != sizes.end()) {
+      throw std::invalid_argument("The spans of a batch differ in their sizes.");
+   }
+}
+
+/// calls the scalar function with the action, visiting it first if it is an action variant
+template < typename Action, typename Function >
+decltype(auto) visit_action(const Action& action_or_outcome, Function&& function)
+{
+   if constexpr(common::is_specialization_v< Action, std::variant >) {
+      return std::visit(std::forward< Function >(function), action_or_outcome);
+   } else {
+      return std::forward< Function >(function)(action_or_outcome);
+   }
+}
+
+}  // namespace detail
+
+template <
+   typename Env,
+   typename Worldstate = auto_world_state_type< std::remove_cvref_t< Env > >,
+   typename Action = auto_action_type< std::remove_cvref_t< Env > > >
+   requires concepts::fosg< std::remove_cvref_t< Env > >
+std::vector< std::vector< Action > > actions_batch(
+   Env&& env,
+   std::span< const Player > players,
+   std::span< const Worldstate > worldstates
+)
+{
+   detail::check_batch_sizes({players.size(), worldstates.size()});
+   if constexpr(concepts::has::method::actions_batch< std::remove_cvref_t< Env >, Worldstate >) {
+      return env.actions_batch(players, worldstates);
+   } else {
+      std::vector< std::vector< Action > > actions;
+      actions.reserve(worldstates.size());
+      for(size_t i = 0; i < worldstates.size(); i++) {
+         actions.emplace_back(env.actions(players[i], worldstates[i]));
+      }
+      return actions;
+   }
+}
+
+template <
+   typename Env,
+   std::ranges::contiguous_range ActionRange,
+   typename Worldstate = auto_world_state_type< std::remove_cvref_t< Env > > >
+   requires concepts::fosg< std::remove_cvref_t< Env > >
+void transition_batch(Env&& env, std::span< Worldstate > worldstates, const ActionRange& actions)
+{
+   using action_type = std::ranges::range_value_t< ActionRange >;
+   detail::check_batch_sizes({worldstates.size(), std::ranges::size(actions)});
+   if constexpr(concepts::has::method::
+                   transition_batch< std::remove_cvref_t< Env >, Worldstate, action_type >) {
+      env.transition_batch(worldstates, std::span< const action_type >(actions));
+   } else {
+      for(size_t i = 0; i < worldstates.size(); i++) {
+         detail::visit_action(actions[i], [&](const auto& action_or_outcome) {
+            env.transition(worldstates[i], action_or_outcome);
+         });
+      }
+   }
+}
+
+/// the public observation of every transition paired with the private one of its observer
+template <
+   typename Env,
+   std::ranges::contiguous_range ActionRange,
+   typename Worldstate = auto_world_state_type< std::remove_cvref_t< Env > >,
+   typename Observation = auto_observation_type< std::remove_cvref_t< Env > > >
+   requires concepts::fosg< std::remove_cvref_t< Env > >
+std::vector< std::pair< Observation, Observation > > observations_batch(
+   Env&& env,
+   std::span< const Player > observers,
+   std::span< const Worldstate > worldstates,
+   const ActionRange& actions,
+   std::span< const Worldstate > next_worldstates
+)
+{
+   using action_type = std::ranges::range_value_t< ActionRange >;
+   detail::check_batch_sizes(
+      {observers.size(), worldstates.size(), std::ranges::size(actions), next_worldstates.size()}
+   );
+   if constexpr(concepts::has::method::observations_batch<
+                   std::remove_cvref_t< Env >,
+                   Worldstate,
+                   action_type,
+                   Observation >) {
+      return env.observations_batch(
+         observers, worldstates, std::span< const action_type >(actions), next_worldstates
+      );
+   } else {
+      std::vector< std::pair< Observation, Observation > > observations;
+      observations.reserve(worldstates.size());
+      for(size_t i = 0; i < worldstates.size(); i++) {
+         detail::visit_action(actions[i], [&](const auto& action_or_outcome) {
+            observations.emplace_back(
+               env.public_observation(worldstates[i], action_or_outcome, next_worldstates[i]),
+               env.private_observation(
+                  observers[i], worldstates[i], action_or_outcome, next_worldstates[i]
+               )
+            );
+         });
+      }
+      return observations;
+   }
+}
+
+/**
+ * @brief Plays all world states to their end, stepping the players' moves as batches.
+ *
+ * The states that are still running are gathered into one contiguous batch, whose actions are
+ * fetched and applied with a single batched call each per step. The selector chooses the action of
+ * every state from its legal ones. Chance outcomes (of stochastic envs) are sampled one by one by
+ * their probabilities before the players' moves of a step.
+ *
+ * @return the trajectory of actions and chance outcomes of every state
+ */
+template <
+   typename Env,
+   typename Selector,
+   typename Worldstate = auto_world_state_type< std::remove_cvref_t< Env > >,
+   typename Action = auto_action_type< std::remove_cvref_t< Env > > >
+   requires concepts::fosg< std::remove_cvref_t< Env > >
+            and std::is_invocable_r_v<
+               Action,
+               Selector,
+               const Worldstate&,
+               Player,
+               const std::vector< Action >& >
+auto sample_trajectories_batch(
+   Env&& env,
+   std::span< Worldstate > worldstates,
+   Selector&& select,
+   common::RNG& rng
+)
+{
+   using env_type = std::remove_cvref_t< Env >;
+   using action_variant_type = auto_action_variant_type< env_type >;
+   std::vector< std::vector< action_variant_type > > trajectories(worldstates.size());
+
+   // the running states and the index they came from
+   std::vector< Worldstate > batch;
+   std::vector< size_t > origins;
+   for(size_t i = 0; i < worldstates.size(); i++) {
+      if(not env.is_terminal(worldstates[i])) {
+         batch.emplace_back(std::move(worldstates[i]));
+         origins.emplace_back(i);
+      }
+   }
+   // hands the finished states back to their origin
+   auto retire_terminal_states = [&] {
+      for(size_t k = batch.size(); k-- > 0;) {
+         if(env.is_terminal(batch[k])) {
+            worldstates[origins[k]] = std::move(batch[k]);
+            if(k + 1 != batch.size()) {
+               batch[k] = std::move(batch.back());
+               origins[k] = origins.back();
+            }
+            batch.pop_back();
+            origins.pop_back();
+         }
+      }
+   };
+
+   std::vector< Player > players;
+   std::vector< Action > chosen;
+   while(not batch.empty()) {
+      if constexpr(concepts::stochastic_env< env_type >) {
+         for(size_t k = 0; k < batch.size(); k++) {
+            auto& state = batch[k];
+            while(not env.is_terminal(state) and env.active_player(state) == Player::chance) {
+               auto outcomes = env.chance_actions(state);
+               auto outcome = common::choose(
+                  outcomes,
+                  [&](const auto& candidate) { return env.chance_probability(state, candidate); },
+                  rng
+               );
+               env.transition(state, outcome);
+               trajectories[origins[k]].emplace_back(std::move(outcome));
+            }
+         }
+         retire_terminal_states();
+         if(batch.empty()) {
+            break;
+         }
+      }
+      players.clear();
+      for(const auto& state : batch) {
+         players.emplace_back(env.active_player(state));
+      }
+      const std::span< const Worldstate > batch_view{batch};
+      auto legal_actions = actions_batch(env, std::span< const Player >{players}, batch_view);
+      chosen.clear();
+      for(size_t k = 0; k < batch.size(); k++) {
+         chosen.emplace_back(select(batch_view[k], players[k], legal_actions[k]));
+         trajectories[origins[k]].emplace_back(chosen[k]);
+      }
+      transition_batch(env, std::span< Worldstate >{batch}, chosen);
+      retire_terminal_states();
+   }
+   return trajectories;
+}
+
+}  // namespace nor
+
+#endif  // NOR_FOSG_BATCH_HPP
@@ -4,6 +4,7 @@
 #include "nor/at_runtime.hpp"
 #include "nor/concepts.hpp"
 #include "nor/exploitability.hpp"
+#include "nor/fosg_batch.hpp"
 #include "nor/fosg_helpers.hpp"
 #include "nor/fosg_states.hpp"
 #include "nor/fosg_traits.hpp"
@@ -227,6 +227,8 @@ class VanillaCFR:
    /// import public getters
 
    using base::env;
+   using base::stats;
+   using base::reset_stats;
    using base::policy;
    using base::iteration;
    using base::root_state;
@@ -320,6 +322,7 @@ class VanillaCFR:
    using base::_player_update_schedule;
    using base::_cycle_player_to_update;
    using base::_partial_pruning_condition;
+   using base::_stats;
 
    /// the relevant data stored at each infostate
    std::unordered_map<
@@ -59,36 +59,41 @@ auto VanillaCFR< config, Env, Policy, AveragePolicy >::_iterate(
 )
 {
    auto root_players = _env().players(root_state());
-   auto root_game_value = _traverse< initializing_run, use_current_policy >(
-      player_to_update,
-      utils::static_unique_ptr_downcast< world_state_type >(utils::clone_any_way(_root_state_uptr())
-      ),
-      std::invoke([&] {
-         ReachProbabilityMap rp_map{{}};
-         for(auto player : root_players) {
-            rp_map.get().emplace(player, 1.);
-         }
-         return rp_map;
-      }),
-      std::invoke([&] {
-         ObservationbufferMap obs_map{{}};
-         for(auto player : root_players | utils::is_actual_player_filter) {
-            obs_map.get().emplace(
-               player, std::vector< std::pair< observation_type, observation_type > >{}
-            );
-         }
-         return ObservationbufferMap{std::move(obs_map)};
-      }),
-      std::invoke([&] {
-         InfostateSptrMap infostates{{}};
-         for(auto player : root_players | utils::is_actual_player_filter) {
-            infostates.get().emplace(player, std::make_shared< info_state_type >(player));
-         }
-         return infostates;
-      })
-   );
+   auto root_game_value = std::invoke([&] {
+      [[maybe_unused]] auto timer = _stats().time(SolverPhase::traversal, _iteration());
+      return _traverse< initializing_run, use_current_policy >(
+         player_to_update,
+         utils::static_unique_ptr_downcast< world_state_type >(
+            utils::clone_any_way(_root_state_uptr())
+         ),
+         std::invoke([&] {
+            ReachProbabilityMap rp_map{{}};
+            for(auto player : root_players) {
+               rp_map.get().emplace(player, 1.);
+            }
+            return rp_map;
+         }),
+         std::invoke([&] {
+            ObservationbufferMap obs_map{{}};
+            for(auto player : root_players | utils::is_actual_player_filter) {
+               obs_map.get().emplace(
+                  player, std::vector< std::pair< observation_type, observation_type > >{}
+               );
+            }
+            return ObservationbufferMap{std::move(obs_map)};
+         }),
+         std::invoke([&] {
+            InfostateSptrMap infostates{{}};
+            for(auto player : root_players | utils::is_actual_player_filter) {
+               infostates.get().emplace(player, std::make_shared< info_state_type >(player));
+            }
+            return infostates;
+         })
+      );
+   });
 
    if constexpr(use_current_policy) {
+      [[maybe_unused]] auto timer = _stats().time(SolverPhase::regret_update, _iteration());
       _initiate_regret_minimization(player_to_update);
    }
    return root_game_value;
@@ -342,12 +347,15 @@ StateValueMap VanillaCFR< config, Env, Policy, AveragePolicy >::_traverse(
    InfostateSptrMap infostates
 )
 {
+   _stats().node_visited();
    if(_env().is_terminal(*state)) {
+      _stats().terminal_evaluated();
       return StateValueMap{collect_rewards(_env(), *state)};
    }
 
    if constexpr(config.pruning_mode == CFRPruningMode::partial) {
       if(_partial_pruning_condition(player_to_update, reach_probability)) {
+         _stats().subtree_pruned();
          // if the entire subtree is pruned then the values that could be found are all 0. for
          // each player
          return StateValueMap{std::invoke([&] {
@@ -433,9 +441,12 @@ void VanillaCFR< config, Env, Policy, AveragePolicy >::_traverse_player_actions(
 {
    const auto& this_infostate = infostate_map.get().at(active_player);
    if constexpr(initialize_infonodes) {
-      _infonodes().emplace(
+      auto [_, success] = _infonodes().emplace(
          this_infostate, infostate_data_type{_env().actions(active_player, *state)}
       );
+      if(success) {
+         _stats().infostate_created();
+      }
    }
    const auto& actions = _infonode(this_infostate).actions();
    auto& action_policy = this->template fetch_policy< use_current_policy >(
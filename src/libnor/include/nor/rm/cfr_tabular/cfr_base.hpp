@@ -21,6 +21,7 @@
 #include "nor/rm/forest.hpp"
 #include "nor/rm/node.hpp"
 #include "nor/rm/rm_utils.hpp"
+#include "nor/rm/solver_stats.hpp"
 #include "nor/type_defs.hpp"
 #include "nor/utils/utils.hpp"
 
@@ -197,6 +198,10 @@ class TabularCFRBase {
    [[nodiscard]] inline const auto& policy() const { return m_curr_policy; }
    [[nodiscard]] inline const auto& average_policy() const { return m_avg_policy; }
    [[nodiscard]] inline const auto& env() const { return m_env; }
+   /// the solver's instrumentation counters and phase trace (empty unless compiled with
+   /// NOR_ENABLE_SOLVER_INSTRUMENTATION)
+   [[nodiscard]] inline const SolverStats& stats() const { return m_stats; }
+   inline void reset_stats() { m_stats.reset(); }
 
    //////////////////////////////////
    /// protected member functions ///
@@ -210,6 +215,7 @@ class TabularCFRBase {
    [[nodiscard]] inline auto& _policy() { return m_curr_policy; }
    [[nodiscard]] inline auto& _average_policy() { return m_avg_policy; }
    [[nodiscard]] inline auto& _player_update_schedule() { return m_player_update_schedule; }
+   [[nodiscard]] inline auto& _stats() { return m_stats; }
 
    /**
     * @brief Cycles the update schedule by popping the next player to update and requeueing them as
@@ -293,6 +299,8 @@ class TabularCFRBase {
    std::deque< Player > m_player_update_schedule{};
    /// the number of iterations we have run so far.
    size_t m_iteration = 0;
+   /// the instrumentation counters of the traversals and regret updates.
+   SolverStats m_stats{};
 };
 
 template < bool alternating_updates, typename Env, typename Policy, typename AveragePolicy >
@@ -240,6 +240,8 @@ class MCCFR:
    /// import public getters
 
    using base::env;
+   using base::stats;
+   using base::reset_stats;
    using base::policy;
    using base::average_policy;
    using base::iteration;
@@ -308,6 +310,7 @@ class MCCFR:
    using base::_cycle_player_to_update;
    using base::_preview_next_player_to_update;
    using base::_partial_pruning_condition;
+   using base::_stats;
 
    /// the relevant data stored at each infostate
    std::unordered_map<
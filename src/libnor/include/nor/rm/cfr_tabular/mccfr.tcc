@@ -123,6 +123,7 @@ auto MCCFR< config, Env, Policy, AveragePolicy >::_iterate(std::optional< Player
          utils::clone_any_way(_root_state_uptr())
       );
 
+      [[maybe_unused]] auto timer = _stats().time(SolverPhase::traversal, _iteration());
       return _traverse(
          player_to_update,
          *init_world_state,
@@ -152,18 +153,22 @@ auto MCCFR< config, Env, Policy, AveragePolicy >::_iterate(std::optional< Player
       )
    ) { // clang-format on
       delayed_update_set update_set{};
-      auto value = _traverse(
-         player_to_update.value(),
-         utils::static_unique_ptr_downcast< world_state_type >(
-            utils::clone_any_way(_root_state_uptr())
-         ),
-         init_obs_buffer(),
-         init_infostates(),
-         update_set
-      );
+      auto value = std::invoke([&] {
+         [[maybe_unused]] auto timer = _stats().time(SolverPhase::traversal, _iteration());
+         return _traverse(
+            player_to_update.value(),
+            utils::static_unique_ptr_downcast< world_state_type >(
+               utils::clone_any_way(_root_state_uptr())
+            ),
+            init_obs_buffer(),
+            init_infostates(),
+            update_set
+         );
+      });
       if constexpr(config.algorithm != MCCFRAlgorithmMode::external_sampling) {
          // external sampling is able to minimize the regret on the fly during the traversal, since
          // each infostate of the traverser is seen only once
+         [[maybe_unused]] auto timer = _stats().time(SolverPhase::regret_update, _iteration());
          _initiate_regret_minimization(update_set);
       }
       update_set.clear();
@@ -178,17 +183,23 @@ auto MCCFR< config, Env, Policy, AveragePolicy >::_iterate(std::optional< Player
       )
    ) { // clang-format on
       delayed_update_set update_set{};
-      auto values = _traverse(
-         player_to_update,
-         utils::static_unique_ptr_downcast< world_state_type >(
-            utils::clone_any_way(_root_state_uptr())
-         ),
-         init_reach_probs(),
-         init_obs_buffer(),
-         init_infostates(),
-         update_set
-      );
-      _initiate_regret_minimization(update_set);
+      auto values = std::invoke([&] {
+         [[maybe_unused]] auto timer = _stats().time(SolverPhase::traversal, _iteration());
+         return _traverse(
+            player_to_update,
+            utils::static_unique_ptr_downcast< world_state_type >(
+               utils::clone_any_way(_root_state_uptr())
+            ),
+            init_reach_probs(),
+            init_obs_buffer(),
+            init_infostates(),
+            update_set
+         );
+      });
+      {
+         [[maybe_unused]] auto timer = _stats().time(SolverPhase::regret_update, _iteration());
+         _initiate_regret_minimization(update_set);
+      }
       update_set.clear();
       return values;
    }
@@ -262,7 +273,9 @@ std::pair< StateValueMap, Probability > MCCFR< config, Env, Policy, AveragePolic
 )
    requires(config.algorithm == MCCFRAlgorithmMode::outcome_sampling)
 {
+   _stats().node_visited();
    if(_env().is_terminal(state)) {
+      _stats().terminal_evaluated();
       return _terminal_value(state, player_to_update, sample_probability);
    }
 
@@ -311,6 +324,7 @@ std::pair< StateValueMap, Probability > MCCFR< config, Env, Policy, AveragePolic
    const auto& infostate = infostate_and_data_iter->first;
    auto& infonode_data = infostate_and_data_iter->second;
    if(success) {
+      _stats().infostate_created();
       // success means we have indeed emplaced a new data node, instead of simply fetching an
       // existing one. We thus need to fill it with the legal actions at this node.
       infonode_data.emplace(_env().actions(active_player, state));
@@ -675,9 +689,11 @@ StateValue MCCFR< config, Env, Policy, AveragePolicy >::_traverse(
    )
 // clang-format on
 {
+   _stats().node_visited();
    Player active_player = _env().active_player(*state);
 
    if(_env().is_terminal(*state)) {
+      _stats().terminal_evaluated();
       return StateValue{_env().reward(player_to_update, *state)};
    }
 
@@ -718,6 +734,7 @@ StateValue MCCFR< config, Env, Policy, AveragePolicy >::_traverse(
    const auto& infostate = infostate_and_data_iter->first;
    auto& infonode_data = infostate_and_data_iter->second;
    if(success) {
+      _stats().infostate_created();
       // success means we have indeed emplaced a new data node, instead of simply fetching an
       // existing one. We thus need to fill it with the legal actions at this node.
       infonode_data.emplace(_env().actions(active_player, *state));
@@ -852,12 +869,15 @@ StateValueMap MCCFR< config, Env, Policy, AveragePolicy >::_traverse(
       )
 // clang-format on
 {
+   _stats().node_visited();
    if(_env().is_terminal(*curr_worldstate)) {
+      _stats().terminal_evaluated();
       return StateValueMap{collect_rewards(_env(), *curr_worldstate)};
    }
 
    if constexpr(config.algorithm != MCCFRAlgorithmMode::pure_cfr and config.pruning_mode == CFRPruningMode::partial) {
       if(_partial_pruning_condition(player_to_update, reach_probability)) {
+         _stats().subtree_pruned();
          // if the entire subtree is pruned then the values that could be found are all 0. for
          // each player
          return StateValueMap{std::invoke([&] {
@@ -913,6 +933,7 @@ StateValueMap MCCFR< config, Env, Policy, AveragePolicy >::_traverse(
    auto& infonode_data = infostate_and_data_iter->second;
    infostates_to_update.emplace(std::tuple{infostate.get(), std::ref(infonode_data)});
    if(success) {
+      _stats().infostate_created();
       // success means we have indeed emplaced a new data node, instead of simply fetching an
       // existing one.
       // We thus need to fill it with the legal actions at this node.
@@ -2,6 +2,14 @@
 #ifndef NOR_POLICY_VALUE_HPP
 #define NOR_POLICY_VALUE_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "nor/concepts.hpp"
 #include "rm_utils.hpp"
 
@@ -14,204 +22,358 @@ using ObservationbufferMap = fluent::NamedType<
    player_hashmap< std::vector< std::pair< Observation, Observation > > >,
    struct observation_buffer_tag >;
 
+/**
+ * @brief Iterative policy evaluation over the full game tree.
+ *
+ * The tree is walked depth-first on an explicit stack of frames instead of through recursion.
+ * Reach probabilities and state values of all frames live in two flat arrays (one row of
+ * `players.size()` doubles per frame) which are reused in place as the stack grows and shrinks.
+ * A child adds its weighted value directly into its parent's row once it is popped, so no
+ * per-node action-value tables are ever built. The stack and both arrays are thread-local scratch
+ * space which is kept alive between calls.
+ */
 struct policy_value_impl {
+   template < typename Env >
+   struct frame {
+      using env_type = std::remove_cvref_t< Env >;
+      using observation_type = auto_observation_type< env_type >;
+      using observation_buffer_type =
+         player_hashmap< std::vector< std::pair< observation_type, observation_type > > >;
+      using infostate_map_type = player_hashmap< auto_info_state_type< env_type > >;
+
+      uptr< auto_world_state_type< env_type > > state;
+      observation_buffer_type observation_buffer;
+      infostate_map_type infostates;
+      /// the frame index of the parent on the stack
+      size_t parent;
+      /// the likelihood of the action (or chance outcome) that led from the parent to this frame
+      double likelihood;
+      /// whether the children of this frame have already been put on the stack
+      bool expanded = false;
+   };
+
+   template < typename Env >
+   struct scratch {
+      std::vector< frame< Env > > stack;
+      std::vector< double > reach;
+      std::vector< double > values;
+   };
+
+   static constexpr size_t no_parent = std::numeric_limits< size_t >::max();
+
+   static size_t slot_of(const std::vector< Player >& players, Player player)
+   {
+      return static_cast< size_t >(std::distance(players.begin(), ranges::find(players, player)));
+   }
+
+   /**
+    * @brief Computes the value of every player in `players` at the given state.
+    *
+    * @param players the actual (non-chance) players. Defines the slot order of reach and values.
+    * @param reach_probability the players' reach probabilities of `state` in slot order.
+    * @return the state's value for each player in slot order.
+    */
    template < typename Env, typename Policy >
       requires concepts::fosg< std::remove_cvref_t< Env > >
-   static StateValueMap traverse(
+   static std::vector< double > traverse(
       Env&& env,
       const player_hashmap< Policy >& policy_profile,
+      const std::vector< Player >& players,
       uptr< auto_world_state_type< std::remove_cvref_t< Env > > > state,
-      ReachProbabilityMap reach_probability,
-      ObservationbufferMap< auto_observation_type< std::remove_cvref_t< Env > > >
-         observation_buffer,
-      player_hashmap< auto_info_state_type< std::remove_cvref_t< Env > > > infostates
+      const std::vector< double >& reach_probability,
+      typename frame< Env >::observation_buffer_type observation_buffer,
+      typename frame< Env >::infostate_map_type infostates
    )
    {
       using env_type = std::remove_cvref_t< Env >;
-      if(env.is_terminal(*state)) {
-         return StateValueMap{collect_rewards(env, *state)};
-      }
+      const size_t n_players = players.size();
+
+      // take ownership of this thread's scratch space. Moving it out (and back in at the end)
+      // keeps a nested call on the same thread from trampling over a running traversal.
+      thread_local scratch< Env > tl_scratch;
+      auto stack = std::move(tl_scratch.stack);
+      auto reach = std::move(tl_scratch.reach);
+      auto values = std::move(tl_scratch.values);
+      stack.clear();
+      reach.clear();
+      values.clear();
 
-      if(ranges::all_of(reach_probability.get(), [&](const auto& player_rp_pair) {
-            // A mere check on ONE of the opponents having reach prob 0 and the active player
-            // having reach prob 0 would not suffice in the multiplayer case as some average
-            // strategy updates of other opponent with reach prob > 0 would be missed
-            const auto& [player, rp] = player_rp_pair;
-            return player != Player::chance and rp <= std::numeric_limits< double >::epsilon();
-         })) {
-         // if the entire subtree is pruned then the only values that could be found are all 0 for
-         // each player
-         return StateValueMap{std::invoke([&] {
-            StateValueMap::UnderlyingType map;
-            for(auto player : env.players(*state)) {
-               if(utils::is_actual_player_pred(player)) {
-                  map[player] = 0.;
-               }
+      std::vector< double > root_value(n_players, 0.);
+
+      stack.emplace_back(
+         std::move(state), std::move(observation_buffer), std::move(infostates), no_parent, 1.
+      );
+      reach.assign(reach_probability.begin(), reach_probability.end());
+      values.assign(n_players, 0.);
+
+      // pops the top frame and adds its value, weighted by the likelihood of reaching it from its
+      // parent, into the parent's value row.
+      auto finish_top = [&] {
+         const size_t idx = stack.size() - 1;
+         const size_t offset = idx * n_players;
+         const auto& top = stack.back();
+         if(top.parent == no_parent) {
+            std::copy_n(values.begin() + long(offset), n_players, root_value.begin());
+         } else {
+            const size_t parent_offset = top.parent * n_players;
+            for(size_t i = 0; i < n_players; ++i) {
+               values[parent_offset + i] += top.likelihood * values[offset + i];
             }
-            return map;
-         })};
-      }
+         }
+         stack.pop_back();
+         reach.resize(offset);
+         values.resize(offset);
+      };
 
-      Player active_player = env.active_player(*state);
-      // the state's value for each player. To be filled by the action traversal functions.
-      StateValueMap state_value{{}};
-      // each action's value for each player. To be filled by the action traversal functions.
-      std::unordered_map< auto_action_variant_type< env_type >, StateValueMap > action_value;
-      // traverse all child states from this state. The constexpr check for determinism in the env
-      // allows deterministic envs to not provide certain functions that are only needed in the
-      // stochastic case.
-      // First define the default branch for an active non-chance player
-      auto nonchance_player_traverse = [&] {
-         traverse_player_actions(
-            env,
-            policy_profile,
-            active_player,
-            std::move(state),
-            reach_probability,
-            std::move(observation_buffer),
-            std::move(infostates),
-            state_value,
-            action_value
+      // appends a child frame with the parent's reach row, scaled at the given slot
+      auto push_child = [&](
+                           size_t parent_idx,
+                           uptr< auto_world_state_type< env_type > > child_wstate,
+                           typename frame< Env >::observation_buffer_type child_obs_buffer,
+                           typename frame< Env >::infostate_map_type child_infostates,
+                           double likelihood,
+                           size_t scaled_slot
+                        ) {
+         stack.emplace_back(
+            std::move(child_wstate),
+            std::move(child_obs_buffer),
+            std::move(child_infostates),
+            parent_idx,
+            likelihood
          );
+         const size_t parent_offset = parent_idx * n_players;
+         const size_t child_offset = reach.size();
+         reach.resize(child_offset + n_players);
+         values.resize(child_offset + n_players, 0.);
+         for(size_t i = 0; i < n_players; ++i) {
+            reach[child_offset + i] = reach[parent_offset + i];
+         }
+         if(scaled_slot < n_players) {
+            reach[child_offset + scaled_slot] *= likelihood;
+         }
       };
-      // now we check first if we even need to consider a chance player, as the env could be simply
-      // deterministic. In that case we might need to traverse the chance player's actions or an
-      // active player's actions
-      if constexpr(concepts::stochastic_env< env_type >) {
-         if(active_player == Player::chance) {
-            traverse_chance_actions(
-               env,
-               policy_profile,
-               active_player,
-               std::move(state),
-               reach_probability,
-               std::move(observation_buffer),
-               std::move(infostates),
-               state_value,
-               action_value
-            );
-            // if this is a chance node then we don't need to update any regret or average policy
-            // after the traversal
-            return state_value;
-         } else {
-            nonchance_player_traverse();
+
+      // expands all children of the parent, the last child steals the parent's buffers
+      auto expand = [&](
+                       size_t parent_idx,
+                       const auto& wstate,
+                       auto& obs_buffer,
+                       auto& infostate_map,
+                       auto&& actions_or_outcomes,
+                       auto&& likelihood_of,
+                       size_t scaled_slot
+                    ) {
+         const auto n_children = static_cast< size_t >(ranges::distance(actions_or_outcomes));
+         size_t child_nr = 0;
+         for(auto&& action_or_outcome : actions_or_outcomes) {
+            double likelihood = likelihood_of(action_or_outcome);
+            auto next_wstate_uptr = child_state(env, wstate, action_or_outcome);
+            if(++child_nr == n_children) {
+               next_infostate_and_obs_buffers_inplace(
+                  env, obs_buffer, infostate_map, wstate, action_or_outcome, *next_wstate_uptr
+               );
+               push_child(
+                  parent_idx,
+                  std::move(next_wstate_uptr),
+                  std::move(obs_buffer),
+                  std::move(infostate_map),
+                  likelihood,
+                  scaled_slot
+               );
+            } else {
+               auto [child_obs_buffer, child_infostates] = next_infostate_and_obs_buffers(
+                  env, obs_buffer, infostate_map, wstate, action_or_outcome, *next_wstate_uptr
+               );
+               push_child(
+                  parent_idx,
+                  std::move(next_wstate_uptr),
+                  std::move(child_obs_buffer),
+                  std::move(child_infostates),
+                  likelihood,
+                  scaled_slot
+               );
+            }
          }
-      } else {
-         nonchance_player_traverse();
+      };
+
+      while(not stack.empty()) {
+         const size_t idx = stack.size() - 1;
+         const size_t offset = idx * n_players;
+         auto& top = stack.back();
+         if(top.expanded) {
+            // every child of this frame has been popped already, its value is complete.
+            finish_top();
+            continue;
+         }
+         if(env.is_terminal(*top.state)) {
+            write_rewards(env, *top.state, players, values.begin() + long(offset));
+            finish_top();
+            continue;
+         }
+         // A mere check on ONE of the opponents having reach prob 0 and the active player
+         // having reach prob 0 would not suffice in the multiplayer case as some average
+         // strategy updates of other opponent with reach prob > 0 would be missed
+         if(std::all_of(
+               reach.begin() + long(offset),
+               reach.begin() + long(offset + n_players),
+               [](double rp) { return rp <= std::numeric_limits< double >::epsilon(); }
+            )) {
+            // if the entire subtree is pruned then the only values that could be found are all 0
+            // for each player. The value row is zero-initialized already.
+            finish_top();
+            continue;
+         }
+         top.expanded = true;
+         // The children are appended to the stack, which may reallocate. Hence, we move the
+         // frame's contents out first, as the frame itself no longer needs them.
+         auto wstate = std::move(top.state);
+         auto obs_buffer = std::move(top.observation_buffer);
+         auto infostate_map = std::move(top.infostates);
+
+         Player active_player = env.active_player(*wstate);
+         // The constexpr check for determinism in the env allows deterministic envs to not provide
+         // certain functions that are only needed in the stochastic case.
+         if constexpr(concepts::stochastic_env< env_type >) {
+            if(active_player == Player::chance) {
+               expand(
+                  idx,
+                  *wstate,
+                  obs_buffer,
+                  infostate_map,
+                  env.chance_actions(*wstate),
+                  [&](const auto& outcome) { return env.chance_probability(*wstate, outcome); },
+                  n_players
+               );
+               continue;
+            }
+         }
+         auto&& action_policy = policy_profile.at(active_player).at(infostate_map.at(active_player)
+         );
+         expand(
+            idx,
+            *wstate,
+            obs_buffer,
+            infostate_map,
+            env.actions(active_player, *wstate),
+            [&](const auto& action) { return action_policy.at(action); },
+            slot_of(players, active_player)
+         );
       }
 
-      return StateValueMap{std::move(state_value)};
+      tl_scratch.stack = std::move(stack);
+      tl_scratch.reach = std::move(reach);
+      tl_scratch.values = std::move(values);
+      return root_value;
    }
 
+   /**
+    * @brief Evaluates each chance outcome of a chance root state in parallel.
+    *
+    * Every outcome's subtree is traversed independently (on its own thread-local scratch space)
+    * and the results are combined by their chance probabilities afterwards. The outcomes are
+    * handed out to a pool of worker threads one at a time, so `env` is called from several
+    * threads at once: envs with mutable state or a Python backing are not safe to use here.
+    */
    template < typename Env, typename Policy >
-   static void traverse_player_actions(
+      requires concepts::fosg< std::remove_cvref_t< Env > >
+               and concepts::stochastic_env< std::remove_cvref_t< Env > >
+   static std::vector< double > traverse_chance_root_parallel(
       Env&& env,
       const player_hashmap< Policy >& policy_profile,
-      Player active_player,
-      uptr< auto_world_state_type< std::remove_cvref_t< Env > > > state,
-      const ReachProbabilityMap& reach_probability,
-      const ObservationbufferMap< auto_observation_type< std::remove_cvref_t< Env > > >&
-         observation_buffer,
-      player_hashmap< auto_info_state_type< std::remove_cvref_t< Env > > > infostate_map,
-      StateValueMap& state_value,
-      std::unordered_map< auto_action_variant_type< std::remove_cvref_t< Env > >, StateValueMap >&
-         action_value
+      const std::vector< Player >& players,
+      const auto_world_state_type< std::remove_cvref_t< Env > >& root_state,
+      const std::vector< double >& reach_probability,
+      const typename frame< Env >::observation_buffer_type& observation_buffer,
+      const typename frame< Env >::infostate_map_type& infostates
    )
    {
-      using env_type = std::remove_cvref_t< Env >;
-
-      auto& this_infostate = infostate_map.at(active_player);
-      auto&& action_policy = policy_profile.at(active_player).at(this_infostate);
-      //      double normalizing_factor = ranges::accumulate(
-      //         action_policy | ranges::views::values, double(0.), std::plus{}
-      //      );
-      //      if(std::abs(normalizing_factor) < 1e-20) {
-      //         throw std::invalid_argument(
-      //            "Average policy likelihoods accumulate to 0. Such values cannot be normalized."
-      //         );
-      //      }
-
-      for(const auto_action_type< env_type >& action : env.actions(active_player, *state)) {
-         auto action_prob = action_policy.at(action);
-
-         auto child_reach_prob = reach_probability.get();
-         child_reach_prob[active_player] *= action_prob;
-
-         uptr< auto_world_state_type< env_type > > next_wstate_uptr = child_state(
-            env, *state, action
-         );
-         auto [child_observation_buffer, child_infostate_map] = next_infostate_and_obs_buffers(
-            env, observation_buffer.get(), infostate_map, *state, action, *next_wstate_uptr
-         );
-
-         StateValueMap child_rewards_map = traverse(
-            env,
-            policy_profile,
-            std::move(next_wstate_uptr),
-            ReachProbabilityMap{std::move(child_reach_prob)},
-            ObservationbufferMap< auto_observation_type< env_type > >{
-               std::move(child_observation_buffer)},
-            player_hashmap< auto_info_state_type< env_type > >{std::move(child_infostate_map)}
-         );
-         // add the child state's value to the respective player's value table, multiplied by the
-         // policies likelihood of playing this action
-         for(auto [player, child_value] : child_rewards_map.get()) {
-            state_value.get()[player] += action_prob * child_value;
+      auto outcomes = env.chance_actions(root_state);
+      const size_t n_outcomes = outcomes.size();
+      std::vector< std::vector< double > > outcome_values(n_outcomes);
+      std::atomic< size_t > next_outcome{0};
+      // the first exception of any thread is rethrown once all of them have joined
+      std::exception_ptr error;
+      std::mutex error_mutex;
+      auto work = [&] {
+         try {
+            for(size_t i = next_outcome++; i < n_outcomes; i = next_outcome++) {
+               const auto& outcome = outcomes[i];
+               auto next_wstate_uptr = child_state(env, root_state, outcome);
+               auto [child_obs_buffer, child_infostates] = next_infostate_and_obs_buffers(
+                  env, observation_buffer, infostates, root_state, outcome, *next_wstate_uptr
+               );
+               outcome_values[i] = traverse(
+                  env,
+                  policy_profile,
+                  players,
+                  std::move(next_wstate_uptr),
+                  reach_probability,
+                  std::move(child_obs_buffer),
+                  std::move(child_infostates)
+               );
+            }
+         } catch(...) {
+            std::scoped_lock lock{error_mutex};
+            if(not error) {
+               error = std::current_exception();
+            }
+            next_outcome = n_outcomes;
+         }
+      };
+      size_t n_threads = std::min(
+         n_outcomes, std::max(size_t(1), size_t(std::thread::hardware_concurrency()))
+      );
+      {
+         std::vector< std::jthread > workers;
+         for(size_t t = 1; t < n_threads; t++) {
+            workers.emplace_back(work);
          }
-         action_value.emplace(action, std::move(child_rewards_map));
+         work();
       }
+      if(error) {
+         std::rethrow_exception(error);
+      }
+      std::vector< double > value(players.size(), 0.);
+      for(auto&& [outcome, outcome_value] : ranges::views::zip(outcomes, outcome_values)) {
+         double outcome_prob = env.chance_probability(root_state, outcome);
+         for(size_t i = 0; i < players.size(); ++i) {
+            value[i] += outcome_prob * outcome_value[i];
+         }
+      }
+      return value;
    }
 
-   template < typename Env, typename Policy >
-   static void traverse_chance_actions(
+   template < typename Env, typename Worldstate >
+   static void write_rewards(
       Env&& env,
-      const player_hashmap< Policy >& policy_profile,
-      Player active_player,
-      uptr< auto_world_state_type< std::remove_cvref_t< Env > > > state,
-      const ReachProbabilityMap& reach_probability,
-      const ObservationbufferMap< auto_observation_type< std::remove_cvref_t< Env > > >&
-         observation_buffer,
-      player_hashmap< auto_info_state_type< std::remove_cvref_t< Env > > > infostate_map,
-      StateValueMap& state_value,
-      std::unordered_map< auto_action_variant_type< std::remove_cvref_t< Env > >, StateValueMap >&
-         action_value
+      Worldstate& terminal_wstate,
+      const std::vector< Player >& players,
+      std::vector< double >::iterator values_begin
    )
    {
-      using env_type = std::remove_cvref_t< Env >;
-      for(auto&& outcome : env.chance_actions(*state)) {
-         uptr< auto_world_state_type< env_type > > next_wstate_uptr = child_state(
-            env, *state, outcome
-         );
-
-         auto child_reach_prob = reach_probability.get();
-         auto outcome_prob = env.chance_probability(*state, outcome);
-         child_reach_prob[active_player] *= outcome_prob;
-
-         auto [child_observation_buffer, child_infostate_map] = next_infostate_and_obs_buffers(
-            env, observation_buffer.get(), infostate_map, *state, outcome, *next_wstate_uptr
-         );
-
-         StateValueMap child_rewards_map = traverse(
-            env,
-            policy_profile,
-            std::move(next_wstate_uptr),
-            ReachProbabilityMap{std::move(child_reach_prob)},
-            ObservationbufferMap< auto_observation_type< env_type > >{
-               std::move(child_observation_buffer)},
-            player_hashmap< auto_info_state_type< env_type > >{std::move(child_infostate_map)}
-         );
-         // add the child state's value to the respective player's value table, multiplied by the
-         // policies likelihood of playing this action
-         for(auto [player, child_value] : child_rewards_map.get()) {
-            state_value.get()[player] += outcome_prob * child_value;
+      if constexpr(nor::concepts::has::method::reward_multi< std::remove_cvref_t< Env > >) {
+         auto all_rewards = env.reward(players, terminal_wstate);
+         for(size_t i = 0; i < players.size(); ++i) {
+            *(values_begin + long(i)) = all_rewards[players[i]];
+         }
+      } else {
+         for(size_t i = 0; i < players.size(); ++i) {
+            *(values_begin + long(i)) = env.reward(players[i], terminal_wstate);
          }
-         action_value.emplace(std::move(outcome), std::move(child_rewards_map));
       }
    }
 };
 
 }  // namespace detail
 
+/**
+ * @brief Computes the expected value of each player under the given policy profile.
+ *
+ * @param parallelize_chance if true and the root state is a chance node, then the subtrees of
+ * the root's chance outcomes are evaluated in parallel. The env is then called from several
+ * threads at once and needs to be safe to use concurrently for this (i.e. its methods may not
+ * mutate any shared state), which rules out envs with mutable state or a Python backing.
+ */
 template <
    typename Env,
    typename Policy,
@@ -228,40 +390,59 @@ template <
 StateValueMap policy_value(
    Env&& env,
    const auto_world_state_type< std::remove_cvref_t< Env > >& root_state,
-   const player_hashmap< Policy >& policy_profile
+   const player_hashmap< Policy >& policy_profile,
+   bool parallelize_chance = false
 )
 {
    using env_type = std::remove_cvref_t< Env >;
-   auto root_players = env.players(root_state);
-   return detail::policy_value_impl::traverse(
-      env,
-      policy_profile,
-      utils::static_unique_ptr_downcast< auto_world_state_type< env_type > >(
-         utils::clone_any_way(root_state)
-      ),
-      std::invoke([&] {
-         ReachProbabilityMap rp_map{{}};
-         for(auto player : root_players) {
-            rp_map.get().emplace(player, 1.);
-         }
-         return rp_map;
-      }),
-      std::invoke([&] {
-         detail::ObservationbufferMap< auto_observation_type< env_type > > obs_map{{}};
-         for(auto player : root_players | utils::is_actual_player_filter) {
-            obs_map.get().try_emplace(player);
-         }
-         return obs_map;
-      }),
-      std::invoke([&] {
-         player_hashmap< auto_info_state_type< env_type > > infostates;
-         for(auto player : root_players | utils::is_actual_player_filter) {
-            infostates.emplace(player, auto_info_state_type< env_type >{player});
+   using frame_type = detail::policy_value_impl::frame< Env >;
+
+   std::vector< Player > players;
+   for(auto player : env.players(root_state) | utils::is_actual_player_filter) {
+      players.emplace_back(player);
+   }
+   std::vector< double > reach_probability(players.size(), 1.);
+   typename frame_type::observation_buffer_type observation_buffer;
+   typename frame_type::infostate_map_type infostates;
+   for(auto player : players) {
+      observation_buffer.try_emplace(player);
+      infostates.emplace(player, auto_info_state_type< env_type >{player});
+   }
+
+   auto values = std::invoke([&] {
+      if constexpr(concepts::stochastic_env< env_type >) {
+         if(parallelize_chance and not env.is_terminal(root_state)
+            and env.active_player(root_state) == Player::chance) {
+            return detail::policy_value_impl::traverse_chance_root_parallel(
+               env,
+               policy_profile,
+               players,
+               root_state,
+               reach_probability,
+               observation_buffer,
+               infostates
+            );
          }
-         return infostates;
-      })
-   );
-}  // namespace nor::rm
+      }
+      return detail::policy_value_impl::traverse(
+         env,
+         policy_profile,
+         players,
+         utils::static_unique_ptr_downcast< auto_world_state_type< env_type > >(
+            utils::clone_any_way(root_state)
+         ),
+         reach_probability,
+         std::move(observation_buffer),
+         std::move(infostates)
+      );
+   });
+
+   StateValueMap value_map{{}};
+   for(size_t i = 0; i < players.size(); ++i) {
+      value_map.get().emplace(players[i], values[i]);
+   }
+   return value_map;
+}
 
 }  // namespace nor::rm
 
@@ -0,0 +1,265 @@
+
+#ifndef NOR_SOLVER_STATS_HPP
+#define NOR_SOLVER_STATS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace nor::rm {
+
+/// Whether the solvers record their statistics. The instrumentation is compiled in only if
+/// NOR_ENABLE_SOLVER_INSTRUMENTATION is defined (cmake option ENABLE_SOLVER_INSTRUMENTATION),
+/// otherwise every recording call is an empty inline function.
+#ifdef NOR_ENABLE_SOLVER_INSTRUMENTATION
+inline constexpr bool solver_instrumentation_enabled = true;
+#else
+inline constexpr bool solver_instrumentation_enabled = false;
+#endif
+
+enum class SolverPhase { traversal = 0, regret_update = 1 };
+
+inline std::string to_string(SolverPhase phase)
+{
+   return phase == SolverPhase::traversal ? "traversal" : "regret_update";
+}
+
+struct SolverCounters {
+   /// the number of world states visited during traversals
+   size_t nodes_visited = 0;
+   /// the number of terminal world states whose rewards have been evaluated
+   size_t terminals_evaluated = 0;
+   /// the number of infostate data nodes the solver has newly created
+   size_t infostates_created = 0;
+   /// the number of subtrees skipped by pruning
+   size_t subtrees_pruned = 0;
+   /// the time spent in tree traversals (including inline regret updates during traversal)
+   std::chrono::nanoseconds traversal_time{0};
+   /// the time spent in the regret minimization pass over the infostates after a traversal
+   std::chrono::nanoseconds regret_update_time{0};
+};
+
+/**
+ * @brief Low-overhead statistics of a solver's iterations.
+ *
+ * The solver reports visited nodes, terminals, created infostates and pruned subtrees as they
+ * happen and times its phases through the scoped timers returned by `time`. The most recent timed
+ * phases are also kept as trace events in a ring buffer of fixed capacity, so that they can be
+ * exported in the Chrome trace-event format (viewable in chrome://tracing or Perfetto) without the
+ * memory of long runs growing with the number of iterations.
+ */
+class SolverStats {
+   using clock = std::chrono::steady_clock;
+
+  public:
+   /// a finished, timed phase of one iteration
+   struct TraceEvent {
+      SolverPhase phase;
+      size_t iteration;
+      std::chrono::nanoseconds start;
+      std::chrono::nanoseconds duration;
+      SolverCounters counters_after;
+   };
+
+   /// RAII timer adding the time until its destruction to the given phase
+   class PhaseTimer {
+     public:
+      PhaseTimer(SolverStats* stats, SolverPhase phase, size_t iteration)
+          : m_stats(stats), m_phase(phase), m_iteration(iteration), m_start(clock::now())
+      {
+      }
+      PhaseTimer(const PhaseTimer&) = delete;
+      PhaseTimer& operator=(const PhaseTimer&) = delete;
+      PhaseTimer(PhaseTimer&&) = delete;
+      PhaseTimer& operator=(PhaseTimer&&) = delete;
+      ~PhaseTimer() { m_stats->_record_phase(m_phase, m_iteration, m_start, clock::now()); }
+
+     private:
+      SolverStats* m_stats;
+      SolverPhase m_phase;
+      size_t m_iteration;
+      clock::time_point m_start;
+   };
+
+   /// a timer which does nothing, returned when the instrumentation is compiled out
+   struct NoopTimer {};
+
+   /// the number of trace events kept by default (two per iteration)
+   static constexpr size_t default_trace_capacity = 1 << 16;
+
+   /// a ring buffer of the last trace events which overwrites the oldest once it is full
+   class TraceBuffer {
+     public:
+      explicit TraceBuffer(size_t capacity = default_trace_capacity) : m_capacity(capacity) {}
+
+      void push(const TraceEvent& event)
+      {
+         if(m_capacity == 0) {
+            return;
+         }
+         if(m_events.size() < m_capacity) {
+            m_events.emplace_back(event);
+         } else {
+            m_events[m_next] = event;
+         }
+         m_next = (m_next + 1) % m_capacity;
+      }
+
+      /// the kept events from the oldest to the newest
+      [[nodiscard]] std::vector< TraceEvent > events() const
+      {
+         if(m_events.size() < m_capacity) {
+            return m_events;
+         }
+         std::vector< TraceEvent > ordered;
+         ordered.reserve(m_events.size());
+         ordered.insert(ordered.end(), m_events.begin() + long(m_next), m_events.end());
+         ordered.insert(ordered.end(), m_events.begin(), m_events.begin() + long(m_next));
+         return ordered;
+      }
+
+      [[nodiscard]] size_t capacity() const { return m_capacity; }
+
+      void clear()
+      {
+         m_events.clear();
+         m_next = 0;
+      }
+
+     private:
+      size_t m_capacity;
+      size_t m_next = 0;
+      std::vector< TraceEvent > m_events{};
+   };
+
+   void node_visited()
+   {
+      if constexpr(solver_instrumentation_enabled) {
+         ++m_counters.nodes_visited;
+      }
+   }
+   void terminal_evaluated()
+   {
+      if constexpr(solver_instrumentation_enabled) {
+         ++m_counters.terminals_evaluated;
+      }
+   }
+   void infostate_created()
+   {
+      if constexpr(solver_instrumentation_enabled) {
+         ++m_counters.infostates_created;
+      }
+   }
+   void subtree_pruned()
+   {
+      if constexpr(solver_instrumentation_enabled) {
+         ++m_counters.subtrees_pruned;
+      }
+   }
+
+   [[nodiscard]] auto time(SolverPhase phase, size_t iteration)
+   {
+      if constexpr(solver_instrumentation_enabled) {
+         return PhaseTimer{this, phase, iteration};
+      } else {
+         return NoopTimer{};
+      }
+   }
+
+   [[nodiscard]] const SolverCounters& counters() const { return m_counters; }
+   /// the kept trace events from the oldest to the newest (none if compiled out)
+   [[nodiscard]] std::vector< TraceEvent > trace() const
+   {
+      return m_trace.events();
+   }
+
+   /// sets the number of trace events kept, dropping those recorded so far
+   void set_trace_capacity(size_t capacity)
+   {
+      m_trace = trace_type{capacity};
+   }
+
+   void reset()
+   {
+      m_counters = SolverCounters{};
+      m_trace.clear();
+      m_epoch = clock::now();
+   }
+
+   /// writes all recorded phases (as complete events) and the counters after each phase (as
+   /// counter events) in the Chrome trace-event JSON format
+   void write_chrome_trace(std::ostream& os) const
+   {
+      auto to_us = [](std::chrono::nanoseconds ns) { return double(ns.count()) / 1000.; };
+      os << R"({"displayTimeUnit":"ns","traceEvents":[)";
+      bool first = true;
+      for(const auto& event : trace()) {
+         if(not first) {
+            os << ",";
+         }
+         first = false;
+         os << R"({"name":")" << to_string(event.phase) << R"(","cat":"solver","ph":"X",)"
+            << R"("pid":0,"tid":0,"ts":)" << to_us(event.start)
+            << R"(,"dur":)" << to_us(event.duration)
+            << R"(,"args":{"iteration":)" << event.iteration << "}},";
+         const auto& counters = event.counters_after;
+         os << R"({"name":"counters","cat":"solver","ph":"C","pid":0,"tid":0,"ts":)"
+            << to_us(event.start + event.duration) << R"(,"args":{)"
+            << R"("nodes_visited":)" << counters.nodes_visited
+            << R"(,"terminals_evaluated":)" << counters.terminals_evaluated
+            << R"(,"infostates_created":)" << counters.infostates_created
+            << R"(,"subtrees_pruned":)" << counters.subtrees_pruned << "}}";
+      }
+      os << "]}";
+   }
+
+   [[nodiscard]] std::string chrome_trace() const
+   {
+      std::stringstream ss;
+      write_chrome_trace(ss);
+      return ss.str();
+   }
+
+  private:
+   /// keeps nothing in place of the trace buffer when the instrumentation is compiled out
+   struct NoTrace {
+      explicit NoTrace(size_t = 0) {}
+      void push(const TraceEvent&) {}
+      [[nodiscard]] std::vector< TraceEvent > events() const { return {}; }
+      void clear() {}
+   };
+   using trace_type = std::conditional_t< solver_instrumentation_enabled, TraceBuffer, NoTrace >;
+
+   SolverCounters m_counters{};
+   [[no_unique_address]] trace_type m_trace{default_trace_capacity};
+   clock::time_point m_epoch = clock::now();
+
+   void _record_phase(
+      SolverPhase phase,
+      size_t iteration,
+      clock::time_point start,
+      clock::time_point end
+   )
+   {
+      auto duration = std::chrono::duration_cast< std::chrono::nanoseconds >(end - start);
+      if(phase == SolverPhase::traversal) {
+         m_counters.traversal_time += duration;
+      } else {
+         m_counters.regret_update_time += duration;
+      }
+      m_trace.push(TraceEvent{
+         phase,
+         iteration,
+         std::chrono::duration_cast< std::chrono::nanoseconds >(start - m_epoch),
+         duration,
+         m_counters});
+   }
+};
+
+}  // namespace nor::rm
+
+#endif  // NOR_SOLVER_STATS_HPP
@@ -0,0 +1,151 @@
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+
+#include "kuhn_poker/kuhn_poker.hpp"
+
+using namespace kuhn;
+
+namespace {
+
+/// visits every decision node of the game with the given function
+template < typename Visitor >
+void traverse(const general::State& state, Visitor&& visitor)
+{
+   if(state.is_terminal()) {
+      return;
+   }
+   if(state.active_player() == Player::chance) {
+      for(auto outcome : state.chance_actions()) {
+         auto child = state;
+         child.apply_action(outcome);
+         traverse(child, visitor);
+      }
+      return;
+   }
+   visitor(state);
+   for(auto action : state.actions()) {
+      auto child = state;
+      child.apply_action(action);
+      traverse(child, visitor);
+   }
+}
+
+}  // namespace
+
+TEST(GeneralKuhn, two_players_three_cards_is_kuhn)
+{
+   const std::vector< std::vector< Action > > sequences{
+      {Action::check, Action::check},
+      {Action::check, Action::bet, Action::check},
+      {Action::check, Action::bet, Action::bet},
+      {Action::bet, Action::check},
+      {Action::bet, Action::bet}};
+   const std::array kuhn_cards{Card::jack, Card::queen, Card::king};
+   for(size_t c1 = 0; c1 < 3; c1++) {
+      for(size_t c2 = 0; c2 < 3; c2++) {
+         if(c1 == c2) {
+            continue;
+         }
+         for(const auto& sequence : sequences) {
+            State kuhn_state{};
+            kuhn_state.apply_action(ChanceOutcome{Player::one, kuhn_cards[c1]});
+            kuhn_state.apply_action(ChanceOutcome{Player::two, kuhn_cards[c2]});
+            general::State state{};
+            state.apply_action(general::ChanceOutcome{Player::one, general::Card(c1)});
+            state.apply_action(general::ChanceOutcome{Player::two, general::Card(c2)});
+            for(auto action : sequence) {
+               ASSERT_EQ(state.active_player(), kuhn_state.active_player());
+               ASSERT_FALSE(state.is_terminal());
+               kuhn_state.apply_action(action);
+               state.apply_action(action);
+            }
+            ASSERT_TRUE(state.is_terminal());
+            EXPECT_EQ(state.history(), sequence);
+            for(auto player : {Player::one, Player::two}) {
+               EXPECT_EQ(state.payoff(player), kuhn_state.payoff(player));
+            }
+         }
+      }
+   }
+}
+
+TEST(GeneralKuhn, three_player_payoffs)
+{
+   constexpr auto play = [](std::initializer_list< Action > actions) {
+      general::State state{{.n_players = 3, .n_cards = 4}};
+      // player 2 holds the best card, player 3 the worst
+      int seat = 0;
+      for(general::Card card : {2, 3, 0}) {
+         state.apply_action(general::ChanceOutcome{Player(seat++), card});
+      }
+      for(auto action : actions) {
+         state.apply_action(action);
+      }
+      return state;
+   };
+   // everyone checks: the best card wins the antes
+   constexpr auto checked = play({Action::check, Action::check, Action::check});
+   static_assert(checked.is_terminal());
+   static_assert(checked.payoff(Player::two) == 2 and checked.payoff(Player::one) == -1);
+   // player 1 bets, player 2 folds, player 3 calls
+   constexpr auto called = play({Action::bet, Action::check, Action::bet});
+   static_assert(called.is_terminal());
+   static_assert(called.payoff(Player::one) == 3);
+   static_assert(called.payoff(Player::two) == -1);
+   static_assert(called.payoff(Player(2)) == -2);
+   // player 2 bets after a check and everyone folds
+   constexpr auto folded = play({Action::check, Action::bet, Action::check, Action::check});
+   static_assert(folded.is_terminal());
+   static_assert(folded.payoff(Player::two) == 2);
+   static_assert(not play({Action::check, Action::bet, Action::check}).is_terminal());
+   static_assert(play({Action::check, Action::bet, Action::check}).active_player() == Player::one);
+}
+
+TEST(GeneralKuhn, infostate_indices_are_a_bijection)
+{
+   for(auto [n_players, n_cards] : std::vector< std::pair< size_t, size_t > >{
+          {2, 3}, {3, 4}, {4, 6}}) {
+      general::Config config{n_players, n_cards};
+      std::vector< std::map< std::pair< general::Card, std::vector< Action > >, size_t > >
+         index_of_infostate(n_players);
+      traverse(general::State{config}, [&](const general::State& state) {
+         auto player = static_cast< size_t >(state.active_player());
+         auto index = state.infostate_index();
+         ASSERT_LT(index, config.n_infostates_per_player());
+         auto [pos, inserted] = index_of_infostate[player].emplace(
+            std::pair{*state.card(state.active_player()), state.history()}, index
+         );
+         // the same infostate is always given the same index
+         ASSERT_EQ(pos->second, index);
+      });
+      size_t n_infostates = 0;
+      for(const auto& indices : index_of_infostate) {
+         std::set< size_t > distinct;
+         for(const auto& [infostate, index] : indices) {
+            distinct.emplace(index);
+         }
+         // and different infostates different indices, covering the whole range
+         EXPECT_EQ(distinct.size(), indices.size());
+         EXPECT_EQ(indices.size(), config.n_infostates_per_player());
+         n_infostates += indices.size();
+      }
+      EXPECT_EQ(n_infostates, config.n_infostates());
+   }
+   EXPECT_EQ((general::Config{2, 3}.n_infostates()), 12);
+}
+
+TEST(GeneralKuhn, invalid_configs_and_actions_throw)
+{
+   EXPECT_THROW(general::State({.n_players = 1}), std::invalid_argument);
+   EXPECT_THROW(general::State({.n_players = 11, .n_cards = 20}), std::invalid_argument);
+   EXPECT_THROW(general::State({.n_players = 4, .n_cards = 3}), std::invalid_argument);
+   general::State state{};
+   EXPECT_THROW(state.apply_action(Action::bet), std::logic_error);
+   EXPECT_THROW(state.apply_action(general::ChanceOutcome{Player::two, 0}), std::logic_error);
+   state.apply_action(general::ChanceOutcome{Player::one, 0});
+   EXPECT_THROW(state.apply_action(general::ChanceOutcome{Player::two, 0}), std::logic_error);
+   EXPECT_EQ(state.chance_probability({Player::two, 1}), .5);
+}
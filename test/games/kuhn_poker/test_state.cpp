@@ -30,12 +30,9 @@ TEST_F(KuhnPokerState, apply_action)
    state.apply_action(Action::bet);
    EXPECT_EQ(state.history().size(), 3);
    EXPECT_EQ(state.history()[2], Action::bet);
-   state.apply_action(Action::check);
-   EXPECT_EQ(state.history().size(), 4);
-   EXPECT_EQ(state.history()[3], Action::check);
-   state.apply_action(Action::check);
-   EXPECT_EQ(state.history().size(), 5);
-   EXPECT_EQ(state.history()[4], Action::check);
+   EXPECT_TRUE(state.is_terminal());
+   EXPECT_THROW(state.apply_action(Action::check), std::logic_error);
+   EXPECT_EQ(state.history().size(), 3);
 }
 
 TEST_F(KuhnPokerState, is_valid_chance_action)
@@ -103,6 +100,11 @@ TEST_F(KuhnPokerState, actions)
    EXPECT_TRUE(state.actions().empty());
    state.apply_action(ChanceOutcome{Player::two, Card::jack});
    EXPECT_TRUE(cmp_equal_rngs(state.actions(), std::vector{Action::check, Action::bet}));
+   state.apply_action(Action::check);
+   state.apply_action(Action::check);
+   ASSERT_TRUE(state.is_terminal());
+   EXPECT_FALSE(state.is_valid(Action::check));
+   EXPECT_TRUE(state.actions().empty());
 }
 
 TEST_P(TerminalParamsF, terminal_situations)
@@ -116,6 +118,9 @@ TEST_P(TerminalParamsF, terminal_situations)
       state.apply_action(action);
    }
    EXPECT_EQ(state.is_terminal(), expected_terminal);
+   if(expected_terminal) {
+      EXPECT_TRUE(state.actions().empty());
+   }
 }
 
 INSTANTIATE_TEST_SUITE_P(
@@ -195,3 +200,39 @@ INSTANTIATE_TEST_SUITE_P(
          std::array{-1, 1}}
    )
 );
+
+TEST(KuhnPokerState_constexpr, play_at_compile_time)
+{
+   constexpr auto play = [](Card card_one, Card card_two, std::initializer_list< Action > actions) {
+      State state{};
+      state.apply_action(ChanceOutcome{Player::one, card_one});
+      state.apply_action(ChanceOutcome{Player::two, card_two});
+      for(auto action : actions) {
+         state.apply_action(action);
+      }
+      return state;
+   };
+   static_assert(sizeof(State) <= 4);
+   static_assert(play(Card::king, Card::jack, {Action::check, Action::check}).is_terminal());
+   static_assert(not play(Card::king, Card::jack, {Action::check, Action::bet}).is_terminal());
+   static_assert(play(Card::king, Card::jack, {Action::bet, Action::bet}).payoff(Player::one) == 2);
+   static_assert(
+      play(Card::jack, Card::king, {Action::check, Action::bet, Action::check}).payoff(Player::two)
+      == 1
+   );
+   static_assert(play(Card::jack, Card::king, {Action::bet}).active_player() == Player::two);
+   // actions beyond the end of the game are rejected
+   auto folded = play(Card::jack, Card::king, {Action::bet, Action::check});
+   EXPECT_THROW(folded.apply_action(Action::check), std::logic_error);
+   // the card pool is not restricted to jack, queen and king
+   constexpr State wide_pool{Card::two, Card::ten, Card::ace, Card::king};
+   static_assert(wide_pool.chance_probability({Player::one, Card::two}) == 1. / 4.);
+   EXPECT_EQ(
+      wide_pool.chance_actions(),
+      (std::vector< ChanceOutcome >{
+         {Player::one, Card::two},
+         {Player::one, Card::ten},
+         {Player::one, Card::king},
+         {Player::one, Card::ace}})
+   );
+}
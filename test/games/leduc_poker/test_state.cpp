@@ -195,6 +195,20 @@ TEST_F(LeducPokerState, is_valid_action)
    EXPECT_TRUE(state.is_valid(ActionType::fold));
 }
 
+TEST(LeducPokerState_fractional_bets, is_valid_matches_computed_bet_sizes)
+{
+   leduc::State state{leduc::LeducConfig{2, Player::one, 2, 1., {.3}, {.6}}};
+   state.apply_action(Rank::king, Suit::diamonds);
+   state.apply_action(Rank::jack, Suit::diamonds);
+   // a bet size that is computed rather than taken from the config differs in the last bit
+   double computed_bet = .1 + .2;
+   ASSERT_NE(computed_bet, .3);
+   EXPECT_TRUE(state.is_valid(ActionType::bet, computed_bet));
+   EXPECT_FALSE(state.is_valid(ActionType::bet, .31));
+   state.apply_action(ActionType::bet, computed_bet);
+   EXPECT_EQ(state.history().back(), (Action{ActionType::bet, .3}));
+}
+
 TEST_F(LeducPokerState, valid_chance_actions)
 {
    EXPECT_TRUE(cmp_equal_rngs(
@@ -722,3 +736,34 @@ INSTANTIATE_TEST_SUITE_P(
          std::vector{-11., 33., -11., -11.}}
    )
 );
+
+TEST_F(LeducPokerState, copies_share_the_config)
+{
+   state.apply_action(Rank::king, Suit::diamonds);
+   state.apply_action(Rank::jack, Suit::diamonds);
+   state.apply_action(ActionType::bet, 2.);
+   auto copy = state;
+   EXPECT_EQ(&copy.config(), &state.config());
+   copy.apply_action(ActionType::fold);
+   EXPECT_TRUE(copy.is_terminal());
+   EXPECT_FALSE(state.is_terminal());
+   EXPECT_EQ(state.history(), std::vector< Action >{Action(ActionType::bet, 2.)});
+   EXPECT_EQ(copy.history_size(), 2);
+   // bet sizes that the config does not offer cannot be applied
+   EXPECT_THROW(state.apply_action(ActionType::bet, 3.), std::invalid_argument);
+   EXPECT_EQ(state.history_size(), 1);
+}
+
+TEST_F(LeducPokerState, payoff_into_caller_storage)
+{
+   state.apply_action(Rank::king, Suit::diamonds);
+   state.apply_action(Rank::jack, Suit::diamonds);
+   state.apply_action(ActionType::bet, 2.);
+   state.apply_action(ActionType::fold);
+   std::array< double, 2 > payoffs{};
+   state.payoff(payoffs);
+   EXPECT_EQ(payoffs, (std::array< double, 2 >{1., -1.}));
+   EXPECT_EQ(state.payoff(Player::two), -1.);
+   std::array< double, 1 > too_small{};
+   EXPECT_THROW(state.payoff(too_small), std::invalid_argument);
+}
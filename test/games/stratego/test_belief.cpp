@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "fixtures.hpp"
+#include "testing_utils.hpp"
+
+using namespace stratego;
+
+class StrategoBeliefs: public StrategoState5x5 {
+  public:
+   /// moves revealing the red marshall, killing a red scout and moving another one two squares
+   std::vector< Move > moves{
+      {{1, 4}, {2, 4}},
+      {{3, 4}, {2, 4}},
+      {{1, 1}, {2, 1}},
+      {{3, 0}, {2, 0}},
+      {{2, 1}, {2, 0}},
+      {{3, 1}, {1, 1}}};
+
+   std::vector< BeliefTracker::token_set > candidates(const BeliefTracker& beliefs)
+   {
+      std::vector< BeliefTracker::token_set > sets;
+      for(const auto& piece_opt : state.board()) {
+         if(piece_opt.has_value()) {
+            sets.emplace_back(beliefs.candidates(piece_opt->position()).value_or(0));
+         }
+      }
+      return sets;
+   }
+};
+
+TEST_F(StrategoBeliefs, tracks_moves_fights_and_counts)
+{
+   BeliefTracker beliefs{state, Team::BLUE};
+   auto all_red_tokens = BeliefTracker::bit(Token::flag) | BeliefTracker::bit(Token::spy)
+                         | BeliefTracker::bit(Token::scout) | BeliefTracker::bit(Token::miner)
+                         | BeliefTracker::bit(Token::marshall) | BeliefTracker::bit(Token::bomb);
+   EXPECT_EQ(beliefs.candidates({3, 4}), all_red_tokens);
+   EXPECT_EQ(beliefs.candidates({1, 1}), std::nullopt);
+   EXPECT_EQ(beliefs.alive(Token::scout), 3);
+
+   for(const auto& move : moves) {
+      state.transition(move);
+      beliefs.update(state);
+   }
+   EXPECT_EQ(beliefs.candidates({2, 4}), BeliefTracker::bit(Token::marshall));
+   EXPECT_EQ(beliefs.candidates({2, 0}), std::nullopt);
+   EXPECT_EQ(beliefs.alive(Token::scout), 2);
+   // only a scout moves two squares
+   EXPECT_EQ(beliefs.candidates({1, 1}), BeliefTracker::bit(Token::scout));
+   // the revealed marshall is the only one
+   auto unmoved = beliefs.candidates({4, 4}).value();
+   EXPECT_FALSE(unmoved & BeliefTracker::bit(Token::marshall));
+   EXPECT_TRUE(unmoved & BeliefTracker::bit(Token::flag));
+
+   // the incremental beliefs equal those built from the history at once
+   EXPECT_EQ(candidates(beliefs), candidates(BeliefTracker{state, Team::BLUE}));
+
+   // undone moves rebuild the beliefs
+   state.undo_last_rounds(2);
+   beliefs.update(state);
+   EXPECT_EQ(candidates(beliefs), candidates(BeliefTracker{state, Team::BLUE}));
+   EXPECT_EQ(beliefs.alive(Token::scout), 3);
+}
+
+TEST_F(StrategoBeliefs, determinizations_follow_the_beliefs)
+{
+   for(const auto& move : moves) {
+      state.transition(move);
+   }
+   BeliefTracker beliefs{state, Team::BLUE};
+   common::RNG rng{0};
+   std::set< Token > tokens_of_unmoved_piece;
+   for(int i = 0; i < 100; i++) {
+      auto world = state;
+      beliefs.determinize_into(world, rng);
+      EXPECT_EQ(world.observed_board_hash(Team::BLUE), state.observed_board_hash(Team::BLUE));
+      EXPECT_EQ(world.infostate_hash(Team::BLUE), state.infostate_hash(Team::BLUE));
+      EXPECT_EQ(world.board()[Position{2, 4}]->token(), Token::marshall);
+      EXPECT_EQ(world.board()[Position{1, 1}]->token(), Token::scout);
+      EXPECT_TRUE(world.board()[Position{1, 1}]->flag_hidden());
+      for(const auto& piece_opt : world.board()) {
+         if(piece_opt.has_value() and piece_opt->team() == Team::RED) {
+            auto token_bit = BeliefTracker::bit(piece_opt->token());
+            EXPECT_TRUE(*beliefs.candidates(piece_opt->position()) & token_bit);
+         }
+      }
+      EXPECT_EQ(world.graveyard(), state.graveyard());
+      tokens_of_unmoved_piece.emplace(world.board()[Position{4, 4}]->token());
+   }
+   EXPECT_GT(tokens_of_unmoved_piece.size(), 1);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "fixtures.hpp"
+#include "testing_utils.hpp"
+
+using namespace stratego;
+
+TEST(Bitboard, set_operations)
+{
+   Bitboard board;
+   board.set(3);
+   board.set(64);
+   board.set(99);
+   EXPECT_EQ(board.count(), 3);
+   EXPECT_EQ(board.lowest(), 3);
+   EXPECT_EQ(board.highest(), 99);
+   // shifts carry bits across the two words and drop those leaving the board
+   EXPECT_EQ(board << 61, Bitboard::square(64) | Bitboard::square(125));
+   EXPECT_EQ(board >> 4, Bitboard::square(60) | Bitboard::square(95));
+   EXPECT_EQ(Bitboard::below(100).count(), 100);
+   EXPECT_EQ(Bitboard::below(100) & board, board);
+   EXPECT_EQ(board.pop_lowest(), 3);
+   EXPECT_EQ(board.pop_lowest(), 64);
+   EXPECT_EQ(board.pop_lowest(), 99);
+   EXPECT_TRUE(board.none());
+}
+
+TEST(MoveTables, rays_stop_at_the_first_blocker)
+{
+   using Direction = MoveTables::Direction;
+   MoveTables tables{{5, 5}, compile_move_distances({5, 5}, default_move_ranges())};
+   auto square = [&](Position2D pos) { return Bitboard::square(tables.index(pos)); };
+   auto from = tables.index({2, 0});
+   auto occupied = square({2, 3});
+
+   EXPECT_EQ(
+      tables.targets(from, Direction::y_up, Token::scout, occupied),
+      square({2, 1}) | square({2, 2}) | square({2, 3})
+   );
+   EXPECT_EQ(
+      tables.targets(from, Direction::x_down, Token::scout, occupied),
+      square({1, 0}) | square({0, 0})
+   );
+   EXPECT_TRUE(tables.targets(from, Direction::y_down, Token::scout, occupied).none());
+   // all other movable tokens walk a single square and flags and bombs not at all
+   EXPECT_EQ(tables.targets(from, Direction::y_up, Token::miner, occupied), square({2, 1}));
+   EXPECT_EQ(tables.targets(from, Direction::x_up, Token::marshall, occupied), square({3, 0}));
+   EXPECT_TRUE(tables.targets(from, Direction::y_up, Token::bomb, occupied).none());
+
+   // ranges with gaps are honoured as well
+   auto move_ranges = default_move_ranges();
+   move_ranges[Token::miner] = [](size_t distance) { return distance == 2; };
+   MoveTables gapped_tables{{5, 5}, compile_move_distances({5, 5}, move_ranges)};
+   EXPECT_EQ(gapped_tables.targets(from, Direction::y_up, Token::miner, {}), square({2, 2}));
+
+   EXPECT_THROW(
+      (MoveTables{{12, 12}, compile_move_distances({12, 12}, default_move_ranges())}),
+      std::invalid_argument
+   );
+}
+
+TEST_F(StrategoState5x5, bitboard_moves_agree_with_is_valid)
+{
+   std::mt19937_64 rng{0};
+   for(size_t turn = 0; turn < 200 and state.status() == Status::ONGOING; turn++) {
+      // the incrementally updated bitboards equal the ones built from the board
+      auto rebuilt = state;
+      rebuilt.sync_board();
+      ASSERT_EQ(rebuilt.bitboards(), state.bitboards());
+
+      for(auto team : {Team::BLUE, Team::RED}) {
+         auto actions = state.logic()->valid_actions(state, team);
+         size_t n_valid = 0;
+         for(int x0 = 0; x0 < 5; x0++) {
+            for(int y0 = 0; y0 < 5; y0++) {
+               for(int x1 = 0; x1 < 5; x1++) {
+                  for(int y1 = 0; y1 < 5; y1++) {
+                     Action action{team, {{x0, y0}, {x1, y1}}};
+                     if(state.logic()->is_valid(state, action, team)) {
+                        n_valid++;
+                        EXPECT_NE(std::ranges::find(actions, action), actions.end());
+                     }
+                  }
+               }
+            }
+         }
+         EXPECT_EQ(n_valid, actions.size());
+         // the board scan finds the same moves as the bitboards
+         EXPECT_TRUE(std::ranges::is_permutation(
+            state.logic()->scan_valid_actions(state, team), actions
+         ));
+         EXPECT_EQ(state.logic()->has_valid_actions(state, team), n_valid > 0);
+      }
+      auto actions = state.logic()->valid_actions(state, state.active_team());
+      auto action = actions[std::uniform_int_distribution< size_t >(0, actions.size() - 1)(rng)];
+
+      // undoing a move restores the bitboards too
+      auto before = state;
+      state.transition(action);
+      state.undo_last_rounds();
+      ASSERT_EQ(state.bitboards(), before.bitboards());
+      state = before;
+
+      state.transition(action);
+   }
+}
@@ -46,7 +46,7 @@ TEST(Config, constructor_with_setup)
    EXPECT_EQ(config.setups[Team::RED].value(), setup1);
 
    EXPECT_EQ(
-      config.token_counters[Team::BLUE],
+      config.token_counters().at(Team::BLUE),
       (std::map< Token, unsigned int >{
          {Token::flag, 1},
          {Token::spy, 1},
@@ -56,7 +56,7 @@ TEST(Config, constructor_with_setup)
          {Token::bomb, 2}})
    );
    EXPECT_EQ(
-      config.token_counters[Team::RED],
+      config.token_counters().at(Team::RED),
       (std::map< Token, unsigned int >{
          {Token::flag, 1},
          {Token::spy, 1},
@@ -67,12 +67,12 @@ TEST(Config, constructor_with_setup)
    );
 
    EXPECT_EQ(
-      config.start_fields[Team::BLUE],
+      config.start_fields().at(Team::BLUE),
       (std::vector< Position2D >{
          {0, 0}, {0, 1}, {0, 2}, {0, 3}, {0, 4}, {1, 0}, {1, 1}, {1, 2}, {1, 3}, {1, 4}})
    );
    EXPECT_EQ(
-      config.start_fields[Team::RED],
+      config.start_fields().at(Team::RED),
       (std::vector< Position2D >{
          {3, 0}, {3, 1}, {3, 2}, {3, 3}, {3, 4}, {4, 0}, {4, 1}, {4, 2}, {4, 3}, {4, 4}})
    );
@@ -130,6 +130,44 @@ INSTANTIATE_TEST_SUITE_P(
    )
 );
 
+TEST(Config, compiled_fight_and_move_range_tables)
+{
+   auto move_ranges = default_move_ranges();
+   move_ranges[Token::miner] = [](size_t distance) { return distance == 1 or distance == 3; };
+   auto tokens = std::map{
+      std::pair{Team::BLUE, std::optional< Config::token_variant_t >{std::vector{Token::flag}}},
+      std::pair{Team::RED, std::optional< Config::token_variant_t >{std::vector{Token::flag}}}};
+   auto start_fields = std::map{
+      std::pair{Team::BLUE, std::optional{std::vector< Position2D >{{0, 0}}}},
+      std::pair{Team::RED, std::optional{std::vector< Position2D >{{4, 4}}}}};
+   Config config{
+      Team::BLUE,
+      size_t(5),
+      std::vector< Position2D >{},
+      tokens,
+      start_fields,
+      true,
+      false,
+      500,
+      default_battlematrix(),
+      move_ranges};
+   // the dense fight table agrees with the battle matrix everywhere
+   for(const auto& [att_def, outcome] : config.battle_matrix()) {
+      EXPECT_EQ(config.fight_outcome(att_def.first, att_def.second), outcome);
+   }
+   EXPECT_THROW(config.fight_outcome(Token::flag, Token::bomb), std::out_of_range);
+   // and so do the move range tables with the predicates
+   for(const auto& [token, in_range] : config.move_ranges()) {
+      for(size_t distance = 0; distance < 5; distance++) {
+         EXPECT_EQ(config.in_move_range(token, distance), in_range(distance));
+      }
+   }
+   EXPECT_EQ(config.max_move_ranges()[size_t(Token::scout)], 4);
+   EXPECT_EQ(config.max_move_ranges()[size_t(Token::miner)], 3);
+   EXPECT_FALSE(config.full_move_ranges()[size_t(Token::miner)]);
+   EXPECT_EQ(config.max_move_ranges()[size_t(Token::bomb)], 0);
+}
+
 TEST(Config, constructor_custom_dims_with_setup_small)
 {
    std::map< Position2D, Token > setup0;
@@ -156,11 +194,11 @@ TEST(Config, constructor_custom_dims_with_setup_small)
    EXPECT_EQ(config.setups[Team::RED].value(), setup1);
 
    EXPECT_EQ(
-      config.token_counters[Team::BLUE],
+      config.token_counters().at(Team::BLUE),
       (std::map< Token, unsigned int >{{Token::flag, 1}, {Token::scout, 1}})
    );
    EXPECT_EQ(
-      config.token_counters[Team::RED],
+      config.token_counters().at(Team::RED),
       (std::map< Token, unsigned int >{{Token::miner, 1}, {Token::spy, 1}})
    );
 
@@ -172,13 +210,13 @@ TEST(Config, constructor_custom_dims_with_setup_small)
       }
    };
    EXPECT_TRUE(cmp_equal_rngs(
-      config.start_fields[Team::BLUE],
+      config.start_fields().at(Team::BLUE),
       std::vector< Position2D >{{0, 0}, {1, 1}},
       pos_comparator,
       pos_comparator
    ));
    EXPECT_TRUE(cmp_equal_rngs(
-      config.start_fields[Team::RED],
+      config.start_fields().at(Team::RED),
       std::vector< Position2D >{{1, 0}, {0, 1}},
       pos_comparator,
       pos_comparator
@@ -219,12 +257,12 @@ TEST(Config, constructor_custom_dims_with_setup_medium)
    EXPECT_EQ(config.setups[Team::RED].value(), setup1);
 
    EXPECT_EQ(
-      config.token_counters[Team::BLUE],
+      config.token_counters().at(Team::BLUE),
       (std::map< Token, unsigned int >{
          {Token::flag, 1}, {Token::spy, 1}, {Token::scout, 2}, {Token::miner, 1}})
    );
    EXPECT_EQ(
-      config.token_counters[Team::RED],
+      config.token_counters().at(Team::RED),
       (std::map< Token, unsigned int >{{Token::flag, 1}, {Token::spy, 3}, {Token::marshall, 1}})
    );
 
@@ -236,13 +274,13 @@ TEST(Config, constructor_custom_dims_with_setup_medium)
       }
    };
    EXPECT_TRUE(cmp_equal_rngs(
-      config.start_fields[Team::BLUE],
+      config.start_fields().at(Team::BLUE),
       std::vector< Position2D >{{0, 0}, {0, 1}, {0, 2}, {1, 3}, {2, 4}},
       pos_comparator,
       pos_comparator
    ));
    EXPECT_TRUE(cmp_equal_rngs(
-      config.start_fields[Team::RED],
+      config.start_fields().at(Team::RED),
       std::vector< Position2D >{{3, 0}, {2, 1}, {1, 2}, {3, 3}, {3, 4}},
       pos_comparator,
       pos_comparator
@@ -295,10 +333,10 @@ TEST(Config, constructor_custom_dims_no_setup)
       500};
 
    EXPECT_EQ(
-      config.token_counters[Team::BLUE], (std::map< Token, unsigned int >{{Token::miner, 3}})
+      config.token_counters().at(Team::BLUE), (std::map< Token, unsigned int >{{Token::miner, 3}})
    );
    EXPECT_EQ(
-      config.token_counters[Team::RED],
+      config.token_counters().at(Team::RED),
       (std::map< Token, unsigned int >{{Token::major, 1}, {Token::lieutenant, 4}})
    );
 
@@ -310,9 +348,9 @@ TEST(Config, constructor_custom_dims_no_setup)
       }
    };
    EXPECT_TRUE(
-      cmp_equal_rngs(config.start_fields[Team::BLUE], pos_blue, pos_comparator, pos_comparator)
+      cmp_equal_rngs(config.start_fields().at(Team::BLUE), pos_blue, pos_comparator, pos_comparator)
    );
    EXPECT_TRUE(
-      cmp_equal_rngs(config.start_fields[Team::RED], pos_red, pos_comparator, pos_comparator)
+      cmp_equal_rngs(config.start_fields().at(Team::RED), pos_red, pos_comparator, pos_comparator)
    );
 }
@@ -1,9 +1,11 @@
 
 #include <gtest/gtest.h>
 
+#include <sstream>
 #include <utility>
 
 #include "fixtures.hpp"
+#include "stratego/arena.h"
 #include "testing_utils.hpp"
 
 using namespace stratego;
@@ -75,3 +77,83 @@ TEST_F(StrategoState5x5, run_game_fixed_actions)
    //   EXPECT_EQ(game.run(std::make_shared< plotter >()), Status::WIN_BLUE);
    EXPECT_EQ(game.run(nullptr), Status::WIN_BLUE);
 }
+
+TEST_F(StrategoState5x5, random_playouts)
+{
+   auto start = state;
+   RandomPlayout playout{size_t(0)};
+   auto status = playout.run(state);
+   EXPECT_NE(status, Status::ONGOING);
+   // the playout ends the game exactly where the rules do
+   EXPECT_EQ(state.logic()->check_terminal(state), status);
+
+   // rewinding the playout restores the start, including the graveyard
+   state.restore_to_round(0);
+   EXPECT_EQ(state.hash(), start.hash());
+   EXPECT_EQ(state.bitboards(), start.bitboards());
+   EXPECT_EQ(state.graveyard(), start.graveyard());
+   EXPECT_EQ(state.status(), Status::ONGOING);
+
+   // batches do not depend on the number of threads and replay the single playouts
+   auto outcomes = RandomPlayout::run_batch(start, 200, 7, 4);
+   ASSERT_EQ(outcomes.size(), 200);
+   EXPECT_EQ(outcomes, RandomPlayout::run_batch(start, 200, 7, 1));
+   for(size_t i : {0, 63, 64, 199}) {
+      auto copy = start;
+      EXPECT_EQ(RandomPlayout{7 + i}.run(copy), outcomes[i]);
+   }
+}
+
+TEST_F(SmallConfig, arena_pits_random_agents)
+{
+   auto config = std::make_shared< const Config >(cfg);
+   arena::agent_factory random_agent = [](Team team, unsigned int seed) {
+      return std::make_shared< RandomAgent< State > >(team, seed);
+   };
+   auto results = arena::pit(config, random_agent, random_agent, {.n_games = 40, .n_threads = 4});
+   ASSERT_EQ(results.games.size(), 40);
+   EXPECT_EQ(results.stats.n_games(), 40);
+
+   arena::StatTrack stats;
+   for(const auto& game : results.games) {
+      EXPECT_NE(game.status, Status::ONGOING);
+      EXPECT_EQ(game.team, game.game % 2 == 0 ? Team::BLUE : Team::RED);
+      stats.add(game.status, game.team, game.turns);
+   }
+   EXPECT_EQ(stats, results.stats);
+
+   // the games are seeded independently of the thread they run on
+   auto serial = arena::pit(config, random_agent, random_agent, {.n_games = 40, .n_threads = 1});
+   EXPECT_EQ(serial.games, results.games);
+   EXPECT_EQ(serial.stats, results.stats);
+
+   std::stringstream csv;
+   arena::write_csv(csv, results.games);
+   EXPECT_EQ(std::ranges::count(csv.str(), '\n'), 41);
+
+   // the games are streamed as they finish
+   std::stringstream streamed;
+   arena::pit(
+      config,
+      random_agent,
+      random_agent,
+      {.n_games = 40, .n_threads = 4, .csv_stream = &streamed}
+   );
+   EXPECT_EQ(std::ranges::count(streamed.str(), '\n'), 41);
+}
+
+TEST_F(SmallConfig, arena_rethrows_errors_of_worker_threads)
+{
+   auto config = std::make_shared< const Config >(cfg);
+   arena::agent_factory faulty_agent = [](Team team, unsigned int seed) {
+      // one of the games fails, on whichever thread plays it
+      if(seed == 2 * 37) {
+         throw std::runtime_error("faulty agent");
+      }
+      return std::make_shared< RandomAgent< State > >(team, seed);
+   };
+   EXPECT_THROW(
+      arena::pit(config, faulty_agent, faulty_agent, {.n_games = 40, .n_threads = 4}),
+      std::runtime_error
+   );
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "fixtures.hpp"
+#include "testing_utils.hpp"
+
+using namespace stratego;
+
+TEST_F(StrategoState5x5, determinizations_are_consistent_with_observations)
+{
+   state.transition(Move{{1, 1}, {2, 1}});
+   state.transition(Move{{3, 4}, {2, 4}});
+   state.transition(Move{{2, 1}, {2, 0}});
+   state.transition(Move{{3, 3}, {2, 3}});
+
+   auto hidden_red_tokens = [](State& s) {
+      std::multiset< Token > tokens;
+      for(const auto& piece_opt : s.board()) {
+         if(piece_opt.has_value() and piece_opt->team() == Team::RED and piece_opt->flag_hidden()) {
+            tokens.emplace(piece_opt->token());
+         }
+      }
+      return tokens;
+   };
+   BeliefTracker beliefs{state, Team::BLUE};
+   common::RNG rng{0};
+   std::set< Token > tokens_of_moved_piece;
+   for(int i = 0; i < 50; i++) {
+      auto world = ISMCTSAgent::determinize(state, Team::BLUE, rng);
+      // no piece is dealt a token that its observed moves rule out
+      for(const auto& piece_opt : world.board()) {
+         if(piece_opt.has_value() and piece_opt->team() == Team::RED) {
+            auto candidates = beliefs.candidates(piece_opt->position()).value();
+            EXPECT_TRUE(candidates & BeliefTracker::bit(piece_opt->token()));
+         }
+      }
+      // the opponent's tokens are only dealt anew, so blue cannot tell the worlds apart
+      EXPECT_EQ(hidden_red_tokens(world), hidden_red_tokens(state));
+      EXPECT_EQ(world.observed_board_hash(Team::BLUE), state.observed_board_hash(Team::BLUE));
+      EXPECT_EQ(world.infostate_hash(Team::BLUE), state.infostate_hash(Team::BLUE));
+      // pieces that have moved are neither flags nor bombs
+      for(auto pos : {Position{2, 4}, Position{2, 3}}) {
+         auto token = world.board()[pos]->token();
+         EXPECT_NE(token, Token::flag);
+         EXPECT_NE(token, Token::bomb);
+      }
+      tokens_of_moved_piece.emplace(world.board()[Position{2, 4}]->token());
+   }
+   EXPECT_GT(tokens_of_moved_piece.size(), 1);
+}
+
+TEST_F(StrategoState5x5, ismcts_agent_decides_and_reuses_its_trees)
+{
+   ISMCTSConfig config{
+      .time_budget = std::nullopt, .max_iterations = 300, .n_threads = 2, .seed = 3};
+   ISMCTSAgent agent{Team::BLUE, config};
+   auto actions = state.logic()->valid_actions(state, Team::BLUE);
+   auto action = agent.decide_action(state, actions);
+   EXPECT_NE(std::ranges::find(actions, action), actions.end());
+   EXPECT_EQ(agent.root(0)->visits, 300);
+   EXPECT_EQ(agent.root(1)->visits, 300);
+
+   // the search is deterministic for a given seed
+   ISMCTSAgent twin{Team::BLUE, config};
+   EXPECT_EQ(twin.decide_action(state, actions), action);
+
+   // red replies with the move that blue's tree explored the most
+   const auto* node = agent.root(0)->child(action);
+   ASSERT_NE(node, nullptr);
+   ASSERT_FALSE(node->children.empty());
+   const auto& reply = *std::ranges::max_element(node->children, {}, [](const auto& child) {
+      return child->visits;
+   });
+   state.transition(action);
+   state.transition(*reply->action);
+
+   // the next search continues on the subtree of the two moves
+   auto inherited_visits = reply->visits;
+   agent.decide_action(state, state.logic()->valid_actions(state, Team::BLUE));
+   EXPECT_EQ(agent.root(0)->visits, inherited_visits + 300);
+
+   EXPECT_THROW(
+      (ISMCTSAgent{Team::RED, {.time_budget = std::nullopt, .max_iterations = 0}}),
+      std::invalid_argument
+   );
+}
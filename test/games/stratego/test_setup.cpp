@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "fixtures.hpp"
+#include "testing_utils.hpp"
+
+using namespace stratego;
+
+TEST(SetupSpace, ranks_and_unranks_every_setup)
+{
+   SetupSpace space{
+      {{1, 2}, {0, 0}, {0, 1}, {0, 2}, {1, 0}, {1, 1}},
+      {{Token::flag, 1}, {Token::bomb, 2}, {Token::scout, 3}}};
+   // 6! / (1! 2! 3!)
+   ASSERT_EQ(space.size(), SetupIndex(60));
+   EXPECT_EQ(space.fields().front(), (Position2D{0, 0}));
+
+   std::vector< Token > setup(space.n_pieces());
+   std::set< std::vector< Token > > seen;
+   for(uint64_t index = 0; index < 60; index++) {
+      space.unrank(index, setup);
+      ASSERT_EQ(space.rank(setup), SetupIndex(index));
+      ASSERT_EQ(space.rank(space.to_map(setup)), SetupIndex(index));
+      seen.emplace(setup);
+   }
+   EXPECT_EQ(seen.size(), 60);
+   space.unrank(0, setup);
+   EXPECT_EQ(setup, space.tokens());
+
+   EXPECT_THROW(space.unrank(60, setup), std::out_of_range);
+   setup[0] = Token::marshall;
+   EXPECT_THROW(static_cast< void >(space.rank(setup)), std::invalid_argument);
+}
+
+TEST(SetupSpace, indexes_the_full_game_beyond_64_bits)
+{
+   std::vector< Position2D > fields;
+   for(int row = 0; row < 4; row++) {
+      for(int col = 0; col < 10; col++) {
+         fields.emplace_back(Position2D{row, col});
+      }
+   }
+   SetupSpace space{fields, default_token_sets(10)};
+   ASSERT_EQ(space.n_pieces(), 40);
+   EXPECT_GT(space.size(), SetupIndex(1, 0));
+
+   common::RNG rng{0};
+   std::vector< Token > setup(space.n_pieces());
+   std::vector< Token > unranked(space.n_pieces());
+   for(int i = 0; i < 100; i++) {
+      space.sample(rng, setup);
+      space.unrank(space.rank(setup), unranked);
+      ASSERT_EQ(unranked, setup);
+   }
+   auto last = space.size() - 1;
+   space.unrank(last, setup);
+   EXPECT_EQ(space.rank(setup), last);
+   // the last setup is the token multiset in descending order
+   EXPECT_TRUE(std::ranges::is_sorted(setup, std::greater{}));
+}
+
+TEST(SetupSampler, samples_the_flag_on_the_back_row_behind_bombs)
+{
+   std::vector< Position2D > fields;
+   for(int row = 0; row < 4; row++) {
+      for(int col = 0; col < 10; col++) {
+         fields.emplace_back(Position2D{row, col});
+      }
+   }
+   SetupSpace space{fields, default_token_sets(10)};
+   SetupSampler sampler{space, SetupConstraints::flag_on_back_row(space, Team::BLUE)};
+
+   common::RNG rng{0};
+   std::vector< Token > setup(space.n_pieces());
+   std::set< size_t > flag_fields;
+   for(int i = 0; i < 500; i++) {
+      sampler.sample(rng, setup);
+      auto flag = size_t(std::ranges::find(setup, Token::flag) - setup.begin());
+      ASSERT_LT(flag, 10);
+      flag_fields.emplace(flag);
+      if(flag % 10 > 0) {
+         EXPECT_EQ(setup[flag - 1], Token::bomb);
+      }
+      if(flag % 10 < 9) {
+         EXPECT_EQ(setup[flag + 1], Token::bomb);
+      }
+      EXPECT_EQ(setup[flag + 10], Token::bomb);
+      // the sampled setup is a permutation of the token multiset
+      ASSERT_NO_THROW(static_cast< void >(space.rank(setup)));
+   }
+   EXPECT_EQ(flag_fields.size(), 10);
+}
+
+TEST(SetupSampler, samples_constrained_setups_uniformly)
+{
+   SetupSpace space{
+      {{0, 0}, {0, 1}, {0, 2}, {1, 0}, {1, 1}, {1, 2}},
+      {{Token::flag, 1}, {Token::bomb, 2}, {Token::spy, 1}, {Token::scout, 2}}};
+   // the flag fits into the corners of the back row only, each with 3!/2! completions
+   SetupSampler sampler{space, SetupConstraints::flag_on_back_row(space, Team::BLUE)};
+
+   common::RNG rng{0};
+   std::vector< Token > setup(space.n_pieces());
+   std::map< SetupIndex, int > counts;
+   constexpr int n_samples = 12000;
+   for(int i = 0; i < n_samples; i++) {
+      sampler.sample(rng, setup);
+      counts[space.rank(setup)]++;
+   }
+   ASSERT_EQ(counts.size(), 6);
+   for(const auto& [index, count] : counts) {
+      EXPECT_NEAR(count, n_samples / 6, n_samples / 60);
+   }
+
+   SetupSpace flagless{{{0, 0}}, {{Token::spy, 1}}};
+   EXPECT_THROW((SetupSampler{flagless, {}}), std::invalid_argument);
+}
+
+TEST_F(SmallConfig, config_holds_the_setup_spaces)
+{
+   for(auto team : {Team::BLUE, Team::RED}) {
+      const auto& space = *cfg.setup_spaces().at(team);
+      EXPECT_EQ(space.n_pieces(), cfg.start_fields().at(team).size());
+      // the fixed setups of the fixture lie in their space
+      const auto& setup = cfg.setups.at(team).value();
+      auto index = space.rank(setup);
+      std::vector< Token > tokens(space.n_pieces());
+      space.unrank(index, tokens);
+      EXPECT_EQ(space.to_map(tokens), setup);
+   }
+}
+
+TEST(SetupIndex, scaled_throws_once_the_product_overflows)
+{
+   SetupIndex index{uint64_t(1) << 62, 0};
+   EXPECT_EQ(index.scaled(2, 2), index);
+   EXPECT_EQ(SetupIndex(3).scaled(4, 6), SetupIndex(2));
+   // the quotient would fit into 128 bits, but the product does not
+   EXPECT_THROW(static_cast< void >(index.scaled(4, 4)), std::overflow_error);
+}
@@ -48,6 +48,31 @@ TEST(State, constructor)
    }
 }
 
+TEST(State, copies_share_the_config)
+{
+   // leave both setups open to have them drawn by the state
+   auto token_set = std::optional< Config::token_variant_t >{std::vector{Token::flag, Token::spy}};
+   auto tokens = std::map{std::pair{Team::BLUE, token_set}, std::pair{Team::RED, token_set}};
+   auto start_fields = std::map{
+      std::pair{Team::BLUE, std::optional{std::vector< Position2D >{{0, 0}, {0, 2}}}},
+      std::pair{Team::RED, std::optional{std::vector< Position2D >{{2, 0}, {2, 2}}}}};
+   State state{
+      Config{
+         Team::BLUE, size_t(3), std::vector< Position2D >{}, tokens, start_fields, true, false, 10},
+      size_t(0)};
+   // the drawn setups are recorded in the config of the game
+   EXPECT_TRUE(state.config().setups.at(Team::BLUE).has_value());
+   EXPECT_TRUE(state.config().setups.at(Team::RED).has_value());
+
+   auto state_copy = state;
+   EXPECT_EQ(state_copy.config_ptr(), state.config_ptr());
+   EXPECT_EQ(state_copy.logic(), state.logic());
+
+   // new games of the same shared config do not copy it either
+   State other_game{state.config_ptr(), size_t(1)};
+   EXPECT_EQ(other_game.config_ptr(), state.config_ptr());
+}
+
 auto get_tokenvector(std::map< Team, std::optional< Config::setup_t > > setups)
 {
    std::map< Team, std::map< Token, unsigned int > > counters;
@@ -107,6 +132,36 @@ std::vector< Position2D > get_hole_pos(const Board& board)
    return out;
 }
 
+TEST_F(StrategoState5x5, history_records_moves_and_fights)
+{
+   state.transition(Move{{1, 1}, {2, 1}});
+   state.transition(Move{{3, 0}, {2, 0}});
+   // the blue marshall attacks the red scout
+   state.transition(Move{{2, 1}, {3, 1}});
+
+   const auto &history = state.history();
+   ASSERT_EQ(history.size(), 3);
+   EXPECT_EQ(ranges::to_vector(history.turns()), (std::vector< size_t >{0, 1, 2}));
+   EXPECT_EQ(ranges::distance(history.view_team_history(Team::BLUE)), 2);
+   EXPECT_EQ(history[1].team, Team::RED);
+   EXPECT_EQ(history[1].action, (Action{Team::RED, {{3, 0}, {2, 0}}}));
+   EXPECT_FALSE(history[1].defender.has_value());
+   EXPECT_FALSE(history[1].fight_outcome.has_value());
+
+   const auto &fight = history.last();
+   EXPECT_EQ(fight.attacker, (Piece{Team::BLUE, {2, 1}, Token::marshall}));
+   EXPECT_EQ(fight.defender, (Piece{Team::RED, {3, 1}, Token::scout}));
+   EXPECT_EQ(fight.fight_outcome, FightOutcome::kill);
+   EXPECT_THROW(static_cast< void >(history[3]), std::out_of_range);
+
+   // undoing the fight restores both pieces as they were before it
+   auto record = fight;
+   state.undo_last_rounds();
+   EXPECT_EQ(state.history().size(), 2);
+   EXPECT_EQ(state.board()[Position{2, 1}], record.attacker);
+   EXPECT_EQ(state.board()[Position{3, 1}], record.defender);
+}
+
 TEST_P(StateConstructorParamsF, constructor_arbitrary_dims)
 {
    auto [game_dims, holes, setups] = GetParam();
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "fixtures.hpp"
+#include "testing_utils.hpp"
+
+using namespace stratego;
+
+TEST_F(StrategoState5x5, incremental_hash_equals_rebuilt_hash)
+{
+   std::mt19937_64 rng{0};
+   for(size_t turn = 0; turn < 200 and state.status() == Status::ONGOING; turn++) {
+      auto rebuilt = state;
+      rebuilt.sync_board();
+      ASSERT_EQ(rebuilt.hash(), state.hash());
+      for(auto team : {Team::BLUE, Team::RED}) {
+         ASSERT_EQ(rebuilt.observed_board_hash(team), state.observed_board_hash(team));
+      }
+      // a state constructed from the board and history folds in the same observed moves
+      State constructed{
+         state.config_ptr(),
+         state.graveyard(),
+         std::make_shared< Logic >(),
+         state.board(),
+         state.turn_count(),
+         state.history()};
+      for(auto team : {Team::BLUE, Team::RED}) {
+         ASSERT_EQ(constructed.infostate_hash(team), state.infostate_hash(team));
+      }
+
+      auto actions = state.logic()->valid_actions(state, state.active_team());
+      auto action = actions[std::uniform_int_distribution< size_t >(0, actions.size() - 1)(rng)];
+
+      // undoing a move restores the hashes
+      auto before = state;
+      state.transition(action);
+      EXPECT_NE(state.hash(), before.hash());
+      state.undo_last_rounds();
+      ASSERT_EQ(state.hash(), before.hash());
+      for(auto team : {Team::BLUE, Team::RED}) {
+         ASSERT_EQ(state.observed_board_hash(team), before.observed_board_hash(team));
+         ASSERT_EQ(state.infostate_hash(team), before.infostate_hash(team));
+      }
+      state = before;
+
+      state.transition(action);
+   }
+}
+
+TEST_F(StrategoState5x5, observed_board_hash_ignores_hidden_opponent_tokens)
+{
+   // swap the tokens of two hidden red pieces, which blue cannot tell apart
+   auto swapped = state;
+   auto board = swapped.board();
+   board[Position{3, 4}] = Piece{Team::RED, {3, 4}, Token::miner};
+   board[Position{4, 0}] = Piece{Team::RED, {4, 0}, Token::marshall};
+   swapped.board(std::move(board));
+
+   EXPECT_EQ(swapped.observed_board_hash(Team::BLUE), state.observed_board_hash(Team::BLUE));
+   EXPECT_NE(swapped.observed_board_hash(Team::RED), state.observed_board_hash(Team::RED));
+   EXPECT_NE(swapped.hash(), state.hash());
+}
+
+TEST_F(StrategoState5x5, infostate_hash_tells_histories_of_the_same_board_apart)
+{
+   // the same two blue moves in either order lead to the same board
+   auto swapped = state;
+   state.transition(Move{{1, 1}, {2, 1}});
+   state.transition(Move{{3, 0}, {2, 0}});
+   state.transition(Move{{1, 4}, {2, 4}});
+   swapped.transition(Move{{1, 4}, {2, 4}});
+   swapped.transition(Move{{3, 0}, {2, 0}});
+   swapped.transition(Move{{1, 1}, {2, 1}});
+   ASSERT_EQ(swapped.hash(), state.hash());
+   for(auto team : {Team::BLUE, Team::RED}) {
+      EXPECT_EQ(swapped.observed_board_hash(team), state.observed_board_hash(team));
+      EXPECT_NE(swapped.infostate_hash(team), state.infostate_hash(team));
+   }
+
+   // moving pieces back and forth reveals that they are movable, even though the board repeats
+   auto start = state;
+   state.transition(Move{{2, 0}, {3, 0}});
+   state.transition(Move{{2, 1}, {1, 1}});
+   state.transition(Move{{3, 0}, {2, 0}});
+   state.transition(Move{{1, 1}, {2, 1}});
+   ASSERT_EQ(state.repetitions(), 1);
+   for(auto team : {Team::BLUE, Team::RED}) {
+      EXPECT_EQ(start.observed_board_hash(team), state.observed_board_hash(team));
+      EXPECT_NE(start.infostate_hash(team), state.infostate_hash(team));
+   }
+}
+
+TEST_F(StrategoState5x5, infostate_hash_covers_revealed_tokens)
+{
+   state.transition(Move{{1, 1}, {2, 1}});
+   state.transition(Move{{3, 3}, {2, 3}});
+   // a world in which the hidden red scout and miner swapped places, which blue cannot tell apart
+   auto swapped = state;
+   auto board = swapped.board();
+   board[Position{3, 1}] = Piece{Team::RED, {3, 1}, Token::miner};
+   board[Position{4, 0}] = Piece{Team::RED, {4, 0}, Token::scout};
+   swapped.board(std::move(board));
+   ASSERT_EQ(swapped.infostate_hash(Team::BLUE), state.infostate_hash(Team::BLUE));
+
+   // the blue marshall kills the piece either way, but the fight reveals which one it was
+   auto before_fight = state;
+   state.transition(Move{{2, 1}, {3, 1}});
+   swapped.transition(Move{{2, 1}, {3, 1}});
+   EXPECT_EQ(swapped.observed_board_hash(Team::BLUE), state.observed_board_hash(Team::BLUE));
+   EXPECT_NE(swapped.infostate_hash(Team::BLUE), state.infostate_hash(Team::BLUE));
+
+   state.undo_last_rounds();
+   for(auto team : {Team::BLUE, Team::RED}) {
+      EXPECT_EQ(state.infostate_hash(team), before_fight.infostate_hash(team));
+   }
+}
+
+TEST_F(StrategoState5x5, repetitions_of_positions)
+{
+   EXPECT_EQ(state.repetitions(), 0);
+   state.transition(Move{{1, 1}, {2, 1}});
+   state.transition(Move{{3, 0}, {2, 0}});
+   EXPECT_EQ(state.repetitions(), 0);
+   state.transition(Move{{2, 1}, {1, 1}});
+   state.transition(Move{{2, 0}, {3, 0}});
+   // the starting position with blue to move again
+   EXPECT_EQ(state.repetitions(), 1);
+   state.transition(Move{{1, 1}, {2, 1}});
+   EXPECT_EQ(state.repetitions(), 1);
+   state.undo_last_rounds(3);
+   EXPECT_EQ(state.repetitions(), 0);
+}
@@ -0,0 +1,25 @@
+
+#ifndef NOR_TEXAS_HOLDEM_POKER_FIXTURES_HPP
+#define NOR_TEXAS_HOLDEM_POKER_FIXTURES_HPP
+
+#include <gtest/gtest.h>
+
+#include "texas_holdem_poker/texas_holdem_poker.hpp"
+
+struct LimitHoldemState: public ::testing::Test {
+   texholdem::State state{texholdem::PokerConfig::limit()};
+};
+
+struct NoLimitHoldemState: public ::testing::Test {
+   texholdem::State state{texholdem::PokerConfig::no_limit()};
+};
+
+/// deals the given hole cards (in seat order) to the state
+inline void deal(texholdem::State& state, const std::vector< texholdem::Card >& cards)
+{
+   for(const auto& card : cards) {
+      state.apply_action(card);
+   }
+}
+
+#endif  // NOR_TEXAS_HOLDEM_POKER_FIXTURES_HPP
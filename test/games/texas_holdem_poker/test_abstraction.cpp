@@ -0,0 +1,156 @@
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "texas_holdem_poker/texas_holdem_poker.hpp"
+
+using namespace texholdem;
+
+namespace {
+
+std::vector< uint8_t > ids(std::initializer_list< Card > cards)
+{
+   std::vector< uint8_t > out;
+   for(const auto& card : cards) {
+      out.emplace_back(card.index());
+   }
+   return out;
+}
+
+}  // namespace
+
+TEST(Abstraction, preflop_equities)
+{
+   const auto& indexer = HandIndexer::holdem();
+   BucketingConfig config{.n_rollouts = 1000, .n_opponent_samples = 100, .seed = 3};
+   auto aces = equity_histogram(
+      indexer, ids({{Rank::ace, Suit::spades}, {Rank::ace, Suit::hearts}}), config
+   );
+   auto seven_deuce = equity_histogram(
+      indexer, ids({{Rank::seven, Suit::spades}, {Rank::two, Suit::hearts}}), config
+   );
+   // the known all-in equities against a random hand are 85% and 35%
+   EXPECT_NEAR(mean_equity(aces), .85, .03);
+   EXPECT_NEAR(mean_equity(seven_deuce), .35, .03);
+}
+
+TEST(Abstraction, river_histogram_is_a_single_equity)
+{
+   const auto& indexer = HandIndexer::holdem();
+   BucketingConfig config{.n_histogram_bins = 10};
+   // the royal flush on the board splits the pot against every opponent
+   auto histogram = equity_histogram(
+      indexer,
+      ids({{Rank::two, Suit::clubs},
+           {Rank::three, Suit::diamonds},
+           {Rank::ace, Suit::spades},
+           {Rank::king, Suit::spades},
+           {Rank::queen, Suit::spades},
+           {Rank::jack, Suit::spades},
+           {Rank::ten, Suit::spades}}),
+      config
+   );
+   EXPECT_EQ(histogram, std::vector< float >({0, 0, 0, 0, 0, 1, 0, 0, 0, 0}));
+}
+
+TEST(Abstraction, kmeans_separates_clusters_deterministically)
+{
+   // three groups of points around the equities 0.2, 0.5 and 0.8 on 10 bins
+   constexpr size_t n_bins = 10;
+   std::mt19937_64 rng{0};
+   std::vector< float > histograms;
+   std::vector< size_t > group_of_point;
+   for(size_t p = 0; p < 3000; p++) {
+      size_t group = p % 3;
+      std::vector< float > histogram(n_bins, 0.f);
+      auto center = 1 + 3 * group;
+      auto jitter = std::uniform_int_distribution< size_t >{0, 1}(rng);
+      histogram[center] = .75f;
+      histogram[center + jitter] += .25f;
+      histograms.insert(histograms.end(), histogram.begin(), histogram.end());
+      group_of_point.emplace_back(group);
+   }
+   BucketingConfig config{.n_threads = 1, .seed = 7};
+   auto clustering = emd_kmeans(histograms, n_bins, 3, config);
+   ASSERT_EQ(clustering.assignment.size(), group_of_point.size());
+   for(size_t p = 0; p < group_of_point.size(); p++) {
+      // the clusters are ordered by their equity, so the groups keep their order
+      ASSERT_EQ(clustering.assignment[p], group_of_point[p]);
+   }
+   config.n_threads = 4;
+   EXPECT_EQ(emd_kmeans(histograms, n_bins, 3, config).assignment, clustering.assignment);
+}
+
+TEST(Abstraction, preflop_buckets_order_by_strength)
+{
+   const auto& indexer = HandIndexer::holdem();
+   BucketingConfig config{
+      .n_buckets = {8}, .n_histogram_bins = 20, .n_rollouts = 32, .n_opponent_samples = 32};
+   auto buckets = compute_buckets(indexer, config);
+   ASSERT_EQ(buckets.size(), 1);
+   ASSERT_EQ(buckets[0].size(), 169);
+   auto aces = indexer.index(ids({{Rank::ace, Suit::spades}, {Rank::ace, Suit::hearts}}));
+   auto seven_deuce = indexer.index(ids({{Rank::seven, Suit::spades}, {Rank::two, Suit::hearts}}));
+   EXPECT_EQ(buckets[0][aces], 7);
+   EXPECT_LT(buckets[0][seven_deuce], 3);
+}
+
+TEST(Abstraction, streamed_preflop_buckets_order_by_strength)
+{
+   const auto& indexer = HandIndexer::holdem();
+   // no histogram budget at all forces the mini-batch k-means
+   BucketingConfig config{
+      .n_buckets = {8},
+      .n_histogram_bins = 20,
+      .n_rollouts = 32,
+      .n_opponent_samples = 32,
+      .max_histogram_bytes = 0,
+      .minibatch_size = 64,
+      .n_minibatches = 4};
+   auto buckets = compute_buckets(indexer, config);
+   ASSERT_EQ(buckets.size(), 1);
+   ASSERT_EQ(buckets[0].size(), 169);
+   for(auto bucket : buckets[0]) {
+      ASSERT_LT(bucket, 8);
+   }
+   auto aces = indexer.index(ids({{Rank::ace, Suit::spades}, {Rank::ace, Suit::hearts}}));
+   auto seven_deuce = indexer.index(ids({{Rank::seven, Suit::spades}, {Rank::two, Suit::hearts}}));
+   EXPECT_GT(buckets[0][aces], buckets[0][seven_deuce]);
+   EXPECT_LT(buckets[0][seven_deuce], 3);
+}
+
+TEST(Abstraction, bucket_file_roundtrip)
+{
+   auto path = std::filesystem::temp_directory_path() / "nor_test_buckets.bin";
+   std::vector< std::vector< Bucket > > buckets{{0, 2, 1}, {4, 3, 2, 1, 0}};
+   std::vector< size_t > n_buckets{3, 5};
+   write_bucket_file(path, buckets, n_buckets);
+   {
+      auto map = BucketMap::open(path);
+      ASSERT_EQ(map.n_rounds(), 2);
+      for(size_t round = 0; round < buckets.size(); round++) {
+         EXPECT_EQ(map.n_buckets(round), n_buckets[round]);
+         ASSERT_EQ(map.round_size(round), buckets[round].size());
+         for(size_t index = 0; index < buckets[round].size(); index++) {
+            EXPECT_EQ(map.bucket(round, index), buckets[round][index]);
+         }
+      }
+      auto moved = std::move(map);
+      EXPECT_EQ(moved.bucket(1, 0), 4);
+      EXPECT_THROW((void)moved.bucket(0, 3), std::out_of_range);
+      EXPECT_THROW((void)moved.bucket(2, 0), std::out_of_range);
+   }
+   // a file truncated within the padding of the first round is rejected (the second round takes
+   // 5 buckets and 6 bytes of padding)
+   auto file_size = std::filesystem::file_size(path);
+   std::filesystem::resize_file(path, file_size - 5 * sizeof(Bucket) - 6 - 1);
+   EXPECT_THROW(BucketMap::open(path), std::invalid_argument);
+   // a truncated file is rejected
+   std::filesystem::resize_file(path, 30);
+   EXPECT_THROW(BucketMap::open(path), std::invalid_argument);
+   std::filesystem::remove(path);
+   EXPECT_THROW(BucketMap::open(path), std::invalid_argument);
+}
@@ -0,0 +1,130 @@
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "fixtures.hpp"
+#include "texas_holdem_poker/texas_holdem_poker.hpp"
+
+using namespace texholdem;
+
+namespace {
+
+const std::vector< Card > hole_cards = {
+   {Rank::ace, Suit::spades},
+   {Rank::ace, Suit::hearts},
+   {Rank::king, Suit::spades},
+   {Rank::queen, Suit::hearts}};
+
+}  // namespace
+
+TEST(ActionTranslator, pseudo_harmonic_mapping)
+{
+   ActionTranslator translator{{1., .5, 2.}};
+   EXPECT_EQ(translator.sizes(), (std::vector< double >{.5, 1., 2.}));
+
+   auto exact = translator.translate(1.);
+   EXPECT_EQ(exact.lower, 1);
+   EXPECT_EQ(exact.upper, 1);
+   EXPECT_EQ(exact.lower_probability, 1.);
+
+   auto between = translator.translate(.75);
+   EXPECT_EQ(between.lower, 0);
+   EXPECT_EQ(between.upper, 1);
+   // (B - x)(1 + A) / ((B - A)(1 + x)) = .25 * 1.5 / (.5 * 1.75)
+   EXPECT_NEAR(between.lower_probability, 3. / 7., 1e-12);
+   // the mapping is continuous at the grid sizes
+   EXPECT_NEAR(translator.translate(.5 + 1e-9).lower_probability, 1., 1e-6);
+   EXPECT_NEAR(translator.translate(1. - 1e-9).lower_probability, 0., 1e-6);
+
+   EXPECT_EQ(translator.translate(.1).lower, 0);
+   EXPECT_EQ(translator.translate(10.).upper, 2);
+   EXPECT_EQ(translator.translate(10.).lower_probability, 1.);
+   EXPECT_THROW(ActionTranslator{{}}, std::invalid_argument);
+}
+
+TEST_F(NoLimitHoldemState, abstract_actions)
+{
+   deal(state, hole_cards);
+   // half pot (which is also the min raise), pot and all-in after calling the big blind
+   ActionAbstraction abstraction{{.5, 1.}};
+   auto actions = abstraction.actions(state);
+   EXPECT_EQ(
+      actions,
+      (std::vector< Action >{
+         {ActionType::fold},
+         {ActionType::call},
+         {ActionType::raise, 2.f},
+         {ActionType::raise, 4.f},
+         {ActionType::raise, 198.f}})
+   );
+   for(const auto& action : actions) {
+      EXPECT_TRUE(state.is_valid(action));
+   }
+   // fractions below the minimum raise collapse onto it
+   ActionAbstraction small_bets{{.1, .2, 3.}, false};
+   EXPECT_EQ(
+      small_bets.actions(state),
+      (std::vector< Action >{
+         {ActionType::fold},
+         {ActionType::call},
+         {ActionType::raise, 2.f},
+         {ActionType::raise, 12.f}})
+   );
+}
+
+TEST_F(LimitHoldemState, abstract_actions_of_limit_rounds)
+{
+   deal(state, hole_cards);
+   ActionAbstraction abstraction{{.5, 1., 2.}};
+   EXPECT_EQ(abstraction.actions(state), state.actions());
+}
+
+TEST_F(NoLimitHoldemState, translate_off_tree_raises)
+{
+   deal(state, hole_cards);
+   ActionAbstraction abstraction{{.5, 1.}};
+   // actions in the abstraction and non-raises translate to themselves
+   auto call = abstraction.translate(state, Action{ActionType::call});
+   ASSERT_EQ(call.size(), 1);
+   EXPECT_EQ(call[0].first, Action{ActionType::call});
+   auto pot_raise = abstraction.translate(state, Action{ActionType::raise, 4.f});
+   ASSERT_EQ(pot_raise.size(), 1);
+   EXPECT_EQ(pot_raise[0].first, (Action{ActionType::raise, 4.f}));
+
+   // a raise of 3 is 3/4 of the pot of 4 after calling
+   auto translation = abstraction.translate(state, Action{ActionType::raise, 3.f});
+   ASSERT_EQ(translation.size(), 2);
+   EXPECT_EQ(translation[0].first, (Action{ActionType::raise, 2.f}));
+   EXPECT_EQ(translation[1].first, (Action{ActionType::raise, 4.f}));
+   EXPECT_NEAR(translation[0].second, 3. / 7., 1e-6);
+   EXPECT_NEAR(translation[0].second + translation[1].second, 1., 1e-12);
+
+   // large raises translate between the pot raise and the all-in
+   auto large = abstraction.translate(state, Action{ActionType::raise, 100.f});
+   ASSERT_EQ(large.size(), 2);
+   EXPECT_EQ(large[1].first, (Action{ActionType::raise, 198.f}));
+
+   // fractions clamped onto the same raise translate onto that raise alone
+   ActionAbstraction small_bets{{.1, .2, 3.}, false};
+   auto small_actions = small_bets.actions(state);
+   for(float bet = 2.f; bet <= 198.f; bet += 7.f) {
+      for(auto [abstract_action, probability] :
+          small_bets.translate(state, Action{ActionType::raise, bet})) {
+         EXPECT_NE(
+            std::find(small_actions.begin(), small_actions.end(), abstract_action),
+            small_actions.end()
+         );
+      }
+   }
+   auto min_raise = small_bets.translate(state, Action{ActionType::raise, 2.f});
+   ASSERT_EQ(min_raise.size(), 1);
+   EXPECT_EQ(min_raise[0].first, (Action{ActionType::raise, 2.f}));
+
+   std::mt19937_64 rng{0};
+   size_t n_lower = 0;
+   for(size_t i = 0; i < 7000; i++) {
+      n_lower += abstraction.translate(state, Action{ActionType::raise, 3.f}, rng).bet == 2.f;
+   }
+   EXPECT_NEAR(double(n_lower) / 7000., 3. / 7., .02);
+}
@@ -0,0 +1,118 @@
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <map>
+#include <random>
+
+#include "texas_holdem_poker/texas_holdem_poker.hpp"
+
+using namespace texholdem;
+
+namespace {
+
+std::vector< CardMask > random_hands(size_t n_hands, size_t n_cards, uint64_t seed)
+{
+   std::mt19937_64 rng{seed};
+   auto deck = full_deck();
+   std::vector< CardMask > hands;
+   hands.reserve(n_hands);
+   for(size_t i = 0; i < n_hands; i++) {
+      std::shuffle(deck.begin(), deck.end(), rng);
+      hands.emplace_back(to_mask(std::span{deck}.first(n_cards)));
+   }
+   return hands;
+}
+
+std::vector< Card > to_cards(CardMask mask)
+{
+   std::vector< Card > cards;
+   for(size_t i = 0; i < n_cards; i++) {
+      if(mask & (CardMask(1) << i)) {
+         cards.emplace_back(Card::from_index(i));
+      }
+   }
+   return cards;
+}
+
+}  // namespace
+
+TEST(HandEvaluator, all_five_card_hands_category_counts)
+{
+   const auto& evaluator = HandEvaluator::instance();
+   std::map< HandCategory, size_t > counts;
+   for(size_t a = 0; a < n_cards; a++) {
+      for(size_t b = a + 1; b < n_cards; b++) {
+         for(size_t c = b + 1; c < n_cards; c++) {
+            for(size_t d = c + 1; d < n_cards; d++) {
+               for(size_t e = d + 1; e < n_cards; e++) {
+                  CardMask hand = (CardMask(1) << a) | (CardMask(1) << b) | (CardMask(1) << c)
+                                  | (CardMask(1) << d) | (CardMask(1) << e);
+                  counts[category(evaluator.evaluate(hand))]++;
+               }
+            }
+         }
+      }
+   }
+   EXPECT_EQ(counts[HandCategory::straight_flush], 40);
+   EXPECT_EQ(counts[HandCategory::four_of_a_kind], 624);
+   EXPECT_EQ(counts[HandCategory::full_house], 3744);
+   EXPECT_EQ(counts[HandCategory::flush], 5108);
+   EXPECT_EQ(counts[HandCategory::straight], 10200);
+   EXPECT_EQ(counts[HandCategory::three_of_a_kind], 54912);
+   EXPECT_EQ(counts[HandCategory::two_pair], 123552);
+   EXPECT_EQ(counts[HandCategory::pair], 1098240);
+   EXPECT_EQ(counts[HandCategory::high_card], 1302540);
+}
+
+TEST(HandEvaluator, agrees_with_direct_ranking)
+{
+   const auto& evaluator = HandEvaluator::instance();
+   for(size_t n : {5, 6, 7}) {
+      for(auto hand : random_hands(20000, n, n)) {
+         auto cards = to_cards(hand);
+         ASSERT_EQ(evaluator.evaluate(hand), rank_hand(cards));
+         ASSERT_EQ(evaluator.evaluate(std::span< const Card >{cards}), rank_hand(cards));
+      }
+   }
+}
+
+TEST(HandEvaluator, batch_agrees_with_single)
+{
+   const auto& evaluator = HandEvaluator::instance();
+   // a batch size that is not a multiple of the internal block size
+   auto hands = random_hands(1000, 7, 42);
+   std::vector< HandRank > ranks(hands.size());
+   evaluator.evaluate(hands, ranks);
+   for(size_t i = 0; i < hands.size(); i++) {
+      ASSERT_EQ(ranks[i], evaluator.evaluate(hands[i]));
+   }
+   EXPECT_THROW(
+      evaluator.evaluate(hands, std::span{ranks}.first(10)), std::invalid_argument
+   );
+}
+
+TEST(HandEvaluator, rejects_hands_of_more_than_seven_cards)
+{
+   const auto& evaluator = HandEvaluator::instance();
+   auto hands = random_hands(10, 8, 7);
+   std::vector< HandRank > ranks(hands.size());
+   EXPECT_THROW(static_cast< void >(evaluator.evaluate(hands[0])), std::invalid_argument);
+   EXPECT_THROW(evaluator.evaluate(hands, ranks), std::invalid_argument);
+}
+
+TEST(HandEvaluator, save_and_load_tables)
+{
+   auto path = std::filesystem::temp_directory_path() / "nor_holdem_evaluator_tables.bin";
+   HandEvaluator generated{};
+   ASSERT_TRUE(generated.save(path));
+   auto loaded = HandEvaluator::load(path);
+   ASSERT_TRUE(loaded.has_value());
+   for(auto hand : random_hands(2000, 7, 7)) {
+      ASSERT_EQ(loaded->evaluate(hand), generated.evaluate(hand));
+   }
+   std::filesystem::resize_file(path, 100);
+   EXPECT_FALSE(HandEvaluator::load(path).has_value());
+   std::filesystem::remove(path);
+   EXPECT_FALSE(HandEvaluator::load(path).has_value());
+}
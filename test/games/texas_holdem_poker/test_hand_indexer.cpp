@@ -0,0 +1,138 @@
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+
+#include "texas_holdem_poker/texas_holdem_poker.hpp"
+
+using namespace texholdem;
+
+namespace {
+
+/// applies the suit permutation and shuffles the cards within each round
+std::vector< uint8_t > permuted(
+   const std::vector< uint8_t >& card_ids,
+   const std::array< uint8_t, n_suits >& suit_permutation,
+   const HandIndexer& indexer,
+   std::mt19937_64& rng
+)
+{
+   std::vector< uint8_t > out;
+   for(auto id : card_ids) {
+      out.emplace_back(uint8_t(id / n_suits * n_suits + suit_permutation[id % n_suits]));
+   }
+   for(size_t r = 0; r < indexer.n_rounds() and indexer.cards_until(r) <= out.size(); r++) {
+      auto begin = out.begin() + long(indexer.cards_until(r) - indexer.cards_per_round()[r]);
+      std::shuffle(begin, out.begin() + long(indexer.cards_until(r)), rng);
+   }
+   return out;
+}
+
+}  // namespace
+
+TEST(HandIndexer, holdem_round_sizes)
+{
+   const auto& indexer = HandIndexer::holdem();
+   ASSERT_EQ(indexer.n_rounds(), 4);
+   EXPECT_EQ(indexer.round_size(0), 169);
+   EXPECT_EQ(indexer.round_size(1), 1'286'792);
+   EXPECT_EQ(indexer.round_size(2), 55'190'538);
+   EXPECT_EQ(indexer.round_size(3), 2'428'287'420);
+}
+
+TEST(HandIndexer, preflop_classes)
+{
+   const auto& indexer = HandIndexer::holdem();
+   std::set< HandIndexer::index_type > indices;
+   for(uint8_t c1 = 0; c1 < n_cards; c1++) {
+      for(uint8_t c2 = 0; c2 < n_cards; c2++) {
+         if(c1 == c2) {
+            continue;
+         }
+         std::vector< uint8_t > hand{c1, c2};
+         auto index = indexer.index(hand);
+         ASSERT_LT(index, 169);
+         indices.emplace(index);
+      }
+   }
+   EXPECT_EQ(indices.size(), 169);
+
+   // pocket aces of any suits are the same hand, suited and offsuit aces-kings are not
+   std::vector< Card > aces1{{Rank::ace, Suit::spades}, {Rank::ace, Suit::hearts}};
+   std::vector< Card > aces2{{Rank::ace, Suit::clubs}, {Rank::ace, Suit::diamonds}};
+   std::vector< Card > ak_suited{{Rank::ace, Suit::clubs}, {Rank::king, Suit::clubs}};
+   std::vector< Card > ak_offsuit{{Rank::ace, Suit::clubs}, {Rank::king, Suit::hearts}};
+   EXPECT_EQ(indexer.index(aces1), indexer.index(aces2));
+   EXPECT_NE(indexer.index(ak_suited), indexer.index(ak_offsuit));
+}
+
+TEST(HandIndexer, flop_unindex_roundtrip)
+{
+   const auto& indexer = HandIndexer::holdem();
+   for(HandIndexer::index_type index = 0; index < indexer.round_size(1); index++) {
+      auto hand = indexer.unindex(1, index);
+      ASSERT_EQ(hand.size(), 5);
+      ASSERT_EQ(indexer.index(hand), index);
+   }
+}
+
+TEST(HandIndexer, isomorphic_hands_share_the_index)
+{
+   const auto& indexer = HandIndexer::holdem();
+   std::mt19937_64 rng{42};
+   std::vector< uint8_t > deck(n_cards);
+   std::iota(deck.begin(), deck.end(), 0);
+   std::array< uint8_t, n_suits > suit_permutation{0, 1, 2, 3};
+   for(size_t round = 0; round < indexer.n_rounds(); round++) {
+      for(size_t i = 0; i < 2000; i++) {
+         std::shuffle(deck.begin(), deck.end(), rng);
+         std::vector< uint8_t > hand(deck.begin(), deck.begin() + long(indexer.cards_until(round)));
+         auto index = indexer.index(hand);
+         ASSERT_LT(index, indexer.round_size(round));
+         std::shuffle(suit_permutation.begin(), suit_permutation.end(), rng);
+         ASSERT_EQ(indexer.index(permuted(hand, suit_permutation, indexer, rng)), index);
+         ASSERT_EQ(indexer.index(indexer.unindex(round, index)), index);
+      }
+   }
+}
+
+TEST(HandIndexer, rounds_are_not_interchangeable)
+{
+   const auto& indexer = HandIndexer::holdem();
+   std::vector< Card > hand1{
+      {Rank::ace, Suit::spades},
+      {Rank::two, Suit::hearts},
+      {Rank::king, Suit::clubs},
+      {Rank::queen, Suit::clubs},
+      {Rank::jack, Suit::clubs}};
+   std::vector< Card > hand2{
+      {Rank::king, Suit::clubs},
+      {Rank::two, Suit::hearts},
+      {Rank::ace, Suit::spades},
+      {Rank::queen, Suit::clubs},
+      {Rank::jack, Suit::clubs}};
+   EXPECT_NE(indexer.index(hand1), indexer.index(hand2));
+}
+
+TEST(HandIndexer, leduc_geometry)
+{
+   // one private card and one public card out of 3 ranks in 2 suits
+   HandIndexer indexer{{1, 1}, 3, 2};
+   EXPECT_EQ(indexer.round_size(0), 3);
+   // the public card either shares the suit of the private card (2 ranks left) or not (3 ranks)
+   EXPECT_EQ(indexer.round_size(1), 15);
+}
+
+TEST(HandIndexer, invalid_hands_throw)
+{
+   const auto& indexer = HandIndexer::holdem();
+   using ids = std::vector< uint8_t >;
+   EXPECT_THROW(std::ignore = indexer.index(ids{1, 2, 3}), std::invalid_argument);
+   EXPECT_THROW(std::ignore = indexer.index(ids{7, 7}), std::invalid_argument);
+   EXPECT_THROW(std::ignore = indexer.index(ids{7, 52}), std::invalid_argument);
+   EXPECT_THROW(std::ignore = indexer.unindex(0, 169), std::invalid_argument);
+   EXPECT_THROW(HandIndexer({2, 60}), std::invalid_argument);
+}
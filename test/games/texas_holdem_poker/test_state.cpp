@@ -0,0 +1,323 @@
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+
+#include "fixtures.hpp"
+#include "texas_holdem_poker/texas_holdem_poker.hpp"
+
+using namespace texholdem;
+
+TEST(HandRank, categories)
+{
+   auto rank = [](std::vector< Card > cards) { return rank_hand(cards); };
+   EXPECT_EQ(
+      category(rank(
+         {{Rank::ace, Suit::spades},
+          {Rank::two, Suit::spades},
+          {Rank::three, Suit::spades},
+          {Rank::four, Suit::spades},
+          {Rank::five, Suit::spades},
+          {Rank::king, Suit::hearts},
+          {Rank::king, Suit::clubs}}
+      )),
+      HandCategory::straight_flush
+   );
+   EXPECT_EQ(
+      category(rank(
+         {{Rank::ace, Suit::spades},
+          {Rank::ace, Suit::hearts},
+          {Rank::ace, Suit::clubs},
+          {Rank::king, Suit::spades},
+          {Rank::king, Suit::diamonds},
+          {Rank::king, Suit::hearts},
+          {Rank::two, Suit::clubs}}
+      )),
+      HandCategory::full_house
+   );
+   EXPECT_EQ(
+      category(rank(
+         {{Rank::ten, Suit::spades},
+          {Rank::jack, Suit::hearts},
+          {Rank::queen, Suit::clubs},
+          {Rank::king, Suit::spades},
+          {Rank::ace, Suit::diamonds},
+          {Rank::two, Suit::hearts},
+          {Rank::two, Suit::clubs}}
+      )),
+      HandCategory::straight
+   );
+   // the wheel is the lowest straight
+   auto wheel = rank(
+      {{Rank::ace, Suit::spades},
+       {Rank::two, Suit::hearts},
+       {Rank::three, Suit::clubs},
+       {Rank::four, Suit::spades},
+       {Rank::five, Suit::diamonds}}
+   );
+   auto six_high = rank(
+      {{Rank::six, Suit::spades},
+       {Rank::two, Suit::hearts},
+       {Rank::three, Suit::clubs},
+       {Rank::four, Suit::spades},
+       {Rank::five, Suit::diamonds}}
+   );
+   EXPECT_EQ(category(wheel), HandCategory::straight);
+   EXPECT_LT(wheel, six_high);
+   // the kicker decides between equal pairs
+   auto pair_king_kicker = rank(
+      {{Rank::ace, Suit::spades},
+       {Rank::ace, Suit::hearts},
+       {Rank::king, Suit::clubs},
+       {Rank::four, Suit::spades},
+       {Rank::five, Suit::diamonds}}
+   );
+   auto pair_queen_kicker = rank(
+      {{Rank::ace, Suit::clubs},
+       {Rank::ace, Suit::diamonds},
+       {Rank::queen, Suit::clubs},
+       {Rank::four, Suit::hearts},
+       {Rank::five, Suit::clubs}}
+   );
+   EXPECT_EQ(category(pair_king_kicker), HandCategory::pair);
+   EXPECT_GT(pair_king_kicker, pair_queen_kicker);
+}
+
+TEST_F(LimitHoldemState, order_of_play_heads_up)
+{
+   // the button (player one) posts the small blind
+   EXPECT_EQ(state.stake(Player::one), 1.);
+   EXPECT_EQ(state.stake(Player::two), 2.);
+   EXPECT_EQ(state.active_player(), Player::chance);
+   deal(
+      state,
+      {{Rank::ace, Suit::spades},
+       {Rank::ace, Suit::hearts},
+       {Rank::king, Suit::spades},
+       {Rank::queen, Suit::hearts}}
+   );
+   // the button acts first preflop
+   EXPECT_EQ(state.active_player(), Player::one);
+   EXPECT_EQ(
+      state.actions(),
+      (std::vector< Action >{{ActionType::fold}, {ActionType::call}, {ActionType::raise, 2.f}})
+   );
+   state.apply_action(ActionType::call);
+   // the big blind has the option to raise
+   EXPECT_EQ(state.active_player(), Player::two);
+   EXPECT_TRUE(state.is_valid(ActionType::check));
+   EXPECT_FALSE(state.is_valid(ActionType::call));
+   state.apply_action(ActionType::check);
+   EXPECT_EQ(state.active_player(), Player::chance);
+   EXPECT_EQ(state.round_nr(), 1);
+   deal(
+      state, {{Rank::two, Suit::clubs}, {Rank::seven, Suit::diamonds}, {Rank::nine, Suit::clubs}}
+   );
+   // the big blind acts first after the flop
+   EXPECT_EQ(state.active_player(), Player::two);
+   EXPECT_EQ(state.board().size(), 3);
+   EXPECT_EQ(
+      state.actions(), (std::vector< Action >{{ActionType::check}, {ActionType::bet, 2.f}})
+   );
+}
+
+TEST_F(LimitHoldemState, raise_cap)
+{
+   deal(
+      state,
+      {{Rank::ace, Suit::spades},
+       {Rank::ace, Suit::hearts},
+       {Rank::king, Suit::spades},
+       {Rank::queen, Suit::hearts}}
+   );
+   for(size_t i = 0; i < 3; i++) {
+      EXPECT_TRUE(state.is_valid(ActionType::raise, 2.f));
+      state.apply_action(ActionType::raise, 2.f);
+   }
+   // the big blind and three raises cap the preflop betting
+   EXPECT_FALSE(state.is_valid(ActionType::raise, 2.f));
+   EXPECT_EQ(state.actions(), (std::vector< Action >{{ActionType::fold}, {ActionType::call}}));
+   EXPECT_EQ(state.highest_stake(), 8.);
+}
+
+TEST_F(LimitHoldemState, fold_payoff)
+{
+   deal(
+      state,
+      {{Rank::ace, Suit::spades},
+       {Rank::ace, Suit::hearts},
+       {Rank::king, Suit::spades},
+       {Rank::queen, Suit::hearts}}
+   );
+   state.apply_action(ActionType::raise, 2.f);
+   state.apply_action(ActionType::fold);
+   EXPECT_TRUE(state.is_terminal());
+   EXPECT_EQ(state.payoff(), (std::vector< double >{2., -2.}));
+}
+
+TEST_F(LimitHoldemState, showdown_payoff)
+{
+   deal(
+      state,
+      {{Rank::ace, Suit::spades},
+       {Rank::ace, Suit::hearts},
+       {Rank::king, Suit::spades},
+       {Rank::queen, Suit::hearts}}
+   );
+   state.apply_action(ActionType::call);
+   state.apply_action(ActionType::check);
+   deal(
+      state, {{Rank::two, Suit::clubs}, {Rank::seven, Suit::diamonds}, {Rank::nine, Suit::clubs}}
+   );
+   for(auto board_card : {Card{Rank::king, Suit::clubs}, Card{Rank::three, Suit::hearts}}) {
+      state.apply_action(ActionType::check);
+      state.apply_action(ActionType::check);
+      state.apply_action(board_card);
+   }
+   // the turn and river bets are twice the big blind
+   EXPECT_TRUE(state.is_valid(ActionType::bet, 4.f));
+   state.apply_action(ActionType::bet, 4.f);
+   state.apply_action(ActionType::call);
+   EXPECT_TRUE(state.is_terminal());
+   EXPECT_EQ(state.payoff(), (std::vector< double >{6., -6.}));
+}
+
+TEST_F(NoLimitHoldemState, raise_sizes)
+{
+   deal(
+      state,
+      {{Rank::ace, Suit::spades},
+       {Rank::ace, Suit::hearts},
+       {Rank::king, Suit::spades},
+       {Rank::queen, Suit::hearts}}
+   );
+   // min raise, pot raise and all-in
+   EXPECT_EQ(
+      state.actions(),
+      (std::vector< Action >{
+         {ActionType::fold},
+         {ActionType::call},
+         {ActionType::raise, 2.f},
+         {ActionType::raise, 4.f},
+         {ActionType::raise, 198.f}})
+   );
+   EXPECT_TRUE(state.is_valid(ActionType::raise, 7.5f));
+   EXPECT_FALSE(state.is_valid(ActionType::raise, 1.f));
+   EXPECT_FALSE(state.is_valid(ActionType::raise, 199.f));
+   state.apply_action(ActionType::raise, 6.f);
+   // a re-raise has to be at least as large as the last raise
+   EXPECT_FALSE(state.is_valid(ActionType::raise, 4.f));
+   EXPECT_TRUE(state.is_valid(ActionType::raise, 6.f));
+   state.apply_action(ActionType::raise, 192.f);
+   EXPECT_TRUE(state.is_all_in(Player::two));
+   EXPECT_EQ(state.actions(), (std::vector< Action >{{ActionType::fold}, {ActionType::call}}));
+   state.apply_action(ActionType::call);
+   // nobody can bet anymore --> the board is run out without betting rounds
+   EXPECT_EQ(state.active_player(), Player::chance);
+   deal(
+      state,
+      {{Rank::two, Suit::clubs},
+       {Rank::seven, Suit::diamonds},
+       {Rank::nine, Suit::clubs},
+       {Rank::three, Suit::diamonds},
+       {Rank::four, Suit::diamonds}}
+   );
+   EXPECT_TRUE(state.is_terminal());
+   EXPECT_EQ(state.payoff(), (std::vector< double >{200., -200.}));
+}
+
+TEST(HoldemState, side_pots)
+{
+   auto config = PokerConfig::no_limit(3);
+   config.stacks = {50.f, 100.f, 200.f};
+   State state{config};
+   // the dealer is player one, so player two is the small and player three the big blind
+   EXPECT_EQ(state.stake(Player::two), 1.);
+   EXPECT_EQ(state.stake(Player::three), 2.);
+   deal(
+      state,
+      {{Rank::ace, Suit::spades},
+       {Rank::ace, Suit::hearts},
+       {Rank::king, Suit::spades},
+       {Rank::king, Suit::hearts},
+       {Rank::queen, Suit::spades},
+       {Rank::queen, Suit::hearts}}
+   );
+   EXPECT_EQ(state.active_player(), Player::one);
+   state.apply_action(ActionType::raise, 48.f);
+   state.apply_action(ActionType::raise, 50.f);
+   state.apply_action(ActionType::call);
+   deal(
+      state,
+      {{Rank::two, Suit::clubs},
+       {Rank::seven, Suit::diamonds},
+       {Rank::nine, Suit::clubs},
+       {Rank::three, Suit::diamonds},
+       {Rank::four, Suit::clubs}}
+   );
+   EXPECT_TRUE(state.is_terminal());
+   // the aces win the main pot of 3 * 50, the kings the side pot of 2 * 50 between the other two
+   EXPECT_EQ(state.payoff(), (std::vector< double >{100., 0., -100.}));
+}
+
+TEST(HoldemState, short_all_in_raise_does_not_reopen_the_betting)
+{
+   auto config = PokerConfig::no_limit(3);
+   config.stacks = {100.f, 100.f, 7.f};
+   State state{config};
+   deal(
+      state,
+      {{Rank::ace, Suit::spades},
+       {Rank::ace, Suit::hearts},
+       {Rank::king, Suit::spades},
+       {Rank::king, Suit::hearts},
+       {Rank::queen, Suit::spades},
+       {Rank::queen, Suit::hearts}}
+   );
+   state.apply_action(ActionType::raise, 4.f);
+   state.apply_action(ActionType::call);
+   // the big blind has only 1 chip left after calling, an all-in short of the full raise of 4
+   EXPECT_EQ(state.active_player(), Player::three);
+   state.apply_action(ActionType::raise, 1.f);
+   EXPECT_TRUE(state.is_all_in(Player::three));
+   // both players already acted on the last full raise, so they may only call or fold
+   EXPECT_EQ(state.active_player(), Player::one);
+   EXPECT_EQ(state.actions(), (std::vector< Action >{{ActionType::fold}, {ActionType::call}}));
+   EXPECT_FALSE(state.is_valid(ActionType::raise, 4.f));
+   state.apply_action(ActionType::call);
+   EXPECT_EQ(state.actions(), (std::vector< Action >{{ActionType::fold}, {ActionType::call}}));
+   state.apply_action(ActionType::call);
+   // the next betting round is open to raises again
+   EXPECT_EQ(state.active_player(), Player::chance);
+}
+
+TEST(HoldemState, random_playouts_are_zero_sum)
+{
+   std::mt19937_64 rng{0};
+   for(auto config :
+       {PokerConfig::limit(2),
+        PokerConfig::limit(6),
+        PokerConfig::no_limit(2),
+        PokerConfig::no_limit(4, 20.f)}) {
+      for(size_t game = 0; game < 500; game++) {
+         State state{config};
+         while(not state.is_terminal()) {
+            if(state.active_player() == Player::chance) {
+               auto outcomes = state.chance_actions();
+               ASSERT_FALSE(outcomes.empty());
+               state.apply_action(outcomes[rng() % outcomes.size()]);
+            } else {
+               auto actions = state.actions();
+               ASSERT_FALSE(actions.empty());
+               for(const auto& action : actions) {
+                  ASSERT_TRUE(state.is_valid(action));
+               }
+               state.apply_action(actions[rng() % actions.size()]);
+            }
+         }
+         auto payoffs = state.payoff();
+         EXPECT_NEAR(std::accumulate(payoffs.begin(), payoffs.end(), 0.), 0., 1e-6);
+      }
+   }
+}
@@ -0,0 +1,133 @@
+
+#include <gtest/gtest.h>
+
+#include "nor/env.hpp"
+#include "nor/fosg_batch.hpp"
+
+using namespace nor;
+
+/// the kuhn env with a native batch of legal actions that counts its calls
+struct KuhnActionsBatchEnv: public games::kuhn::Environment {
+   mutable size_t n_batch_calls = 0;
+
+   std::vector< std::vector< action_type > > actions_batch(
+      std::span< const Player >,
+      std::span< const world_state_type > worldstates
+   ) const
+   {
+      n_batch_calls++;
+      std::vector< std::vector< action_type > > actions;
+      for(const auto& wstate : worldstates) {
+         actions.emplace_back(wstate.actions());
+      }
+      return actions;
+   }
+};
+
+static_assert(concepts::fosg< KuhnActionsBatchEnv >);
+static_assert(concepts::has::method::actions_batch< KuhnActionsBatchEnv >);
+static_assert(not concepts::has::method::actions_batch< games::kuhn::Environment >);
+static_assert(not concepts::batched_fosg< KuhnActionsBatchEnv >);
+
+namespace {
+
+auto dealt_states(const games::kuhn::Environment& env, size_t n_states)
+{
+   std::vector< games::kuhn::State > states;
+   for(size_t i = 0; i < n_states; i++) {
+      auto& state = states.emplace_back();
+      auto outcomes = env.chance_actions(state);
+      env.transition(state, outcomes[i % outcomes.size()]);
+      outcomes = env.chance_actions(state);
+      env.transition(state, outcomes[i % outcomes.size()]);
+   }
+   return states;
+}
+
+}  // namespace
+
+TEST(BatchedFOSG, fallback_matches_the_scalar_calls)
+{
+   auto env = games::kuhn::Environment{};
+   auto states = dealt_states(env, 6);
+   std::vector< Player > players(states.size(), Player::alex);
+   auto actions = actions_batch(
+      env, std::span< const Player >{players}, std::span< const games::kuhn::State >{states}
+   );
+   ASSERT_EQ(actions.size(), states.size());
+   for(size_t i = 0; i < states.size(); i++) {
+      EXPECT_EQ(actions[i], env.actions(Player::alex, states[i]));
+   }
+
+   std::vector< games::kuhn::Action > chosen(states.size(), games::kuhn::Action::bet);
+   auto next_states = states;
+   transition_batch(env, std::span< games::kuhn::State >{next_states}, chosen);
+   auto observations = observations_batch(
+      env,
+      std::span< const Player >{players},
+      std::span< const games::kuhn::State >{states},
+      chosen,
+      std::span< const games::kuhn::State >{next_states}
+   );
+   for(size_t i = 0; i < states.size(); i++) {
+      auto next_state = states[i];
+      env.transition(next_state, chosen[i]);
+      EXPECT_EQ(env.active_player(next_states[i]), env.active_player(next_state));
+      EXPECT_EQ(
+         observations[i].first, env.public_observation(states[i], chosen[i], next_state)
+      );
+      EXPECT_EQ(
+         observations[i].second,
+         env.private_observation(Player::alex, states[i], chosen[i], next_state)
+      );
+   }
+
+   chosen.pop_back();
+   EXPECT_THROW(
+      transition_batch(env, std::span< games::kuhn::State >{next_states}, chosen),
+      std::invalid_argument
+   );
+}
+
+TEST(BatchedFOSG, sampled_trajectories_replay_to_the_same_terminals)
+{
+   auto env = games::kuhn::Environment{};
+   std::vector< games::kuhn::State > states(50);
+   common::RNG rng{0};
+   auto trajectories = sample_trajectories_batch(
+      env,
+      std::span< games::kuhn::State >{states},
+      [&](const auto&, Player, const auto& legal_actions) {
+         return common::choose(legal_actions, rng);
+      },
+      rng
+   );
+   ASSERT_EQ(trajectories.size(), states.size());
+   for(size_t i = 0; i < states.size(); i++) {
+      ASSERT_TRUE(env.is_terminal(states[i]));
+      games::kuhn::State replay{};
+      for(const auto& action_or_outcome : trajectories[i]) {
+         std::visit([&](const auto& elem) { env.transition(replay, elem); }, action_or_outcome);
+      }
+      ASSERT_TRUE(env.is_terminal(replay));
+      EXPECT_EQ(env.reward(Player::alex, replay), env.reward(Player::alex, states[i]));
+   }
+}
+
+TEST(BatchedFOSG, native_batch_methods_take_precedence)
+{
+   auto env = KuhnActionsBatchEnv{};
+   std::vector< games::kuhn::State > states(8);
+   common::RNG rng{0};
+   auto trajectories = sample_trajectories_batch(
+      env,
+      std::span< games::kuhn::State >{states},
+      [](const auto&, Player, const auto& legal_actions) { return legal_actions.front(); },
+      rng
+   );
+   // every kuhn game of checks ends after two moves, each taken by one batched call
+   EXPECT_EQ(env.n_batch_calls, 2);
+   for(const auto& trajectory : trajectories) {
+      EXPECT_EQ(trajectory.size(), 4);
+   }
+}
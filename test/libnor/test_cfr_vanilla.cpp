@@ -30,3 +30,50 @@ TEST(RockPaperScissors, CFR_VANILLA_simultaneous)
 {
    run_cfr_on_rps< rm::CFRDiscountedConfig{.update_mode = rm::UpdateMode::simultaneous} >();
 }
+
+TEST(KuhnPoker, CFR_VANILLA_solver_stats)
+{
+   games::kuhn::Environment env{};
+   auto solver = factory::make_cfr_vanilla< rm::CFRConfig{}, true >(
+      std::move(env),
+      std::make_unique< games::kuhn::State >(),
+      factory::make_tabular_policy(
+         std::unordered_map< games::kuhn::Infostate, HashmapActionPolicy< games::kuhn::Action > >{}
+      ),
+      factory::make_tabular_policy(
+         std::unordered_map< games::kuhn::Infostate, HashmapActionPolicy< games::kuhn::Action > >{}
+      )
+   );
+   solver.iterate(2);
+   const auto& counters = solver.stats().counters();
+   if constexpr(rm::solver_instrumentation_enabled) {
+      // kuhn poker has 12 infostates over both players and 30 terminal histories
+      EXPECT_EQ(counters.infostates_created, 12);
+      EXPECT_EQ(counters.terminals_evaluated % 30, 0);
+      EXPECT_GT(counters.nodes_visited, counters.terminals_evaluated);
+      EXPECT_FALSE(solver.stats().trace().empty());
+   } else {
+      EXPECT_EQ(counters.nodes_visited, 0);
+      EXPECT_TRUE(solver.stats().trace().empty());
+   }
+   EXPECT_EQ(solver.stats().chrome_trace().front(), '{');
+   solver.reset_stats();
+   EXPECT_EQ(solver.stats().counters().nodes_visited, 0);
+}
+
+TEST(SolverStats, trace_keeps_only_the_latest_events)
+{
+   rm::SolverStats stats;
+   stats.set_trace_capacity(3);
+   for(size_t iteration = 0; iteration < 5; iteration++) {
+      [[maybe_unused]] auto timer = stats.time(rm::SolverPhase::traversal, iteration);
+   }
+   auto trace = stats.trace();
+   if constexpr(rm::solver_instrumentation_enabled) {
+      ASSERT_EQ(trace.size(), 3);
+      EXPECT_EQ(trace.front().iteration, 2);
+      EXPECT_EQ(trace.back().iteration, 4);
+   } else {
+      EXPECT_TRUE(trace.empty());
+   }
+}
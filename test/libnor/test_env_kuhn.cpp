@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "nor/env.hpp"
+
+using namespace nor::games::kuhn;
+
+namespace {
+
+/// visits every world state of the game together with the infostates of all players
+template < typename Visitor >
+void traverse(
+   const GeneralEnvironment& env,
+   const general::State& state,
+   const std::vector< GeneralInfostate >& infostates,
+   Visitor&& visitor
+)
+{
+   visitor(state, infostates);
+   if(state.is_terminal()) {
+      return;
+   }
+   auto visit_child = [&](const auto& action) {
+      auto child = state;
+      env.transition(child, action);
+      auto child_infostates = infostates;
+      for(auto& infostate : child_infostates) {
+         infostate.update(
+            env.public_observation(state, action, child),
+            env.private_observation(infostate.player(), state, action, child)
+         );
+      }
+      traverse(env, child, child_infostates, visitor);
+   };
+   if(state.active_player() == Player::chance) {
+      for(auto outcome : state.chance_actions()) {
+         visit_child(outcome);
+      }
+   } else {
+      for(auto action : state.actions()) {
+         visit_child(action);
+      }
+   }
+}
+
+}  // namespace
+
+TEST(GeneralKuhnEnv, infostate_index_is_the_closed_form_index)
+{
+   GeneralEnvironment env{};
+   general::Config config{.n_players = 3, .n_cards = 4};
+   std::vector< GeneralInfostate > root_infostates;
+   for(size_t p = 0; p < config.n_players; p++) {
+      root_infostates.emplace_back(nor::Player(p));
+   }
+   std::set< std::pair< nor::Player, size_t > > indices;
+   // the hash of every observation history of a player
+   std::map< std::pair< nor::Player, std::vector< std::pair< uint32_t, uint32_t > > >, size_t >
+      hash_of_history;
+   auto visitor = [&](const general::State& state, const auto& infostates) {
+      for(const auto& infostate : infostates) {
+         auto history = std::pair{infostate.player(), infostate.history()};
+         auto entry = hash_of_history.emplace(std::move(history), infostate.hash()).first;
+         EXPECT_EQ(entry->second, infostate.hash());
+      }
+      if(state.is_terminal() or state.active_player() == Player::chance) {
+         return;
+      }
+      const auto& infostate = infostates[static_cast< size_t >(state.active_player())];
+      EXPECT_EQ(infostate.index(), state.infostate_index());
+      EXPECT_EQ(infostate.card(), state.card(state.active_player()));
+      indices.emplace(infostate.player(), infostate.index());
+   };
+   traverse(env, general::State{config}, root_infostates, visitor);
+   EXPECT_EQ(indices.size(), config.n_infostates());
+   // different observation histories never share a hash (and thus a key) in this game
+   std::set< std::pair< nor::Player, size_t > > hashes;
+   for(const auto& [history, hash] : hash_of_history) {
+      hashes.emplace(history.first, hash);
+   }
+   EXPECT_EQ(hashes.size(), hash_of_history.size());
+}
+
+TEST(GeneralKuhnEnv, infostates_compare_by_card_and_betting_sequence)
+{
+   GeneralEnvironment env{};
+   general::State state{{.n_players = 3, .n_cards = 4}};
+   GeneralInfostate alex{nor::Player::alex};
+   GeneralInfostate bob{nor::Player::bob};
+   auto step = [&](const auto& action) {
+      auto next_state = state;
+      env.transition(next_state, action);
+      for(auto* infostate : {&alex, &bob}) {
+         infostate->update(
+            env.public_observation(state, action, next_state),
+            env.private_observation(infostate->player(), state, action, next_state)
+         );
+      }
+      state = next_state;
+   };
+   for(size_t p = 0; p < 3; p++) {
+      step(general::ChanceOutcome{Player(p), general::Card(p)});
+   }
+   EXPECT_EQ(alex.card(), general::Card(0));
+   EXPECT_EQ(bob.card(), general::Card(1));
+   EXPECT_EQ(
+      env.private_observation(nor::Player::bob, state, Action::bet, state),
+      GeneralInfostate::nothing
+   );
+
+   auto alex_at_root = alex;
+   step(Action::check);
+   EXPECT_NE(alex, alex_at_root);
+   auto alex_after_check = alex;
+   step(Action::bet);
+   step(Action::bet);
+   EXPECT_EQ(alex.index(), state.infostate_index());
+   EXPECT_NE(alex, alex_after_check);
+   EXPECT_EQ(alex, GeneralInfostate{alex});
+   EXPECT_EQ(std::hash< GeneralInfostate >{}(alex), alex.hash());
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "../games/stratego/fixtures.hpp"
+#include "nor/env.hpp"
+
+using namespace nor::games::stratego;
+
+namespace {
+
+uint8_t packed(Team team, uint8_t token_slot, bool revealed = false)
+{
+   return static_cast< uint8_t >((1 + token_slot) | uint8_t(team) << 4 | uint8_t(revealed) << 5);
+}
+uint8_t packed(Team team, Token token, bool revealed = false)
+{
+   return packed(team, static_cast< uint8_t >(token), revealed);
+}
+
+}  // namespace
+
+TEST_F(StrategoState5x5, board_observation_hides_opponent_tokens)
+{
+   auto blue_obs = observation(state, nor::Player::alex);
+   auto red_obs = observation(state, nor::Player::bob);
+   auto public_obs = observation(state);
+   ASSERT_EQ(blue_obs.kind, Observation::Kind::board);
+   ASSERT_EQ(blue_obs.board.size(), 25);
+   EXPECT_NE(blue_obs, red_obs);
+   EXPECT_NE(blue_obs, public_obs);
+
+   auto square = [](int row, int col) { return size_t(row) * 5 + size_t(col); };
+   auto unknown = [](Team team) { return packed(team, Observation::unknown_token); };
+   EXPECT_EQ(blue_obs.board[square(2, 2)], Observation::hole);
+   EXPECT_EQ(blue_obs.board[square(2, 0)], Observation::empty);
+   // the blue marshall is known to blue only
+   EXPECT_EQ(blue_obs.board[square(1, 1)], packed(Team::BLUE, Token::marshall));
+   EXPECT_EQ(red_obs.board[square(1, 1)], unknown(Team::BLUE));
+   EXPECT_EQ(public_obs.board[square(1, 1)], unknown(Team::BLUE));
+   EXPECT_EQ(blue_obs.board[square(3, 4)], unknown(Team::RED));
+   EXPECT_EQ(public_obs.board[square(3, 4)], unknown(Team::RED));
+
+   // equal observations hash equally
+   EXPECT_EQ(observation(state, nor::Player::alex), blue_obs);
+   EXPECT_EQ(std::hash< Observation >{}(observation(state, nor::Player::alex)), blue_obs.hash());
+}
+
+TEST_F(StrategoState5x5, move_observations_reveal_fighting_pieces)
+{
+   Environment env{};
+   auto observe = [&](const Action& action) {
+      auto next_state = state;
+      env.transition(next_state, action);
+      auto obs = env.public_observation(state, action, next_state);
+      EXPECT_EQ(
+         env.private_observation(nor::Player::alex, state, action, next_state).kind,
+         state.turn_count() == 0 ? Observation::Kind::board : Observation::Kind::none
+      );
+      state = std::move(next_state);
+      return obs;
+   };
+
+   auto first = observe(Action{Team::BLUE, {{1, 1}, {2, 1}}});
+   EXPECT_EQ(first.kind, Observation::Kind::move);
+   EXPECT_EQ(first.from, 6);
+   EXPECT_EQ(first.to, 11);
+   EXPECT_EQ(first.revealed, (std::array< uint8_t, 2 >{0, 0}));
+   EXPECT_TRUE(first.board.empty());
+
+   auto second = observe(Action{Team::RED, {{3, 0}, {2, 0}}});
+   EXPECT_NE(second, first);
+   EXPECT_NE(second.hash(), first.hash());
+
+   // the blue marshall takes the red scout and both are revealed by the fight
+   auto fight = observe(Action{Team::BLUE, {{2, 1}, {2, 0}}});
+   EXPECT_EQ(fight.from, 11);
+   EXPECT_EQ(fight.to, 10);
+   EXPECT_EQ(fight.revealed[0], packed(Team::BLUE, Token::marshall, true));
+   EXPECT_EQ(fight.revealed[1], packed(Team::RED, Token::scout, true));
+
+   // the revealed marshall is known to everyone now
+   EXPECT_EQ(observation(state).board[10], fight.revealed[0]);
+}
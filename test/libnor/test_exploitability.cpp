@@ -37,6 +37,24 @@ TEST_P(Exploitability_KuhnPoker_ParamsF, basic_policies_exploitability)
    EXPECT_NEAR(expl, expected_expl, 1e-8);
 }
 
+TEST_P(Exploitability_KuhnPoker_ParamsF, basic_policies_exploitability_parallel_chance)
+{
+   using namespace nor::games::kuhn;
+   auto [_, policies, expected_expl] = GetParam();
+   auto alex_policy = nor::factory::make_tabular_policy(std::move(policies.at(nor::Player::alex)));
+   auto bob_policy = nor::factory::make_tabular_policy(std::move(policies.at(nor::Player::bob)));
+   double expl = nor::exploitability(
+      Environment{},
+      State{},
+      nor::player_hashmap< decltype(alex_policy) >{
+         std::pair{nor::Player::alex, std::move(alex_policy)},
+         std::pair{nor::Player::bob, std::move(bob_policy)}},
+      /*constant_sum=*/false,
+      /*parallelize_chance=*/true
+   );
+   EXPECT_NEAR(expl, expected_expl, 1e-8);
+}
+
 INSTANTIATE_TEST_SUITE_P(
    all,
    Exploitability_KuhnPoker_ParamsF,
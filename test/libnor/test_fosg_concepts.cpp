@@ -121,6 +121,12 @@ TEST(concrete, fosg_kuhn)
    EXPECT_FALSE((nor::concepts::deterministic_fosg< nor::games::kuhn::Environment >) );
 }
 
+TEST(concrete, fosg_kuhn_general)
+{
+   EXPECT_TRUE((nor::concepts::fosg< nor::games::kuhn::GeneralEnvironment >) );
+   EXPECT_FALSE((nor::concepts::deterministic_fosg< nor::games::kuhn::GeneralEnvironment >) );
+}
+
 TEST(concrete, fosg_stratego)
 {
    concept_fosg_check< nor::games::stratego::Environment >();